@@ -344,6 +344,83 @@ void GPS_Math_DouglasPeucker(QVector<pointDP>& line, qreal d) {
   }
 }
 
+static qreal GPS_Math_DistPointSegment(const QPointF& p1, const QPointF& p2, const QPointF& pt) {
+  const QPointF d = p2 - p1;
+  const qreal l2 = sqrlen(d);
+  if (l2 == 0) {
+    // a closed loop has the same start and end point
+    return qSqrt(sqrlen(pt - p1));
+  }
+
+  const QPointF v = pt - p1;
+  const qreal u = qBound(0.0, (v.x() * d.x() + v.y() * d.y()) / l2, 1.0);
+  return qSqrt(sqrlen(p1 + u * d - pt));
+}
+
+void GPS_Math_SimplifyPolyline(const QPolygonF& line, qreal d, QPolygonF& simple) {
+  simple.clear();
+
+  const qint32 N = line.size();
+  if (N < 3) {
+    simple = line;
+    return;
+  }
+
+  // drop all points closer than d to the last point kept
+  const qreal d2 = d * d;
+  QPolygonF points;
+  points.reserve(N);
+
+  QPointF last = line.first();
+  points << last;
+  for (qint32 i = 1; i < N - 1; i++) {
+    const QPointF& pt = line[i];
+    if (sqrlen(pt - last) > d2) {
+      points << pt;
+      last = pt;
+    }
+  }
+  points << line.last();
+
+  // Douglas Peucker on the remaining points
+  QVector<bool> used(points.size(), true);
+  QStack<segment> stack;
+  stack << segment(0, points.size() - 1);
+
+  while (!stack.isEmpty()) {
+    qint32 idx = NOIDX;
+    segment seg = stack.pop();
+
+    const QPointF& p1 = points[seg.idx1];
+    const QPointF& p2 = points[seg.idx2];
+
+    qreal dmax = d;
+    for (qint32 i = seg.idx1 + 1; i < seg.idx2; i++) {
+      qreal distance = GPS_Math_DistPointSegment(p1, p2, points[i]);
+      if (distance > dmax) {
+        idx = i;
+        dmax = distance;
+      }
+    }
+
+    if (idx > 0) {
+      stack << segment(seg.idx1, idx);
+      stack << segment(idx, seg.idx2);
+    } else {
+      for (qint32 i = seg.idx1 + 1; i < seg.idx2; i++) {
+        used[i] = false;
+      }
+    }
+  }
+
+  simple.reserve(points.size());
+  for (qint32 i = 0; i < points.size(); i++) {
+    if (used[i]) {
+      simple << points[i];
+    }
+  }
+}
+
 bool GPS_Math_LineCrossesRect(const QPointF& p1, const QPointF& p2, const QRectF& rect) {
   // the trivial case
   if (rect.contains(p1) || rect.contains(p2)) {
@@ -54,6 +54,18 @@ qreal GPS_Math_Distance(const qreal u1, const qreal v1, const qreal u2, const qr
 /// use for short distances, much quicker processing
 qreal GPS_Math_DistanceQuick(const qreal u1, const qreal v1, const qreal u2, const qreal v2);
 void GPS_Math_DouglasPeucker(QVector<pointDP>& line, qreal d);
+/**
+   @brief Simplify a planar polyline for display
+
+   A radial distance filter is followed by the Douglas Peucker algorithm
+   using the planar distance of a point to a segment. The first and last
+   point are always kept.
+
+   @param line      the polyline to simplify
+   @param d         the tolerance in the polyline's units
+   @param simple    the resulting polyline
+ */
+void GPS_Math_SimplifyPolyline(const QPolygonF& line, qreal d, QPolygonF& simple);
 QPointF GPS_Math_Wpt_Projection(const QPointF& pt1, qreal distance, qreal bearing);
 bool GPS_Math_LineCrossesRect(const QPointF& p1, const QPointF& p2, const QRectF& rect);
 qreal GPS_Math_DistPointPolyline(const QPolygonF& points, const QPointF& q);
@@ -19,21 +19,251 @@
 #include "gis/proj_x.h"
 
 #include <QDebug>
+#include <QMutex>
 #include <QPolygonF>
+#include <QThreadStorage>
+#include <QtMath>
+
+/// the radius of the sphere used by web mercator [m]
+#define MERC_RADIUS 6378137.0
+
+static inline qreal& strided(qreal* p, size_t stride, size_t i) { return *(qreal*)((char*)p + i * stride); }
+
+/// normalize the longitude to -pi..pi like PROJ does
+static inline qreal adjlon(qreal lon) {
+  if (qAbs(lon) <= M_PI) {
+    return lon;
+  }
+  return lon - 2 * M_PI * qFloor((lon + M_PI) / (2 * M_PI));
+}
+
+/// lat/long [rad] to spherical mercator [m]
+static void mercFwd(qreal* x, qreal* y, size_t stride, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    qreal& lon = strided(x, stride, i);
+    qreal& lat = strided(y, stride, i);
+    lon = MERC_RADIUS * adjlon(lon);
+    lat = MERC_RADIUS * qLn(qTan(M_PI / 4 + lat / 2));
+  }
+}
+
+/// spherical mercator [m] to lat/long [rad]
+static void mercInv(qreal* x, qreal* y, size_t stride, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    qreal& u = strided(x, stride, i);
+    qreal& v = strided(y, stride, i);
+    u = adjlon(u / MERC_RADIUS);
+    v = 2 * qAtan(qExp(v / MERC_RADIUS)) - M_PI / 2;
+  }
+}
+
+namespace {
+/**
+   The PROJ context of a thread and all transformation objects created
+   within. It's owned by the thread's QThreadStorage and destroyed when
+   the thread finishes.
+
+   Objects of a CProj destroyed by another thread are not destroyed right
+   away, as the context must never be used by two threads at once. They
+   are put on the orphans list to be destroyed by the owning thread.
+ */
+struct pjthread_t {
+  pjthread_t();
+  ~pjthread_t();
+
+  /// destroy all orphaned objects. Must be called by the owning thread.
+  void collect();
+
+  PJ_CONTEXT* ctx = nullptr;
+
+  /// guards pjs and orphans
+  QMutex mutex;
+  /// transformation objects by CProj::_id
+  QHash<qint32, PJ*> pjs;
+  QList<PJ*> orphans;
+};
+
+/// guards threads
+QMutex threadsMutex;
+/// all threads with a context
+QSet<pjthread_t*> threads;
+QThreadStorage<pjthread_t*> threadStorage;
+QAtomicInt nextId(1);
+
+pjthread_t::pjthread_t() {
+  ctx = proj_context_create();
+  if (nullptr == ctx) {
+    qWarning() << "Failed to create projection context for thread" << QThread::currentThreadId();
+  }
+
+  QMutexLocker lock(&threadsMutex);
+  threads << this;
+}
+
+pjthread_t::~pjthread_t() {
+  {
+    QMutexLocker lock(&threadsMutex);
+    threads.remove(this);
+  }
+
+  // no other thread can reach this object anymore
+  for (PJ* pj : qAsConst(pjs)) {
+    if (nullptr != pj) {
+      proj_destroy(pj);
+    }
+  }
+  for (PJ* pj : qAsConst(orphans)) {
+    proj_destroy(pj);
+  }
+
+  if (nullptr != ctx) {
+    proj_context_destroy(ctx);
+  }
+}
+
+void pjthread_t::collect() {
+  QList<PJ*> list;
+  {
+    QMutexLocker lock(&mutex);
+    list.swap(orphans);
+  }
+
+  for (PJ* pj : qAsConst(list)) {
+    proj_destroy(pj);
+  }
+}
+
+/// get the context of the calling thread, create it on first use
+pjthread_t* localThread() {
+  if (!threadStorage.hasLocalData()) {
+    threadStorage.setLocalData(new pjthread_t());
+  }
+  return threadStorage.localData();
+}
+}  // namespace
 
 CProj::CProj(const QString& crsSrc, const QString& crsTar) { init(crsSrc.toLatin1(), crsTar.toLatin1()); }
 
-CProj::~CProj() {
-  if (nullptr != _pj) {
-    proj_destroy(_pj);
+CProj::CProj(const CProj& other) { *this = other; }
+
+CProj::CProj(CProj&& other) { *this = std::move(other); }
+
+CProj::~CProj() { _destroy(); }
+
+CProj& CProj::operator=(const CProj& other) {
+  if (this == &other) {
+    return *this;
+  }
+
+  if (other._strProjSrc.isEmpty()) {
+    _destroy();
+    _isSrcLatLong = false;
+    _isTarLatLong = false;
+    _fastPath = eFastPathNone;
+    _strProjSrc.clear();
+    _strProjTar.clear();
+  } else {
+    init(other._strProjSrc.toLatin1(), other._strProjTar.toLatin1());
+  }
+
+  return *this;
+}
+
+CProj& CProj::operator=(CProj&& other) {
+  if (this == &other) {
+    return *this;
+  }
+
+  // take over the transformation objects of all threads
+  _destroy();
+  _id = other._id;
+  _pj = other._pj;
+  _isSrcLatLong = other._isSrcLatLong;
+  _isTarLatLong = other._isTarLatLong;
+  _fastPath = other._fastPath;
+  _strProjSrc = other._strProjSrc;
+  _strProjTar = other._strProjTar;
+
+  other._id = 0;
+  other._pj = nullptr;
+  other._isSrcLatLong = false;
+  other._isTarLatLong = false;
+  other._fastPath = eFastPathNone;
+  other._strProjSrc.clear();
+  other._strProjTar.clear();
+
+  return *this;
+}
+
+void CProj::_destroy() {
+  if (_id != 0) {
+    QMutexLocker lock(&threadsMutex);
+    for (pjthread_t* thread : qAsConst(threads)) {
+      QMutexLocker lockThread(&thread->mutex);
+      PJ* pj = thread->pjs.take(_id);
+      if (nullptr != pj) {
+        thread->orphans << pj;
+      }
+    }
   }
 
-  if (nullptr != _ctx) {
-    proj_context_destroy(_ctx);
+  // the calling thread can destroy it's own objects right away
+  if (threadStorage.hasLocalData()) {
+    threadStorage.localData()->collect();
   }
+
+  _id = 0;
+  _pj = nullptr;
+}
+
+PJ* CProj::_createPj(PJ_CONTEXT* ctx) const {
+  PJ* pj = proj_create_crs_to_crs(ctx, _strProjSrc.toLatin1(), _strProjTar.toLatin1(), NULL);
+  if (nullptr != pj) {
+    PJ* P_for_GIS = proj_normalize_for_visualization(ctx, pj);
+    proj_destroy(pj);
+    pj = P_for_GIS;
+  }
+  return pj;
+}
+
+PJ* CProj::_getPj() const {
+  pjthread_t* thread = localThread();
+  if ((nullptr == thread->ctx) || (_id == 0)) {
+    return nullptr;
+  }
+
+  bool found = false;
+  PJ* pj = nullptr;
+  bool hasOrphans = false;
+  {
+    QMutexLocker lock(&thread->mutex);
+    auto it = thread->pjs.constFind(_id);
+    if (it != thread->pjs.constEnd()) {
+      found = true;
+      pj = *it;
+    }
+    hasOrphans = !thread->orphans.isEmpty();
+  }
+
+  if (hasOrphans) {
+    thread->collect();
+  }
+
+  if (found) {
+    return pj;
+  }
+
+  // first use in this thread
+  pj = _createPj(thread->ctx);
+
+  QMutexLocker lock(&thread->mutex);
+  thread->pjs[_id] = pj;
+  return pj;
 }
 
 void CProj::init(const char* crsSrc, const char* crsTar) {
+  _destroy();
+
   _strProjSrc = crsSrc;
   _strProjTar = crsTar;
 
@@ -47,27 +277,13 @@ void CProj::init(const char* crsSrc, const char* crsTar) {
     _strProjTar += " +type=crs";
   }
 
-  if (nullptr != _pj) {
-    proj_destroy(_pj);
-    _pj = nullptr;
-  }
-
-  if (nullptr != _ctx) {
-    proj_context_destroy(_ctx);
-    _ctx = nullptr;
-  }
-
-  _ctx = proj_context_create();
-  if (nullptr == _ctx) {
+  _fastPath = eFastPathNone;
+  if (nullptr == localThread()->ctx) {
     qWarning() << "Failed to create projection constex:";
     return;
   }
-  _pj = proj_create_crs_to_crs(_ctx, _strProjSrc.toLatin1(), _strProjTar.toLatin1(), NULL);
-  if (nullptr != _pj) {
-    PJ* P_for_GIS = proj_normalize_for_visualization(_ctx, _pj);
-    proj_destroy(_pj);
-    _pj = P_for_GIS;
-  }
+  _id = nextId.fetchAndAddRelaxed(1);
+  _pj = _getPj();
 
   _isSrcLatLong = _isLatLong(_strProjSrc);
   _isTarLatLong = _isLatLong(_strProjTar);
@@ -77,11 +293,82 @@ void CProj::init(const char* crsSrc, const char* crsTar) {
     return;
   }
 
-  qDebug() << "Create projection:" << _strProjSrc << "->" << _strProjTar;
+  _fastPath = _findFastPath();
+
+  qDebug() << "Create projection:" << _strProjSrc << "->" << _strProjTar << "fast path:" << _fastPath;
+}
+
+CProj::fastpath_e CProj::_findFastPath() const {
+  fastpath_e candidate;
+  if (_isSrcLatLong && _isTarLatLong) {
+    candidate = eFastPathIdentity;
+  } else if (!_isSrcLatLong && _isTarLatLong) {
+    candidate = eFastPathMercSrc;
+  } else if (_isSrcLatLong && !_isTarLatLong) {
+    candidate = eFastPathMercTar;
+  } else {
+    return eFastPathNone;
+  }
+
+  /*
+      Instead of guessing from the CRS definition the candidate is compared
+      with the result of PROJ. Thus any definition of web mercator is detected
+      and a datum shift or something else will never be missed.
+   */
+  static const QPointF samples[] = {{0, 0},    {13.4, 52.5}, {-120, -45}, {179.9, 80},
+                                    {190, 10}, {-190, -10},  {-75, -84},  {45.5, 84}};
+
+  for (const QPointF& sample : samples) {
+    const QPointF lonlat = sample * DEG_TO_RAD;
+
+    QPointF pt1 = lonlat;
+    QPointF pt2 = lonlat;
+    qreal tolerance;
+
+    switch (candidate) {
+      case eFastPathIdentity:
+        _transformProj(&pt1.rx(), &pt1.ry(), 0, 1, PJ_FWD);
+        tolerance = 1e-9;
+        break;
+
+      case eFastPathMercSrc:
+        _transformProj(&pt1.rx(), &pt1.ry(), 0, 1, PJ_INV);
+        mercFwd(&pt2.rx(), &pt2.ry(), 0, 1);
+        tolerance = 1e-4;
+        break;
+
+      case eFastPathMercTar:
+        _transformProj(&pt1.rx(), &pt1.ry(), 0, 1, PJ_FWD);
+        mercFwd(&pt2.rx(), &pt2.ry(), 0, 1);
+        tolerance = 1e-4;
+        break;
+
+      default:
+        return eFastPathNone;
+    }
+
+    if (!(qAbs(pt1.x() - pt2.x()) < tolerance) || !(qAbs(pt1.y() - pt2.y()) < tolerance)) {
+      return eFastPathNone;
+    }
+
+    if (candidate != eFastPathIdentity) {
+      // and the way back
+      QPointF pt3 = pt1;
+      QPointF pt4 = pt1;
+      _transformProj(&pt3.rx(), &pt3.ry(), 0, 1, candidate == eFastPathMercSrc ? PJ_FWD : PJ_INV);
+      mercInv(&pt4.rx(), &pt4.ry(), 0, 1);
+
+      if (!(qAbs(pt3.x() - pt4.x()) < 1e-9) || !(qAbs(pt3.y() - pt4.y()) < 1e-9)) {
+        return eFastPathNone;
+      }
+    }
+  }
+
+  return candidate;
 }
 
 bool CProj::_isLatLong(const QString& crs) const {
-  PJ* p = proj_create(_ctx, crs.toLatin1());
+  PJ* p = proj_create(localThread()->ctx, crs.toLatin1());
   PJ_TYPE type = proj_get_type(p);
   proj_destroy(p);
 
@@ -89,61 +376,71 @@ bool CProj::_isLatLong(const QString& crs) const {
 }
 
 void CProj::transform(QPolygonF& line, PJ_DIRECTION dir) const {
-  if (!isValid()) {
+  if (line.isEmpty()) {
     return;
   }
 
-  qreal factorPre = proj_degree_input(_pj, dir) ? RAD_TO_DEG : 1.0;
-  qreal factorPost = proj_degree_output(_pj, dir) ? DEG_TO_RAD : 1.0;
-
-  for (QPointF& pt : line) {
-    pt *= factorPre;
-    _transform(pt.rx(), pt.ry(), dir);
-    pt *= factorPost;
-  }
+  QPointF* pts = line.data();
+  transform(&pts->rx(), &pts->ry(), sizeof(QPointF), line.size(), dir);
 }
 
-void CProj::transform(QPointF& pt, PJ_DIRECTION dir) const {
-  if (!isValid()) {
+void CProj::transform(QPointF& pt, PJ_DIRECTION dir) const { transform(&pt.rx(), &pt.ry(), 0, 1, dir); }
+
+void CProj::transform(qreal& lon, qreal& lat, PJ_DIRECTION dir) const { transform(&lon, &lat, 0, 1, dir); }
+
+void CProj::transform(qreal* x, qreal* y, size_t stride, size_t n, PJ_DIRECTION dir) const {
+  if (!isValid() || (n == 0)) {
     return;
   }
 
-  if (proj_degree_input(_pj, dir)) {
-    pt *= RAD_TO_DEG;
-  }
+  switch (_fastPath) {
+    case eFastPathIdentity:
+      return;
+
+    case eFastPathMercSrc:
+      if (dir == PJ_FWD) {
+        mercInv(x, y, stride, n);
+      } else {
+        mercFwd(x, y, stride, n);
+      }
+      return;
 
-  _transform(pt.rx(), pt.ry(), dir);
+    case eFastPathMercTar:
+      if (dir == PJ_FWD) {
+        mercFwd(x, y, stride, n);
+      } else {
+        mercInv(x, y, stride, n);
+      }
+      return;
 
-  if (proj_degree_output(_pj, dir)) {
-    pt *= DEG_TO_RAD;
+    default:
+      _transformProj(x, y, stride, n, dir);
   }
 }
 
-void CProj::transform(qreal& lon, qreal& lat, PJ_DIRECTION dir) const {
-  if (!isValid()) {
+void CProj::_transformProj(qreal* x, qreal* y, size_t stride, size_t n, PJ_DIRECTION dir) const {
+  PJ* pj = _getPj();
+  if (nullptr == pj) {
     return;
   }
 
-  if (proj_degree_input(_pj, dir)) {
-    lon *= RAD_TO_DEG;
-    lat *= RAD_TO_DEG;
+  if (proj_degree_input(pj, dir)) {
+    for (size_t i = 0; i < n; i++) {
+      strided(x, stride, i) *= RAD_TO_DEG;
+      strided(y, stride, i) *= RAD_TO_DEG;
+    }
   }
 
-  _transform(lon, lat, dir);
+  proj_trans_generic(pj, dir, x, stride, n, y, stride, n, nullptr, 0, 0, nullptr, 0, 0);
 
-  if (proj_degree_output(_pj, dir)) {
-    lon *= DEG_TO_RAD;
-    lat *= DEG_TO_RAD;
+  if (proj_degree_output(pj, dir)) {
+    for (size_t i = 0; i < n; i++) {
+      strided(x, stride, i) *= DEG_TO_RAD;
+      strided(y, stride, i) *= DEG_TO_RAD;
+    }
   }
 }
 
-void CProj::_transform(qreal& lon, qreal& lat, PJ_DIRECTION dir) const {
-  PJ_COORD c = proj_coord(lon, lat, 0, 0);
-  c = proj_trans(_pj, dir, c);
-  lon = c.uv.u;
-  lat = c.uv.v;
-}
-
 bool CProj::validProjStr(const QString projStr, bool allowLonLatToo, fErrMessage errMessage) {
   bool res = false;
 
@@ -27,18 +27,47 @@
 #define RAD_TO_DEG 57.295779513082321
 #define DEG_TO_RAD .017453292519943296
 
+/**
+   @brief Transform coordinates between two coordinate reference systems
+
+   A CProj object can be used by several threads at the same time. As PROJ
+   contexts must not be shared between threads, each thread has a context
+   of it's own. It's created on the thread's first use of any CProj object
+   and destroyed when the thread finishes. The transformation object of a
+   thread is created by the first transform in that thread.
+
+   A copy is initialized from the source and target CRS of the original.
+ */
 class CProj {
   Q_DECLARE_TR_FUNCTIONS(CProj)
  public:
   CProj() = default;
   CProj(const QString& crsSrc, const QString& crsTar);
+  CProj(const CProj& other);
+  CProj(CProj&& other);
   virtual ~CProj();
 
+  CProj& operator=(const CProj& other);
+  CProj& operator=(CProj&& other);
+
   void init(const char* crsSrc, const char* crsTar);
 
   void transform(qreal& lon, qreal& lat, PJ_DIRECTION dir) const;
   void transform(QPointF& pt, PJ_DIRECTION dir) const;
   void transform(QPolygonF& line, PJ_DIRECTION dir) const;
+  /**
+     @brief Transform an array of coordinates in place
+
+     All coordinates are transformed by a single call into PROJ. Lat/long
+     coordinates are in [rad] as with all other transform methods.
+
+     @param x       pointer to the first x (longitude) coordinate
+     @param y       pointer to the first y (latitude) coordinate
+     @param stride  the distance in bytes between two consecutive coordinates
+     @param n       the number of coordinates
+     @param dir     the direction of the transformation
+   */
+  void transform(qreal* x, qreal* y, size_t stride, size_t n, PJ_DIRECTION dir) const;
   bool isValid() const { return nullptr != _pj; }
   bool isSrcLatLong() const { return _isSrcLatLong; }
   bool isTarLatLong() const { return _isTarLatLong; }
@@ -51,13 +80,34 @@ class CProj {
   static bool validProjStr(const QString projStr, bool allowLonLatToo, fErrMessage errMessage);
 
  private:
-  void _transform(qreal& lon, qreal& lat, PJ_DIRECTION dir) const;
-  bool _isLatLong(const QString& crs) const;
+  /**
+     Transformations that can be done without PROJ. The source is the
+     first CRS, the target the second one.
+   */
+  enum fastpath_e {
+    eFastPathNone,      //< use PROJ
+    eFastPathIdentity,  //< lat/long to the same lat/long
+    eFastPathMercSrc,   //< spherical (web) mercator to lat/long
+    eFastPathMercTar    //< lat/long to spherical (web) mercator
+  };
 
-  PJ_CONTEXT* _ctx = nullptr;
+  bool _isLatLong(const QString& crs) const;
+  /// create the transformation object within the given context
+  PJ* _createPj(PJ_CONTEXT* ctx) const;
+  /// get the transformation object of the calling thread
+  PJ* _getPj() const;
+  void _destroy();
+  void _transformProj(qreal* x, qreal* y, size_t stride, size_t n, PJ_DIRECTION dir) const;
+  fastpath_e _findFastPath() const;
+
+  /// the key of this object's transformation objects in the per thread tables, 0 if not initialized
+  qint32 _id = 0;
+  /// transformation object of the thread calling init()
   PJ* _pj = nullptr;
+
   bool _isSrcLatLong = false;
   bool _isTarLatLong = false;
+  fastpath_e _fastPath = eFastPathNone;
 
   QString _strProjSrc;
   QString _strProjTar;
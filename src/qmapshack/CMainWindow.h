@@ -45,6 +45,8 @@ class CMainWindow : public QMainWindow, private Ui::IMainWindow {
   Q_OBJECT
  public:
   static CMainWindow& self() { return *pSelf; }
+  /// false if there is no main window, as in unittests
+  static bool exists() { return pSelf != nullptr; }
 
   static QWidget* getBestWidgetForParent();
 
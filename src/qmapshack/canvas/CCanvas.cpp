@@ -384,6 +384,11 @@ void CCanvas::changeOverrideCursor(const QCursor& cursor, const QString& /*src*/
 }
 
 void CCanvas::triggerCompleteUpdate(CCanvas::redraw_e flags) {
+  // this is a workaround for unittesting
+  if (!CMainWindow::exists()) {
+    return;
+  }
+
   CCanvas* canvas = CMainWindow::self().getVisibleCanvas();
   if (canvas) {
     canvas->slotTriggerCompleteUpdate(flags);
@@ -89,7 +89,10 @@ bool IDrawContext::resize(const QSize& size) {
 QString IDrawContext::getProjection() const { return proj.getProjSrc(); }
 
 bool IDrawContext::setProjection(const QString& projStr) {
+  static QAtomicInt lastProjectionId;
+
   proj.init(projStr.toLatin1(), "EPSG:4326");
+  projectionId = ++lastProjectionId;
   return proj.isValid();
 }
 
@@ -238,16 +241,11 @@ void IDrawContext::convertRad2Px(QPointF& p) const {
   mutex.unlock();  // --------- stop serialize with thread
 }
 
-void IDrawContext::convertRad2Px(QPolygonF& poly) const {
+void IDrawContext::convertRad2M(QPolygonF& poly) const {
   if (!proj.isValid()) {
     return;
   }
 
-  mutex.lock();  // --------- start serialize with thread
-
-  QPointF f = focus;
-  convertRad2M(f);
-
   const int N = poly.size();
 
   struct p_t {
@@ -295,13 +293,40 @@ void IDrawContext::convertRad2Px(QPolygonF& poly) const {
       convertRad2M(o);
       pPt->rx() = 2 * o.x() + pPt->x();
     }
+  }
+}
+
+void IDrawContext::convertRad2Px(QPolygonF& poly) const {
+  if (!proj.isValid()) {
+    return;
+  }
 
-    *pPt = (*pPt - f) / (scale * zoomFactor) + center;
+  mutex.lock();  // --------- start serialize with thread
+
+  QPointF f = focus;
+  convertRad2M(f);
+  convertRad2M(poly);
+
+  for (QPointF& pt : poly) {
+    pt = (pt - f) / (scale * zoomFactor) + center;
   }
 
   mutex.unlock();  // --------- stop serialize with thread
 }
 
+QTransform IDrawContext::getTransformM2Px() const {
+  mutex.lock();  // --------- start serialize with thread
+
+  QPointF f = focus;
+  convertRad2M(f);
+
+  const QPointF s = scale * zoomFactor;
+  QTransform trafo(1.0 / s.x(), 0, 0, 1.0 / s.y(), center.x() - f.x() / s.x(), center.y() - f.y() / s.y());
+
+  mutex.unlock();  // --------- stop serialize with thread
+  return trafo;
+}
+
 void IDrawContext::draw(QPainter& p, CCanvas::redraw_e needsRedraw, const QPointF& f) {
   if (!proj.isValid()) {
     return;
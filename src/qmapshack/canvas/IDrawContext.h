@@ -23,6 +23,7 @@
 #include <QMutex>
 #include <QPointF>
 #include <QThread>
+#include <QTransform>
 
 #include "canvas/CCanvas.h"
 #include "gis/proj_x.h"
@@ -90,6 +91,29 @@ class IDrawContext : public QThread {
    */
   void convertRad2Px(QPointF& p) const;
   void convertRad2Px(QPolygonF& poly) const;
+  /**
+     @brief Convert a polyline of geo coordinates in [rad] into the currently used projection
+     @note  See convertRad2M(QPointF&)
+     @param poly          the polyline to convert
+   */
+  void convertRad2M(QPolygonF& poly) const;
+
+  /**
+     @brief Get the affine transformation from projected coordinates to pixel coordinates of the viewport
+
+     Coordinates converted by convertRad2M() can be cached as long as the
+     projection does not change. A pan or zoom only needs this transformation.
+
+     @return The transformation for the current focus and zoom factor
+   */
+  QTransform getTransformM2Px() const;
+
+  /**
+     @brief Get an id unique to the projection currently set
+
+     Use it to invalidate cached coordinates in the projected coordinate system.
+   */
+  qint32 getProjectionId() const { return projectionId; }
 
   /**
      @brief Check if the internal needs redraw flag is set
@@ -190,6 +214,9 @@ class IDrawContext : public QThread {
   /// index into scales table
   int zoomIndex = 0;
 
+  /// unique id of the projection, changes with every call to setProjection()
+  qint32 projectionId = 0;
+
  private:
   /// the used scales and the type of scale levels
   const qreal* scales = nullptr;
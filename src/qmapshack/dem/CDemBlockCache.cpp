@@ -0,0 +1,69 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "dem/CDemBlockCache.h"
+
+#define DEFAULT_MAX_BYTES (256 * 1024 * 1024)
+
+const qint32 CDemBlockCache::blockSize;
+
+CDemBlockCache& CDemBlockCache::self() {
+  static CDemBlockCache cache(DEFAULT_MAX_BYTES);
+  return cache;
+}
+
+CDemBlockCache::CDemBlockCache(qint64 maxBytes)
+    : cache(maxBytes, [](const QVector<float>& block) { return qint64(block.size() * sizeof(float)); }) {}
+
+quint32 CDemBlockCache::datasetId(const QString& filename) {
+  QMutexLocker lock(&mutex);
+  if (!datasetIds.contains(filename)) {
+    datasetIds[filename] = datasetIds.size() + 1;
+  }
+  return datasetIds[filename];
+}
+
+bool CDemBlockCache::find(const dem_block_key_t& key, QVector<float>& block) {
+  QMutexLocker lock(&mutex);
+  return cache.find(key, block);
+}
+
+void CDemBlockCache::insert(const dem_block_key_t& key, const QVector<float>& block) {
+  QMutexLocker lock(&mutex);
+  cache.insert(key, block);
+}
+
+void CDemBlockCache::clear() {
+  QMutexLocker lock(&mutex);
+  cache.clear();
+}
+
+void CDemBlockCache::setMaxBytes(qint64 bytes) {
+  QMutexLocker lock(&mutex);
+  cache.setMaxBytes(bytes);
+}
+
+qint64 CDemBlockCache::getMaxBytes() const {
+  QMutexLocker lock(&mutex);
+  return cache.getMaxBytes();
+}
+
+CDemBlockCache::stats_t CDemBlockCache::getStats() const {
+  QMutexLocker lock(&mutex);
+  return cache.getStats();
+}
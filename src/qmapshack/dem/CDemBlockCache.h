@@ -0,0 +1,112 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CDEMBLOCKCACHE_H
+#define CDEMBLOCKCACHE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+#include "helpers/CLruCache.h"
+
+/// structured key to address a block of decoded DEM data
+struct dem_block_key_t {
+  quint32 dataset;  //< id of the dataset, see CDemBlockCache::datasetId()
+  qint32 level;     //< the overview level, 0 for full resolution
+  qint32 x;         //< the block column
+  qint32 y;         //< the block row
+
+  bool operator==(const dem_block_key_t& other) const {
+    return (dataset == other.dataset) && (level == other.level) && (x == other.x) && (y == other.y);
+  }
+};
+
+inline uint qHash(const dem_block_key_t& key, uint seed = 0) {
+  return qHash((quint64(key.dataset) << 32) | quint32(key.level), seed) ^
+         qHash((quint64(quint32(key.x)) << 32) | quint32(key.y), seed);
+}
+
+/**
+   @brief A least recently used memory cache for decoded DEM data
+
+   The raster of a dataset is split into square blocks of blockSize pixel.
+   Each block holds the elevation data as float, row by row. Blocks at the
+   right and bottom border of the raster can be smaller.
+
+   The cache is shared by all DEM files, for rendering and elevation lookups.
+   If the size of all blocks exceeds the limit the least recently used blocks
+   are evicted. The limit is a global setting, stored along with the DEM paths.
+   All methods are thread safe.
+ */
+class CDemBlockCache {
+ public:
+  using stats_t = CLruCache<dem_block_key_t, QVector<float>>::stats_t;
+
+  /// width and height of a block in pixel
+  static const qint32 blockSize = 256;
+
+  static CDemBlockCache& self();
+
+  /**
+     @brief Get an id for a dataset file
+
+     All instances of the same file share the same id and thus the cached blocks.
+
+     @param filename  the dataset's file name
+     @return A unique id
+   */
+  quint32 datasetId(const QString& filename);
+
+  /**
+     @brief Lookup a block and mark it as most recently used
+
+     @param key     the block's key
+     @param block   the block's data is assigned to this on success
+     @return True if the block has been found
+   */
+  bool find(const dem_block_key_t& key, QVector<float>& block);
+
+  /**
+     @brief Insert or replace a block
+
+     @param key     the block's key
+     @param block   the block's data
+   */
+  void insert(const dem_block_key_t& key, const QVector<float>& block);
+
+  void clear();
+
+  void setMaxBytes(qint64 bytes);
+  qint64 getMaxBytes() const;
+
+  stats_t getStats() const;
+
+ private:
+  CDemBlockCache(qint64 maxBytes);
+  ~CDemBlockCache() = default;
+
+  mutable QMutex mutex;
+
+  CLruCache<dem_block_key_t, QVector<float>> cache;
+
+  /// dataset ids by file name
+  QHash<QString, quint32> datasetIds;
+};
+
+#endif  // CDEMBLOCKCACHE_H
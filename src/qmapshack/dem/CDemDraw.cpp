@@ -19,9 +19,11 @@
 #include "dem/CDemDraw.h"
 
 #include <QtWidgets>
+#include <numeric>
 
 #include "CMainWindow.h"
 #include "canvas/CCanvas.h"
+#include "dem/CDemBlockCache.h"
 #include "dem/CDemItem.h"
 #include "dem/CDemList.h"
 #include "dem/CDemPathSetup.h"
@@ -80,6 +82,8 @@ void CDemDraw::setupDemPath(const QString& path) {
 
 void CDemDraw::setupDemPath(const QStringList& paths) {
   demPaths = paths;
+  // the files are reloaded and might have changed on disk
+  CDemBlockCache::self().clear();
 
   for (CDemDraw* dem : qAsConst(dems)) {
     QStringList keys;
@@ -89,9 +93,17 @@ void CDemDraw::setupDemPath(const QStringList& paths) {
   }
 }
 
-void CDemDraw::saveDemPath(QSettings& cfg) { cfg.setValue("demPaths", demPaths); }
+void CDemDraw::saveDemPath(QSettings& cfg) {
+  cfg.setValue("demPaths", demPaths);
+  cfg.setValue("demBlockCacheMB", CDemBlockCache::self().getMaxBytes() / (1024 * 1024));
+}
+
+void CDemDraw::loadDemPath(QSettings& cfg) {
+  demPaths = cfg.value("demPaths", demPaths).toStringList();
 
-void CDemDraw::loadDemPath(QSettings& cfg) { demPaths = cfg.value("demPaths", demPaths).toStringList(); }
+  const qint64 sizeMB = cfg.value("demBlockCacheMB", CDemBlockCache::self().getMaxBytes() / (1024 * 1024)).toLongLong();
+  CDemBlockCache::self().setMaxBytes(sizeMB * 1024 * 1024);
+}
 
 void CDemDraw::saveConfig(QSettings& cfg) {
   // store group context for later use
@@ -275,17 +287,60 @@ qreal CDemDraw::getSlopeAt(const QPointF& pos, bool checkScale) {
   return slope;
 }
 
-void CDemDraw::getElevationAt(const QPolygonF& pos, QPolygonF& ele) {
-  for (int i = 0; i < pos.size(); i++) {
-    qreal tmp = getElevationAt(pos[i]);
-    ele[i].ry() = (tmp == NOFLOAT) ? NOFLOAT : tmp;
+void CDemDraw::getValuesAt(const QPolygonF& pos, QPolygonF& values, fGetValues getValues) {
+  const qint32 N = pos.size();
+  for (qint32 i = 0; i < N; i++) {
+    values[i].ry() = NOFLOAT;
   }
+
+  if (!CDemItem::mutexActiveDems.tryLock()) {
+    return;
+  }
+
+  if (demList) {
+    // positions without a value so far
+    QVector<qint32> idxMissing(N);
+    std::iota(idxMissing.begin(), idxMissing.end(), 0);
+
+    QPolygonF missing = pos;
+    QVector<qreal> result;
+
+    for (int i = 0; i < demList->count() && !missing.isEmpty(); i++) {
+      CDemItem* item = demList->item(i);
+
+      if (!item || item->demfile.isNull()) {
+        // as all active maps have to be at the top of the list
+        // it is ok to break as soon as the first map with no
+        // active files is hit.
+        break;
+      }
+
+      getValues(item->demfile, missing, result);
+
+      // pass the positions still without value to the next DEM
+      qint32 n = 0;
+      for (qint32 j = 0; j < missing.size(); j++) {
+        if (result[j] != NOFLOAT) {
+          values[idxMissing[j]].ry() = result[j];
+        } else {
+          missing[n] = missing[j];
+          idxMissing[n] = idxMissing[j];
+          n++;
+        }
+      }
+      missing.resize(n);
+      idxMissing.resize(n);
+    }
+  }
+  CDemItem::mutexActiveDems.unlock();
+}
+
+void CDemDraw::getElevationAt(const QPolygonF& pos, QPolygonF& ele) {
+  getValuesAt(pos, ele, [](IDem* dem, const QPolygonF& p, QVector<qreal>& v) { dem->getElevationsAt(p, v); });
 }
 
 void CDemDraw::getSlopeAt(const QPolygonF& pos, QPolygonF& slope) {
-  for (int i = 0; i < pos.size(); i++) {
-    slope[i].ry() = getSlopeAt(pos[i]);
-  }
+  getValuesAt(pos, slope, [](IDem* dem, const QPolygonF& p, QVector<qreal>& v) { dem->getSlopesAt(p, v); });
 }
 
 void CDemDraw::getElevationAt(SGisLine& line) { line.updateElevation(this); }
@@ -19,9 +19,12 @@
 #ifndef CDEMDRAW_H
 #define CDEMDRAW_H
 
+#include <functional>
+
 #include "canvas/IDrawContext.h"
 
 class QPainter;
+class IDem;
 class CDemList;
 class CCanvas;
 class QSettings;
@@ -68,6 +71,19 @@ class CDemDraw : public IDrawContext {
   void drawt(buffer_t& currentBuffer) override;
 
  private:
+  using fGetValues = std::function<void(IDem* dem, const QPolygonF& pos, QVector<qreal>& values)>;
+  /**
+     @brief Query all active DEMs for values at a list of positions
+
+     Each DEM is queried with a single call for all positions not covered by
+     the DEMs before it.
+
+     @param pos       the positions in [rad]
+     @param values    the y coordinate of each point receives the value or NOFLOAT
+     @param getValues the query to apply to a DEM
+   */
+  void getValuesAt(const QPolygonF& pos, QPolygonF& values, fGetValues getValues);
+
   /**
      @brief Search in paths found in mapPaths for files with supported extensions and add them to mapList.
 
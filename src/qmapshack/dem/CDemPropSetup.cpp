@@ -21,6 +21,7 @@
 
 #include <QtWidgets>
 
+#include "dem/CDemBlockCache.h"
 #include "dem/CDemDraw.h"
 #include "dem/IDem.h"
 #include "helpers/Signals.h"
@@ -86,6 +87,11 @@ CDemPropSetup::CDemPropSetup(IDem* demfile, CDemDraw* dem) : IDemProp(demfile, d
   connect(comboGrades, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this,
           &CDemPropSetup::slotGradeIndex);
 
+  connect(spinCacheSize, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
+          &CDemPropSetup::slotSetCacheSize);
+  // the cache changes with each draw
+  connect(dem, &CDemDraw::sigStopThread, this, &CDemPropSetup::slotUpdateCacheInfo);
+
   const QVector<QRgb>& colortable = demfile->getSlopeColorTable();
   QPixmap pixmap(20, 10);
   pixmap.fill(colortable[5]);
@@ -146,6 +152,9 @@ void CDemPropSetup::slotPropertiesChanged() {
   spinBoxElevationShadeLimitHi->setSuffix(IUnit::self().elevationUnit);
   showElevationShadeScale->setChecked(demfile->doShowElevationShadeScale());
 
+  spinCacheSize->setValue(CDemBlockCache::self().getMaxBytes() / (1024 * 1024));
+  slotUpdateCacheInfo();
+
   dem->emitSigCanvasUpdate();
 
   X_____________UnBlockAllSignals_____________X(this);
@@ -219,3 +228,17 @@ void CDemPropSetup::slotElevationShadeHiValueChanged() {
   demfile->setElevationShadeHi(spinBoxElevationShadeLimitHi->value());
   dem->emitSigCanvasUpdate();
 }
+
+void CDemPropSetup::slotSetCacheSize(int sizeMB) {
+  CDemBlockCache::self().setMaxBytes(qint64(sizeMB) * 1024 * 1024);
+  slotUpdateCacheInfo();
+}
+
+void CDemPropSetup::slotUpdateCacheInfo() {
+  // only DEM files reading through CDemBlockCache report an info
+  const QString& info = demfile->getCacheInfo();
+  labelCacheInfo->setText(info);
+  labelCacheInfo->setVisible(!info.isEmpty());
+  labelCacheSize->setVisible(!info.isEmpty());
+  spinCacheSize->setVisible(!info.isEmpty());
+}
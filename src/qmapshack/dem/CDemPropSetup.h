@@ -45,6 +45,8 @@ class CDemPropSetup : public IDemProp, private Ui::IDemPropSetup {
   void slotElevationValueChanged();
   void slotElevationShadeLowValueChanged();
   void slotElevationShadeHiValueChanged();
+  void slotSetCacheSize(int sizeMB);
+  void slotUpdateCacheInfo();
 
  private:
   CTinySpinBox* slopeSpins[SLOPE_LEVELS];
@@ -24,6 +24,7 @@
 #include <QtWidgets>
 
 #include "CMainWindow.h"
+#include "dem/CDemBlockCache.h"
 #include "dem/CDemDraw.h"
 #include "helpers/CDraw.h"
 #include "units/IUnit.h"
@@ -59,6 +60,14 @@ CDemVRT::CDemVRT(const QString& filename, CDemDraw* parent) : IDem(parent), file
   hasOverviews = pBand->GetOverviewCount() != 0;
   qDebug() << "has overviews" << hasOverviews;
 
+  levels << QSize(dataset->GetRasterXSize(), dataset->GetRasterYSize());
+  for (int i = 0; i < pBand->GetOverviewCount(); i++) {
+    GDALRasterBand* pOverview = pBand->GetOverview(i);
+    levels << QSize(pOverview->GetXSize(), pOverview->GetYSize());
+  }
+
+  datasetId = CDemBlockCache::self().datasetId(filename);
+
   noData = pBand->GetNoDataValue(&hasNoData);
   qDebug() << "no data:" << hasNoData << noData;
 
@@ -108,15 +117,35 @@ CDemVRT::CDemVRT(const QString& filename, CDemDraw* parent) : IDem(parent), file
   qDebug() << "FF" << trFwd;
   qDebug() << "RR" << trInv;
 
+  // the dataset handle is the first one used for concurrent reads
+  datasetsIdle.push(dataset);
+
   connect(dem, &CDemDraw::sigNeedsRedraw, this, &CDemVRT::slotNeedsRedraw);
 
   isActivated = true;
 }
 
-CDemVRT::~CDemVRT() { GDALClose(dataset); }
+CDemVRT::~CDemVRT() {
+  threadPool.clear();
+  threadPool.waitForDone();
+
+  for (GDALDataset* ds : qAsConst(datasets)) {
+    GDALClose(ds);
+  }
+  GDALClose(dataset);
+}
 
 void CDemVRT::slotNeedsRedraw() { threadPool.clear(); }
 
+QString CDemVRT::getCacheInfo() const {
+  const CDemBlockCache::stats_t stats = CDemBlockCache::self().getStats();
+  return tr("%1 blocks, %2 MB, hit rate %3%, %4 blocks removed")
+      .arg(stats.entries)
+      .arg(stats.bytes / (1024 * 1024))
+      .arg(qRound(stats.hitRate() * 100))
+      .arg(stats.evictions);
+}
+
 qreal CDemVRT::getElevationAt(const QPointF& pos, bool checkScale) {
   if (!proj.isValid() || (checkScale && outOfScale)) {
     return NOFLOAT;
@@ -136,10 +165,7 @@ qreal CDemVRT::getElevationAt(const QPointF& pos, bool checkScale) {
   qreal x = pt.x() - qFloor(pt.x());
   qreal y = pt.y() - qFloor(pt.y());
 
-  mutex.lock();
-  CPLErr err = dataset->RasterIO(GF_Read, qFloor(pt.x()), qFloor(pt.y()), 2, 2, &e, 2, 2, GDT_Float32, 1, 0, 0, 0, 0);
-  mutex.unlock();
-  if (err == CE_Failure) {
+  if (!readRaster(0, qFloor(pt.x()), qFloor(pt.y()), 2, 2, e)) {
     return NOFLOAT;
   }
 
@@ -176,14 +202,8 @@ qreal CDemVRT::getSlopeAt(const QPointF& pos, bool checkScale) {
   qreal y = pt.y() - qFloor(pt.y());
 
   float win[eWinsize4x4];
-  {
-    QMutexLocker lock(&mutex);
-
-    CPLErr err = dataset->RasterIO(GF_Read, qFloor(pt.x()) - 1, qFloor(pt.y()) - 1, 4, 4, &win, 4, 4, GDT_Float32, 1, 0,
-                                   0, 0, 0);
-    if (err != CE_None) {
-      return NOFLOAT;
-    }
+  if (!readRaster(0, qFloor(pt.x()) - 1, qFloor(pt.y()) - 1, 4, 4, win)) {
+    return NOFLOAT;
   }
 
   for (int i = 0; i < eWinsize4x4; i++) {
@@ -196,6 +216,131 @@ qreal CDemVRT::getSlopeAt(const QPointF& pos, bool checkScale) {
   return slope;
 }
 
+void CDemVRT::readWindows(const QPolygonF& pos, qint32 size, const fWindow& onWindow) const {
+  struct window_t {
+    qint32 idx;
+    qint32 x;
+    qint32 y;
+    qreal fx;
+    qreal fy;
+    qint64 block;
+  };
+
+  QPolygonF pts = pos;
+  proj.transform(pts, PJ_INV);
+
+  // the window's origin relative to the pixel the position falls into
+  const qint32 offset = (size - 2) / 2;
+  const qint32 blockSize = CDemBlockCache::blockSize;
+  const qint64 nBlocksX = (xsize_px + blockSize - 1) / blockSize;
+
+  QVector<window_t> windows;
+  windows.reserve(pts.size());
+  for (qint32 i = 0; i < pts.size(); i++) {
+    QPointF pt = pts[i];
+    if (!boundingBox.contains(pt)) {
+      continue;
+    }
+
+    pt = trInv.map(pt);
+
+    window_t w;
+    w.idx = i;
+    w.x = qFloor(pt.x()) - offset;
+    w.y = qFloor(pt.y()) - offset;
+    w.fx = pt.x() - qFloor(pt.x());
+    w.fy = pt.y() - qFloor(pt.y());
+
+    if ((w.x < 0) || (w.y < 0) || ((w.x + size) > xsize_px) || ((w.y + size) > ysize_px)) {
+      continue;
+    }
+
+    w.block = (w.y / blockSize) * nBlocksX + (w.x / blockSize);
+    windows << w;
+  }
+
+  std::sort(windows.begin(), windows.end(), [](const window_t& w1, const window_t& w2) {
+    return (w1.block == w2.block) ? (w1.idx < w2.idx) : (w1.block < w2.block);
+  });
+
+  QVector<float> data;
+  float win[eWinsize4x4];
+
+  const qint32 N = windows.size();
+  for (qint32 i = 0; i < N;) {
+    // get the area covered by all windows of the same block
+    qint32 left = windows[i].x;
+    qint32 top = windows[i].y;
+    qint32 right = left + size;
+    qint32 bottom = top + size;
+
+    qint32 j = i + 1;
+    while ((j < N) && (windows[j].block == windows[i].block)) {
+      left = qMin(left, windows[j].x);
+      top = qMin(top, windows[j].y);
+      right = qMax(right, windows[j].x + size);
+      bottom = qMax(bottom, windows[j].y + size);
+      j++;
+    }
+
+    const qint32 w = right - left;
+    const qint32 h = bottom - top;
+    data.resize(w * h);
+
+    if (readRaster(0, left, top, w, h, data.data())) {
+      for (qint32 k = i; k < j; k++) {
+        const window_t& window = windows[k];
+        const float* src = data.data() + (window.y - top) * w + (window.x - left);
+        for (qint32 row = 0; row < size; row++) {
+          memcpy(win + row * size, src + row * w, size * sizeof(float));
+        }
+        onWindow(window.idx, win, window.fx, window.fy);
+      }
+    }
+
+    i = j;
+  }
+}
+
+void CDemVRT::getElevationsAt(const QPolygonF& pos, QVector<qreal>& ele) {
+  ele.fill(NOFLOAT, pos.size());
+  if (!proj.isValid()) {
+    return;
+  }
+
+  readWindows(pos, 2, [&](qint32 idx, const float* e, qreal x, qreal y) {
+    if (hasNoData && ((e[0] == noData) || (e[1] == noData) || (e[2] == noData) || (e[3] == noData))) {
+      return;
+    }
+
+    qreal b1 = e[0];
+    qreal b2 = e[1] - e[0];
+    qreal b3 = e[2] - e[0];
+    qreal b4 = e[0] - e[1] - e[2] + e[3];
+
+    ele[idx] = b1 + b2 * x + b3 * y + b4 * x * y;
+  });
+}
+
+void CDemVRT::getSlopesAt(const QPolygonF& pos, QVector<qreal>& slope) {
+  slope.fill(NOFLOAT, pos.size());
+  if (!proj.isValid()) {
+    return;
+  }
+
+  readWindows(pos, 4, [&](qint32 idx, const float* win, qreal x, qreal y) {
+    for (int i = 0; i < eWinsize4x4; i++) {
+      if (hasNoData && win[i] == noData) {
+        return;
+      }
+    }
+
+    float w[eWinsize4x4];
+    memcpy(w, win, sizeof(w));
+    slope[idx] = slopeOfWindowInterp(w, eWinsize4x4, x, y);
+  });
+}
+
 void CDemVRT::draw(IDrawContext::buffer_t& buf) {
   if (dem->needsRedraw()) {
     return;
@@ -276,35 +421,47 @@ void CDemVRT::draw(IDrawContext::buffer_t& buf) {
   qreal o2 = ((o1 + 0.4) >= 1.0) ? o1 : (o1 + 0.4);
   p.setOpacity(o1);
 
+  QVector<QPoint> origins;
   for (qint32 y = top - 1; y < bottom; y += h) {
+    for (qint32 x = left - 1; x < right; x += w) {
+      origins << QPoint(x, y);
+    }
+  }
+
+  // render the tiles in parallel, each into it's own images
+  QVector<tile_t> tiles(origins.size());
+  for (int i = 0; i < origins.size(); i++) {
     if (dem->needsRedraw()) {
       break;
     }
 
-    for (qint32 x = left - 1; x < right; x += w) {
-      if (dem->needsRedraw()) {
-        break;
-      }
-      // queue task to render tile
-      threadPool.start([this, x, y, w, h, &p, o1, o2]() { drawTile(x, y, w, h, o1, o2, p); });
-    }
+    const QPoint& origin = origins[i];
+    tile_t& tile = tiles[i];
+    threadPool.start([this, origin, w, h, &tile]() { renderTile(origin.x(), origin.y(), w, h, tile); });
   }
   threadPool.waitForDone();
+
+  // composite the tiles on the draw thread
+  for (tile_t& tile : tiles) {
+    if (dem->needsRedraw()) {
+      break;
+    }
+    drawTile(tile, o1, o2, p);
+  }
   drawElevationShadeScale(p);
 }
 
-void CDemVRT::drawTile(const qint32 x, const qint32 y, const qint32 w, const qint32 h, const qreal o1, const qreal o2,
-                       QPainter& p) const {
+void CDemVRT::renderTile(const qint32 x, const qint32 y, const qint32 w, const qint32 h, tile_t& tile) const {
   /*
       As the 3x3 window will create a border of one pixel
       more data is read than displayed to compensate.
    */
   const qint32 wp2 = w + 2;
   const qint32 hp2 = h + 2;
-  qreal wp2_used = wp2;
-  qreal hp2_used = hp2;
-  qreal w_used = w;
-  qreal h_used = h;
+  qint32 wp2_used = wp2;
+  qint32 hp2_used = hp2;
+  qint32 w_used = w;
+  qint32 h_used = h;
 
   if ((x + wp2) > xsize_px) {
     wp2_used = xsize_px - x;
@@ -322,88 +479,170 @@ void CDemVRT::drawTile(const qint32 x, const qint32 y, const qint32 w, const qin
     }
   }
 
+  // xscale and yscale are the pixel size of the full resolution, thus the shading has to use level 0
   QVector<float> data(wp2_used * hp2_used);
-  {
-    QMutexLocker lock(&mutex);
-    CPLErr err = dataset->RasterIO(GF_Read, x, y, wp2_used, hp2_used, data.data(), wp2_used, hp2_used, GDT_Float32, 1,
-                                   0, 0, 0, 0);
-    if (err != CE_None) {
-      return;
-    }
+  if (!readRaster(0, x, y, wp2_used, hp2_used, data.data())) {
+    return;
+  }
+
+  tile.rect = QRectF(x + 1, y + 1, w_used, h_used);
+
+  if (doHillshading()) {
+    tile.hillshading = QImage(w_used, h_used, QImage::Format_Indexed8);
+    tile.hillshading.setColorTable(graytable);
+    hillshading(data, w_used, h_used, tile.hillshading);
+  }
+
+  if (doSlopeShading()) {
+    tile.slopeShading = QImage(w_used, h_used, QImage::Format_Alpha8);
+    slopeShading(data, w_used, h_used, tile.slopeShading);
+  }
+
+  if (doSlopeColor()) {
+    tile.slopeColor = QImage(w_used, h_used, QImage::Format_Indexed8);
+    tile.slopeColor.setColorTable(slopetable);
+    slopecolor(data, w_used, h_used, tile.slopeColor);
+  }
+
+  if (doElevationLimit()) {
+    tile.elevationLimit = QImage(w_used, h_used, QImage::Format_Indexed8);
+    tile.elevationLimit.setColorTable(elevationtable);
+    elevationLimit(data, w_used, h_used, tile.elevationLimit);
+  }
+
+  if (doElevationShading()) {
+    tile.elevationShading = QImage(w_used, h_used, QImage::Format_Indexed8);
+    tile.elevationShading.setColorTable(elevationShadeTable);
+    elevationShading(data, w_used, h_used, tile.elevationShading);
+  }
+}
+
+void CDemVRT::drawTile(tile_t& tile, const qreal o1, const qreal o2, QPainter& p) const {
+  if (tile.rect.isNull()) {
+    return;
   }
 
   QPolygonF l(4);
-  l[0] = QPointF(x + 1, y + 1);
-  l[1] = QPointF(x + 1 + w_used, y + 1);
-  l[2] = QPointF(x + 1 + w_used, y + 1 + h_used);
-  l[3] = QPointF(x + 1, y + 1 + h_used);
+  l[0] = tile.rect.topLeft();
+  l[1] = tile.rect.topRight();
+  l[2] = tile.rect.bottomRight();
+  l[3] = tile.rect.bottomLeft();
   l = trFwd.map(l);
 
   proj.transform(l, PJ_FWD);
 
-  if (doHillshading()) {
+  auto drawLayer = [&](QImage& img, qreal opacity) {
+    if (img.isNull()) {
+      return;
+    }
     QPolygonF r = l;
-    QImage img(w_used, h_used, QImage::Format_Indexed8);
-    img.setColorTable(graytable);
-
-    hillshading(data, w_used, h_used, img);
+    p.setOpacity(opacity);
+    drawTile(img, r, p);
+  };
+
+  drawLayer(tile.hillshading, o1);
+  drawLayer(tile.slopeShading, o1);
+  drawLayer(tile.slopeColor, o2);
+  drawLayer(tile.elevationLimit, o2);
+  drawLayer(tile.elevationShading, o1);
+  p.setOpacity(o1);
+}
 
-    {
-      QMutexLocker lock(&mutex);
-      drawTile(img, r, p);
+GDALDataset* CDemVRT::acquireDataset() const {
+  {
+    QMutexLocker lock(&mutex);
+    if (!datasetsIdle.isEmpty()) {
+      return datasetsIdle.pop();
     }
   }
 
-  if (doSlopeShading()) {
-    QPolygonF r = l;
-    QImage img(w_used, h_used, QImage::Format_Alpha8);
-    slopeShading(data, w_used, h_used, img);
+  // all handles are busy, open another one
+  GDALDataset* ds = (GDALDataset*)GDALOpen(filename.toUtf8(), GA_ReadOnly);
+  if (nullptr == ds) {
+    qWarning() << "VRT: failed to open another handle for" << filename;
+    return nullptr;
+  }
 
-    {
-      QMutexLocker lock(&mutex);
-      drawTile(img, r, p);
-    }
+  QMutexLocker lock(&mutex);
+  datasets << ds;
+  return ds;
+}
+
+void CDemVRT::releaseDataset(GDALDataset* ds) const {
+  QMutexLocker lock(&mutex);
+  datasetsIdle.push(ds);
+}
+
+bool CDemVRT::readBlock(qint32 level, qint32 bx, qint32 by, QVector<float>& block) const {
+  const dem_block_key_t key = {datasetId, level, bx, by};
+  if (CDemBlockCache::self().find(key, block)) {
+    return true;
   }
 
-  if (doSlopeColor()) {
-    QPolygonF r = l;
-    QImage img(w_used, h_used, QImage::Format_Indexed8);
-    img.setColorTable(slopetable);
-    slopecolor(data, w_used, h_used, img);
-
-    {
-      QMutexLocker lock(&mutex);
-      p.setOpacity(o2);
-      drawTile(img, r, p);
-      p.setOpacity(o1);
-    }
+  const QSize& size = levels[level];
+  const qint32 blockSize = CDemBlockCache::blockSize;
+  const qint32 x = bx * blockSize;
+  const qint32 y = by * blockSize;
+  const qint32 w = qMin(blockSize, size.width() - x);
+  const qint32 h = qMin(blockSize, size.height() - y);
+  block.resize(w * h);
+
+  GDALDataset* ds = acquireDataset();
+  if (nullptr == ds) {
+    return false;
   }
 
-  if (doElevationLimit()) {
-    QPolygonF r = l;
-    QImage img(w_used, h_used, QImage::Format_Indexed8);
-    img.setColorTable(elevationtable);
-    elevationLimit(data, w_used, h_used, img);
-
-    {
-      QMutexLocker lock(&mutex);
-      p.setOpacity(o2);
-      drawTile(img, r, p);
-      p.setOpacity(o1);
-    }
+  GDALRasterBand* pBand = ds->GetRasterBand(1);
+  if (level > 0) {
+    pBand = pBand->GetOverview(level - 1);
   }
+  CPLErr err = pBand->RasterIO(GF_Read, x, y, w, h, block.data(), w, h, GDT_Float32, 0, 0);
+  releaseDataset(ds);
 
-  if (doElevationShading()) {
-    QPolygonF r = l;
-    QImage img(w_used, h_used, QImage::Format_Indexed8);
-    img.setColorTable(elevationShadeTable);
-    elevationShading(data, w_used, h_used, img);
+  if (err == CE_Failure) {
+    return false;
+  }
+
+  CDemBlockCache::self().insert(key, block);
+  return true;
+}
+
+bool CDemVRT::readRaster(qint32 level, qint32 x, qint32 y, qint32 w, qint32 h, float* data) const {
+  if ((level < 0) || (level >= levels.size())) {
+    return false;
+  }
 
-    {
-      QMutexLocker lock(&mutex);
-      drawTile(img, r, p);
+  const QSize& size = levels[level];
+  if ((x < 0) || (y < 0) || (w <= 0) || (h <= 0) || ((x + w) > size.width()) || ((y + h) > size.height())) {
+    return false;
+  }
+
+  // copy the data from all blocks intersecting with the area
+  const qint32 blockSize = CDemBlockCache::blockSize;
+  QVector<float> block;
+  for (qint32 by = y / blockSize; by <= (y + h - 1) / blockSize; by++) {
+    for (qint32 bx = x / blockSize; bx <= (x + w - 1) / blockSize; bx++) {
+      if (!readBlock(level, bx, by, block)) {
+        return false;
+      }
+
+      const qint32 blockLeft = bx * blockSize;
+      const qint32 blockTop = by * blockSize;
+      const qint32 blockWidth = qMin(blockSize, size.width() - blockLeft);
+
+      const qint32 left = qMax(x, blockLeft);
+      const qint32 right = qMin(x + w, blockLeft + blockWidth);
+      const qint32 top = qMax(y, blockTop);
+      const qint32 bottom = qMin(y + h, blockTop + blockSize);
+
+      for (qint32 row = top; row < bottom; row++) {
+        memcpy(data + (row - y) * w + (left - x), block.constData() + (row - blockTop) * blockWidth + (left - blockLeft),
+               (right - left) * sizeof(float));
+      }
     }
   }
+
+  return true;
 }
 
 void CDemVRT::drawElevationShadeScale(QPainter& p) const {
@@ -19,8 +19,11 @@
 #ifndef CDEMVRT_H
 #define CDEMVRT_H
 
+#include <QImage>
 #include <QMutex>
+#include <QStack>
 #include <QThreadPool>
+#include <functional>
 
 #include "dem/IDem.h"
 
@@ -37,21 +40,84 @@ class CDemVRT : public IDem {
 
   qreal getElevationAt(const QPointF& pos, bool checkScale) override;
   qreal getSlopeAt(const QPointF& pos, bool checkScale) override;
+  void getElevationsAt(const QPolygonF& pos, QVector<qreal>& ele) override;
+  void getSlopesAt(const QPolygonF& pos, QVector<qreal>& slope) override;
+
+  QString getCacheInfo() const override;
 
  private slots:
   void slotNeedsRedraw();
 
  private:
+  /// the images of a tile rendered by a worker thread
+  struct tile_t {
+    /// the area of the tile in dataset pixel, null if nothing has been rendered
+    QRectF rect;
+    QImage hillshading;
+    QImage slopeShading;
+    QImage slopeColor;
+    QImage elevationLimit;
+    QImage elevationShading;
+  };
+
   using IDem::drawTile;
   void drawElevationShadeScale(QPainter& p) const;
-  void drawTile(const qint32 x, const qint32 y, const qint32 w, const qint32 h,
-                const qreal o1, const qreal o2, QPainter& p) const;
-
+  /// render the tile's layers into private images, called by the worker threads
+  void renderTile(const qint32 x, const qint32 y, const qint32 w, const qint32 h, tile_t& tile) const;
+  /// draw a rendered tile, called by the draw thread
+  void drawTile(tile_t& tile, const qreal o1, const qreal o2, QPainter& p) const;
+
+  /**
+     @brief Get a dataset handle for exclusive use
+
+     GDAL dataset handles must not be used by several threads at the same time. Instead
+     of serializing all reads each reading thread gets it's own handle. Idle handles
+     are reused. A new handle is opened if all handles are busy.
+
+     @return A handle or nullptr if the file could not be opened
+   */
+  GDALDataset* acquireDataset() const;
+  /// return a handle obtained by acquireDataset()
+  void releaseDataset(GDALDataset* ds) const;
+  /// get a block of CDemBlockCache, read it from the dataset's level if it is not cached
+  bool readBlock(qint32 level, qint32 bx, qint32 by, QVector<float>& block) const;
+  /**
+     @brief Read an area of raster data as float, served by CDemBlockCache
+
+     @param level   the level to read from, 0 for full resolution, n for the nth overview
+     @param x       the left pixel of the area in the level's raster
+     @param y       the top pixel of the area in the level's raster
+     @param w       the width of the area in pixel
+     @param h       the height of the area in pixel
+     @param data    a buffer of w * h floats
+     @return True on success
+   */
+  bool readRaster(qint32 level, qint32 x, qint32 y, qint32 w, qint32 h, float* data) const;
+
+  using fWindow = std::function<void(qint32 idx, const float* win, qreal x, qreal y)>;
+  /**
+     @brief Read a window of raster data around each position
+
+     The positions are grouped by the CDemBlockCache block they fall into. The
+     data of each group is read at once. Positions outside the raster are skipped.
+
+     @param pos       the positions in [rad]
+     @param size      the window size in pixel (2 for a 2x2 window, 4 for a 4x4 window)
+     @param onWindow  called for each position with its index, the window data and the
+                      fractional position within the window's center pixel
+   */
+  void readWindows(const QPolygonF& pos, qint32 size, const fWindow& onWindow) const;
+
+  /// guards the dataset handles
   mutable QMutex mutex;
 
   QString filename;
   /// instance of GDAL dataset
   GDALDataset* dataset;
+  /// dataset handles currently not in use
+  mutable QStack<GDALDataset*> datasetsIdle;
+  /// additional dataset handles opened for concurrent reads
+  mutable QList<GDALDataset*> datasets;
 
   QPointF ref1;
   QPointF ref2;
@@ -62,8 +128,13 @@ class CDemVRT : public IDem {
   QTransform trInv;
 
   bool hasOverviews = false;
+  /// the raster size of each level, level 0 is the full resolution, level n the nth overview
+  QVector<QSize> levels;
   bool outOfScale = false;
 
+  /// the id of the dataset in CDemBlockCache
+  quint32 datasetId = 0;
+
   QRectF boundingBox;
 
   QThreadPool threadPool;
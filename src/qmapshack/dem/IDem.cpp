@@ -101,6 +101,22 @@ IDem::IDem(CDemDraw* parent) : IDrawObject(parent), dem(parent) {
 
 IDem::~IDem() {}
 
+void IDem::getElevationsAt(const QPolygonF& pos, QVector<qreal>& ele) {
+  const qint32 N = pos.size();
+  ele.resize(N);
+  for (qint32 i = 0; i < N; i++) {
+    ele[i] = getElevationAt(pos[i], false);
+  }
+}
+
+void IDem::getSlopesAt(const QPolygonF& pos, QVector<qreal>& slope) {
+  const qint32 N = pos.size();
+  slope.resize(N);
+  for (qint32 i = 0; i < N; i++) {
+    slope[i] = getSlopeAt(pos[i], false);
+  }
+}
+
 void IDem::saveConfig(QSettings& cfg) {
   IDrawObject::saveConfig(cfg);
 
@@ -53,8 +53,33 @@ class IDem : public IDrawObject {
   virtual qreal getElevationAt(const QPointF& pos, bool checkScale) = 0;
   virtual qreal getSlopeAt(const QPointF& pos, bool checkScale) = 0;
 
+  /**
+     @brief Get the elevation for a list of positions
+
+     The default implementation queries each position by getElevationAt(). Override
+     it to read the data of many positions at once.
+
+     @param pos   the positions in [rad]
+     @param ele   the elevation for each position or NOFLOAT if there is no data
+   */
+  virtual void getElevationsAt(const QPolygonF& pos, QVector<qreal>& ele);
+  /**
+     @brief Get the slope for a list of positions
+
+     @param pos   the positions in [rad]
+     @param slope the slope in [°] for each position or NOFLOAT if there is no data
+   */
+  virtual void getSlopesAt(const QPolygonF& pos, QVector<qreal>& slope);
+
   bool activated() const { return isActivated; }
 
+  /**
+     @brief Get a short summary of the DEM's memory cache for the setup widget
+
+     @return The summary or an empty string if the DEM has no memory cache
+   */
+  virtual QString getCacheInfo() const { return QString(); }
+
   /**
      @brief Get the dem's setup widget.
 
@@ -21,6 +21,7 @@
 #include <QtWidgets>
 
 #include "gis/CGisWorkspace.h"
+#include "gis/IGisItem.h"
 #include "helpers/CDraw.h"
 
 CGisDraw::CGisDraw(CCanvas* parent) : IDrawContext("gis", CCanvas::eRedrawGis, parent) {
@@ -46,4 +47,39 @@ void CGisDraw::drawt(buffer_t& currentBuffer) {
   p.translate(-pp);
 
   CGisWorkspace::self().draw(p, viewport, this);
+
+  // drop lines of items that have not been drawn, unless the drawing has been aborted
+  if (!needsRedraw()) {
+    for (auto it = lines.begin(); it != lines.end();) {
+      if (it->used) {
+        it->used = false;
+        ++it;
+      } else {
+        it = lines.erase(it);
+      }
+    }
+  }
+}
+
+bool CGisDraw::restoreLine(const IGisItem* item, QPolygonF& line) {
+  auto it = lines.find(item);
+  if (it == lines.end() || it->projectionId != getProjectionId() ||
+      it->geometryRevision != item->getGeometryRevision()) {
+    return false;
+  }
+
+  it->used = true;
+  line = getTransformM2Px().map(it->line);
+  return true;
+}
+
+void CGisDraw::storeLine(const IGisItem* item, QPolygonF& line) {
+  line_t& entry = lines[item];
+  entry.projectionId = getProjectionId();
+  entry.geometryRevision = item->getGeometryRevision();
+  entry.used = true;
+
+  convertRad2M(line);
+  entry.line = line;
+  line = getTransformM2Px().map(line);
 }
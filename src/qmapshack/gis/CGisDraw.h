@@ -19,9 +19,12 @@
 #ifndef CGISDRAW_H
 #define CGISDRAW_H
 
+#include <QHash>
+
 #include "canvas/IDrawContext.h"
 
 class CCanvas;
+class IGisItem;
 
 class CGisDraw : public IDrawContext {
  public:
@@ -31,8 +34,44 @@ class CGisDraw : public IDrawContext {
   using IDrawContext::draw;
   void draw(QPainter& p, const QRect& rect);
 
+  /**
+     @brief Restore an item's line in pixel coordinates from the cache
+
+     The cache keeps the line in projected coordinates. As long as neither the
+     projection nor the item's geometry changed, a pan or zoom is a plain affine
+     transformation of the cached coordinates.
+
+     @note Only to be used from within the draw thread.
+
+     @param item      the item the line belongs to
+     @param line      the line in pixel coordinates
+     @return True if a valid line has been found.
+   */
+  bool restoreLine(const IGisItem* item, QPolygonF& line);
+
+  /**
+     @brief Store an item's line in the cache and convert it to pixel coordinates
+
+     @note Only to be used from within the draw thread.
+
+     @param item      the item the line belongs to
+     @param line      in: the line in [rad], out: the line in pixel coordinates
+   */
+  void storeLine(const IGisItem* item, QPolygonF& line);
+
  protected:
   void drawt(buffer_t& currentBuffer) override;
+
+ private:
+  struct line_t {
+    qint32 projectionId;
+    qint32 geometryRevision;
+    bool used;
+    QPolygonF line;
+  };
+
+  /// items' lines in projected coordinates
+  QHash<const IGisItem*, line_t> lines;
 };
 
 #endif  // CGISDRAW_H
@@ -899,9 +899,7 @@ void CGisListWks::slotLoadWorkspace() {
 
   slotGeoSearch(static_cast<QAction*>(CMainWindow::self().findChild<QAction*>("actionGeoSearch"))->isChecked());
 
-  for (const QString& filename : qlOpts->arguments) {
-    CGisWorkspace::self().loadGisProject(filename);
-  }
+  CGisWorkspace::self().loadGisProjects(qlOpts->arguments);
 
   QUERY_RUN("SELECT focus FROM userfocus", );
   if (query.next()) {
@@ -142,6 +142,128 @@ void CGisWorkspace::loadGisProject(const QString& filename) {
   emit sigChanged();
 }
 
+void CGisWorkspace::loadGisProjects(const QStringList& filenames) {
+  const int N = filenames.count();
+
+  QVector<bool> detached(N);
+  int total = 0;
+  for (int i = 0; i < N; i++) {
+    detached[i] = IGisProject::canCreateDetached(filenames[i]);
+    total += detached[i] ? 1 : 0;
+  }
+
+  // there is nothing to gain from the thread pool for a single file
+  if (total < 2) {
+    for (const QString& filename : filenames) {
+      loadGisProject(filename);
+    }
+    return;
+  }
+
+  struct result_t {
+    IGisProject* project = nullptr;
+    QString errormsg;
+    bool ready = false;
+  };
+
+  QMutex mutex;
+  // the results by the index of the file, as the projects are added in the order of the files
+  QVector<result_t> results(N);
+  QAtomicInt canceled(0);
+
+  QThreadPool threadPool;
+  for (int i = 0; i < N; i++) {
+    if (!detached[i]) {
+      continue;
+    }
+
+    const QString& filename = filenames[i];
+    threadPool.start([&mutex, &results, &canceled, filename, i]() {
+      if (canceled.loadAcquire() != 0) {
+        return;
+      }
+
+      result_t result;
+      result.project = IGisProject::createDetached(filename, result.errormsg);
+      result.ready = true;
+
+      QMutexLocker lock(&mutex);
+      results[i] = result;
+    });
+  }
+
+  int cnt = 0;
+  // the index of the next file to add
+  int next = 0;
+  QStringList errors;
+
+  PROGRESS_SETUP(tr("Loading %1 files...").arg(total), 0, total, this);
+
+  bool done = false;
+  while (!done) {
+    done = threadPool.waitForDone(100);
+
+    // a file is added as soon as all files before it are added
+    while ((next < N) && (canceled.loadAcquire() == 0)) {
+      const QString& filename = filenames[next];
+      if (!detached[next]) {
+        loadGisProject(filename);
+        next++;
+        continue;
+      }
+
+      result_t result;
+      {
+        QMutexLocker lock(&mutex);
+        if (!results[next].ready) {
+          break;
+        }
+        result = results[next];
+      }
+
+      next++;
+      cnt++;
+
+      IGisProject* project = result.project;
+      if (project == nullptr) {
+        errors << filename + ":\n" + result.errormsg;
+        continue;
+      }
+
+      treeWks->blockSignals(true);
+      {
+        QMutexLocker lock(&IGisItem::mutexItems);
+        if (treeWks->hasProject(project)) {
+          errors << filename + ":\n" + tr("The project \"%1\" is already in the workspace.").arg(project->getName());
+          delete project;
+        } else {
+          treeWks->addProject(project);
+          project->finishLoading();
+          project->setWorkspaceFilter(currentSearch);
+        }
+      }
+      treeWks->blockSignals(false);
+    }
+
+    PROGRESS(cnt, canceled.storeRelease(1); threadPool.clear());
+  }
+
+  // files not added after the user hit cancel are dropped
+  for (int i = next; i < N; i++) {
+    delete results[i].project;
+  }
+
+  emit sigChanged();
+
+  if (!errors.isEmpty()) {
+    QMessageBox msgBox(QMessageBox::Warning, tr("Load projects..."),
+                       tr("%1 of %2 files could not be loaded.").arg(errors.count()).arg(total), QMessageBox::Ok,
+                       this);
+    msgBox.setDetailedText(errors.join("\n\n"));
+    msgBox.exec();
+  }
+}
+
 void CGisWorkspace::slotSetGisLayerOpacity(int val) {
   CCanvas::gisLayerOpacity = qreal(val) / 100;
   CCanvas* canvas = CMainWindow::self().getVisibleCanvas();
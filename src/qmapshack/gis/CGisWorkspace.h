@@ -184,6 +184,15 @@ class CGisWorkspace : public QWidget, private Ui::IGisWorkspace {
   virtual ~CGisWorkspace();
 
   void loadGisProject(const QString& filename);
+  /**
+     @brief Load several files at once
+
+     GPX, TCX, FIT and SLF files are loaded by a thread pool. The finished projects are
+     added to the workspace by the GUI thread. Errors are reported in a summary at the end.
+
+     @param filenames   a list of files to load
+   */
+  void loadGisProjects(const QStringList& filenames);
   /**
      @brief Draw all loaded data in the workspace that is visible
 
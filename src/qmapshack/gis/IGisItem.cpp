@@ -36,11 +36,31 @@
 #include "gis/rte/CGisItemRte.h"
 #include "gis/trk/CGisItemTrk.h"
 #include "gis/wpt/CGisItemWpt.h"
+#include "helpers/CBinaryDelta.h"
 #include "helpers/CSettings.h"
 #include "misc.h"
 #include "units/IUnit.h"
 
+/// size of the magic string and the version in front of the serialized item
+#define HISTORY_HEADER_SIZE (IGisItem::sizeMagic + 1)
+
+static QString hashHistoryData(const QByteArray& data) {
+  QCryptographicHash md5(QCryptographicHash::Md5);
+  md5.addData(data);
+  return md5.result().toHex();
+}
+
+// The hash of a delta is based on the hash of the previous event. Thus it does not depend on the size of the item.
+static QString hashHistoryDelta(const QString& previousHash, const QByteArray& delta) {
+  QCryptographicHash md5(QCryptographicHash::Md5);
+  md5.addData(previousHash.toLatin1());
+  md5.addData(delta);
+  return md5.result().toHex();
+}
+
 QRecursiveMutex IGisItem::mutexItems;
+const qint32 IGisItem::sizeMagic;
+const qint32 IGisItem::historyKeyframeInterval;
 
 const QString IGisItem::noKey;
 
@@ -338,7 +358,10 @@ void IGisItem::updateDecoration(quint32 enable, quint32 disable) {
 
   // Set Rating column
   if (!keywords.isEmpty()) {
-    QTreeWidgetItem::setIcon(CGisListWks::eColumnRating, QPixmap("://icons/32x32/Tag.png"));
+    // a worker thread leaves the icon to IGisProject::finishLoading()
+    if (!IGisProject::isLoadedByWorker()) {
+      QTreeWidgetItem::setIcon(CGisListWks::eColumnRating, QPixmap("://icons/32x32/Tag.png"));
+    }
     setToolTip(CGisListWks::eColumnRating, QStringList(getKeywordsSorted()).join(", "));
   } else {
     QTreeWidgetItem::setIcon(CGisListWks::eColumnRating, QIcon());
@@ -364,6 +387,9 @@ void IGisItem::changed(const QString& what, const QString& icon) {
   for (int i = history.events.size() - 1; i > history.histIdxCurrent; i--) {
     history.events.pop_back();
   }
+  if (history.idxPayload >= history.events.size()) {
+    history.resetPayload();
+  }
 
   // append history by new entry
   history.events << history_event_t();
@@ -373,46 +399,146 @@ void IGisItem::changed(const QString& what, const QString& icon) {
   event.icon = icon;
   event.who = CMainWindow::getUser();
 
+  history.histIdxCurrent = history.events.size() - 1;
+  storeHistoryData(history.histIdxCurrent);
+
+  updateDecoration(eMarkChanged, eMarkNone);
+}
+
+void IGisItem::geometryChanged() {
+  static QAtomicInt lastGeometryRevision;
+  geometryRevision = ++lastGeometryRevision;
+}
+
+void IGisItem::updateHistory() {
+  if (history.histIdxCurrent == NOIDX) {
+    return;
+  }
+
+  // the next event must not depend on the data replaced here
+  const qint32 idxNext = history.histIdxCurrent + 1;
+  if ((idxNext < history.events.size()) && history.events[idxNext].isDelta) {
+    makeHistoryKeyframe(idxNext);
+  }
+
+  storeHistoryData(history.histIdxCurrent);
+
+  updateDecoration(eMarkChanged, eMarkNone);
+}
+
+void IGisItem::storeHistoryData(qint32 idx) {
+  history_event_t& event = history.events[idx];
+
+  QByteArray payload;
+  const quint8 version = writeItemData(payload);
+
+  // store the difference to the previous event as long as the last keyframe is not too far away
+  qint32 chain = 0;
+  for (qint32 i = idx - 1; (i >= 0) && history.events[i].isDelta; i--) {
+    chain++;
+  }
+
+  QByteArray base, header;
+  if ((idx > 0) && (chain + 1 < historyKeyframeInterval) && getHistoryPayload(idx - 1, base, header) &&
+      (quint8(header.at(HISTORY_HEADER_SIZE - 1)) == version)) {
+    const QByteArray& delta = CBinaryDelta::create(base, payload);
+    // a keyframe is compressed, thus a large delta is not worth it
+    if (delta.size() * 4 < payload.size()) {
+      event.data = delta;
+      event.isDelta = true;
+      event.hash = hashHistoryDelta(history.events[idx - 1].hash, delta);
+
+      history.idxPayload = idx;
+      history.payload = payload;
+      history.header = header;
+      return;
+    }
+  }
+
+  event.data.clear();
+  event.isDelta = false;
+
   QDataStream stream(&event.data, QIODevice::WriteOnly);
   stream.setByteOrder(QDataStream::LittleEndian);
   stream.setVersion(QDataStream::Qt_5_2);
 
   *this >> stream;
 
-  QCryptographicHash md5(QCryptographicHash::Md5);
-  md5.addData(event.data);
-  event.hash = md5.result().toHex();
-
-  history.histIdxCurrent = history.events.size() - 1;
+  event.hash = hashHistoryData(event.data);
 
-  updateDecoration(eMarkChanged, eMarkNone);
+  history.idxPayload = idx;
+  history.payload = payload;
+  history.header = event.data.left(HISTORY_HEADER_SIZE);
 }
 
-void IGisItem::updateHistory() {
-  if (history.histIdxCurrent == NOIDX) {
+void IGisItem::makeHistoryKeyframe(qint32 idx) {
+  if (!history.events[idx].isDelta) {
+    return;
+  }
+
+  QByteArray payload, header;
+  if (!getHistoryPayload(idx, payload, header)) {
     return;
   }
 
-  history_event_t& event = history.events[history.histIdxCurrent];
+  history_event_t& event = history.events[idx];
   event.data.clear();
+  event.isDelta = false;
 
   QDataStream stream(&event.data, QIODevice::WriteOnly);
   stream.setByteOrder(QDataStream::LittleEndian);
   stream.setVersion(QDataStream::Qt_5_2);
+  stream.writeRawData(header.constData(), header.size());
+  stream << qCompress(payload, 9);
+}
 
-  *this >> stream;
+bool IGisItem::getHistoryPayload(qint32 idx, QByteArray& payload, QByteArray& header) {
+  // go back to the last keyframe or the cached payload
+  qint32 first = idx;
+  while ((first >= 0) && (first != history.idxPayload) && history.events[first].isDelta) {
+    first--;
+  }
+  if (first < 0) {
+    return false;
+  }
 
-  QCryptographicHash md5(QCryptographicHash::Md5);
-  md5.addData(event.data);
-  event.hash = md5.result().toHex();
+  if (first == history.idxPayload) {
+    payload = history.payload;
+    header = history.header;
+  } else {
+    const QByteArray& data = history.events[first].data;
+    if (data.size() <= HISTORY_HEADER_SIZE) {
+      return false;
+    }
 
-  updateDecoration(eMarkChanged, eMarkNone);
+    QDataStream stream(data);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setVersion(QDataStream::Qt_5_2);
+    stream.skipRawData(HISTORY_HEADER_SIZE);
+
+    QByteArray buffer;
+    stream >> buffer;
+    payload = qUncompress(buffer);
+    header = data.left(HISTORY_HEADER_SIZE);
+  }
+
+  for (qint32 i = first + 1; i <= idx; i++) {
+    QByteArray next;
+    if (!CBinaryDelta::apply(payload, history.events[i].data, next)) {
+      qWarning() << "Corrupt history of item" << getName() << "at event" << i;
+      return false;
+    }
+    payload = next;
+  }
+
+  return !payload.isEmpty();
 }
 
 void IGisItem::setupHistory() {
   getKey();
   history.histIdxInitial = NOIDX;
   history.histIdxCurrent = NOIDX;
+  history.resetPayload();
 
   // if history is empty setup an initial item
   if (history.events.isEmpty()) {
@@ -435,15 +561,14 @@ void IGisItem::setupHistory() {
   // and make it the initial item
   if (history.histIdxInitial == NOIDX) {
     history_event_t& event = history.events.last();
+    event.isDelta = false;
 
     QDataStream stream(&event.data, QIODevice::WriteOnly);
     stream.setByteOrder(QDataStream::LittleEndian);
     stream.setVersion(QDataStream::Qt_5_2);
     *this >> stream;
 
-    QCryptographicHash md5(QCryptographicHash::Md5);
-    md5.addData(event.data);
-    event.hash = md5.result().toHex();
+    event.hash = hashHistoryData(event.data);
 
     history.histIdxInitial = history.events.size() - 1;
   }
@@ -465,10 +590,18 @@ void IGisItem::loadHistory(int idx) {
   }
 
   // restore item from history entry
-  QDataStream stream(&event.data, QIODevice::ReadOnly);
-  stream.setByteOrder(QDataStream::LittleEndian);
-  stream.setVersion(QDataStream::Qt_5_2);
-  *this << stream;
+  if (event.isDelta) {
+    QByteArray payload, header;
+    if (!getHistoryPayload(idx, payload, header)) {
+      return;
+    }
+    readItemData(payload, quint8(header.at(HISTORY_HEADER_SIZE - 1)));
+  } else {
+    QDataStream stream(&event.data, QIODevice::ReadOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setVersion(QDataStream::Qt_5_2);
+    *this << stream;
+  }
 
   history.histIdxCurrent = idx;
 }
@@ -477,11 +610,19 @@ void IGisItem::cutHistoryAfter() {
   while (history.events.size() > (history.histIdxCurrent + 1)) {
     history.events.pop_back();
   }
+  if (history.idxPayload >= history.events.size()) {
+    history.resetPayload();
+  }
 }
 
 void IGisItem::cutHistoryBefore() {
+  // the current event must not depend on the events removed
+  if (history.histIdxCurrent >= 0) {
+    makeHistoryKeyframe(history.histIdxCurrent);
+  }
   for (int i = 0; i < history.histIdxCurrent; i++) {
     history.events[i].data.clear();
+    history.events[i].isDelta = false;
   }
 }
 
@@ -490,6 +631,9 @@ void IGisItem::squashHistory() {
     return;
   }
 
+  makeHistoryKeyframe(history.events.size() - 1);
+  history.resetPayload();
+
   history_event_t& first = history.events.first();
   history_event_t& last = history.events.last();
 
@@ -596,6 +740,11 @@ void IGisItem::setIcon(const QPixmap& icon) {
 }
 
 void IGisItem::showIcon() {
+  if (IGisProject::isLoadedByWorker()) {
+    // the icon is set by IGisProject::finishLoading() on the GUI thread
+    return;
+  }
+
   if (isNogo()) {
     const int& width = icon.width();
     const int& height = icon.height();
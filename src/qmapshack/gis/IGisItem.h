@@ -39,6 +39,7 @@ class CGisDraw;
 class IScrOpt;
 class IMouse;
 class QSqlDatabase;
+class QXmlStreamWriter;
 class IGisProject;
 struct searchValue_t;
 enum searchProperty_e : unsigned int;
@@ -52,7 +53,9 @@ class IGisItem : public QTreeWidgetItem {
     QString who = "QMapShack";
     QString icon;
     QString comment;
+    /// the complete serialized item or, if isDelta is set, the difference to the previous event
     QByteArray data;
+    bool isDelta = false;
   };
 
   struct history_t {
@@ -62,11 +65,24 @@ class IGisItem : public QTreeWidgetItem {
       histIdxInitial = NOIDX;
       histIdxCurrent = NOIDX;
       events.clear();
+      resetPayload();
+    }
+
+    void resetPayload() {
+      idxPayload = NOIDX;
+      payload.clear();
+      header.clear();
     }
 
     qint32 histIdxInitial;
     qint32 histIdxCurrent;
     QList<history_event_t> events;
+
+    // The uncompressed item data of event idxPayload, the base for the next delta. This is not serialized.
+    qint32 idxPayload = NOIDX;
+    QByteArray payload;
+    /// the magic string and version of the data format of the payload
+    QByteArray header;
   };
 
   struct link_t {
@@ -173,6 +189,11 @@ class IGisItem : public QTreeWidgetItem {
   /// this mutex has to be locked when ever the item list is accessed.
   static QRecursiveMutex mutexItems;
 
+  /// size of the magic string in front of a serialized item
+  static const qint32 sizeMagic = 10;
+  /// every n-th history event stores the complete item, even if a delta is possible
+  static const qint32 historyKeyframeInterval = 16;
+
   static void init();
   static QMenu* getColorMenu(const QString& title, QObject* obj, const char* slot, QWidget* parent);
   static qint32 selectColor(QWidget* parent);
@@ -402,6 +423,16 @@ class IGisItem : public QTreeWidgetItem {
    */
   const history_t& getHistory() const { return history; }
 
+  /**
+     @brief Get the revision of the item's geometry
+
+     The revision is unique over all items and changes with every change of the
+     item's coordinates. Use it to invalidate data derived from the coordinates.
+
+     @return The revision number
+   */
+  qint32 getGeometryRevision() const { return geometryRevision; }
+
   /**
      @brief Load a given state of change from the history
      @param idx
@@ -532,12 +563,31 @@ class IGisItem : public QTreeWidgetItem {
   void readWpt(const QDomNode& xml, wpt_t& wpt);
   /// write waypoint data to an XML snippet
   void writeWpt(QDomElement& xml, const wpt_t& wpt, bool strictGpx11);
+  /// write waypoint data to the current element of an XML stream
+  void writeWpt(QXmlStreamWriter& xml, const wpt_t& wpt, bool strictGpx11);
   /// generate a unique key from item's data
   virtual void genKey() const;
   /// setup the history structure right after the creation of the item
   void setupHistory();
   /// update current history entry (e.g. to save the flags)
   virtual void updateHistory();
+  /**
+     @brief Serialize the item's data without header and compression
+
+     That's the payload written by operator>>(). The history stores the
+     difference between the payloads of two events instead of the complete item.
+
+     @param buffer    the buffer to write to
+     @return The version of the data format.
+   */
+  virtual quint8 writeItemData(QByteArray& buffer) const = 0;
+  /**
+     @brief Restore the item from a payload written by writeItemData()
+
+     @param buffer    the payload
+     @param version   the version of the data format
+   */
+  virtual void readItemData(const QByteArray& buffer, quint8 version) = 0;
   /// convert a color string from GPX to a QT color
   QColor str2color(const QString& name);
   /// convert a QT color to a string to be used in a GPX file
@@ -546,6 +596,8 @@ class IGisItem : public QTreeWidgetItem {
   void splitLineToViewport(const QPolygonF& line, const QRectF& extViewport, QList<QPolygonF>& lines);
   /// call when ever you make a change to the item's data
   virtual void changed(const QString& what, const QString& icon);
+  /// call when ever the item's coordinates change to get a new geometry revision
+  void geometryChanged();
 
   void loadFromDb(quint64 id, QSqlDatabase& db);
   bool isVisible(const QRectF& rect, const QPolygonF& viewport, CGisDraw* gis);
@@ -577,6 +629,9 @@ class IGisItem : public QTreeWidgetItem {
   /// the hash in the database when the item was loaded/saved
   QString lastDatabaseHash;
 
+  /// see getGeometryRevision()
+  qint32 geometryRevision = 0;
+
   enum flags_e {
     eFlagCreatedInQms = 0x00000001,
     eFlagWriteAllowed = 0x00000002,
@@ -593,6 +648,12 @@ class IGisItem : public QTreeWidgetItem {
 
  private:
   void showIcon();
+  /// write the current state of the item to a history event, as delta to the previous event if possible
+  void storeHistoryData(qint32 idx);
+  /// replace the delta of a history event by the complete item
+  void makeHistoryKeyframe(qint32 idx);
+  /// reconstruct the uncompressed item data of a history event
+  bool getHistoryPayload(qint32 idx, QByteArray& payload, QByteArray& header);
 };
 
 QDataStream& operator>>(QDataStream& stream, IGisItem::history_t& h);
@@ -38,15 +38,28 @@ SGisLine::SGisLine(const QPolygonF& line) {
 }
 
 void SGisLine::updateElevation(CDemDraw* dem) {
+  // query all points and subpoints at once
+  QPolygonF coords;
+  for (const IGisLine::point_t& pt : qAsConst(*this)) {
+    coords << pt.coord;
+    for (const IGisLine::subpt_t& sub : pt.subpts) {
+      coords << sub.coord;
+    }
+  }
+
+  QPolygonF ele(coords.size());
+  dem->getElevationAt(coords, ele);
+
+  int idx = 0;
   for (int i = 0; i < size(); i++) {
     IGisLine::point_t& pt = (*this)[i];
-    qreal ele = dem->getElevationAt(pt.coord);
-    pt.ele = (ele == NOFLOAT) ? NOINT : qRound(ele);
+    qreal elePt = ele[idx++].y();
+    pt.ele = (elePt == NOFLOAT) ? NOINT : qRound(elePt);
 
     for (int n = 0; n < pt.subpts.size(); n++) {
       IGisLine::subpt_t& sub = pt.subpts[n];
-      qreal ele = dem->getElevationAt(sub.coord);
-      sub.ele = (ele == NOFLOAT) ? NOINT : qRound(ele);
+      qreal eleSub = ele[idx++].y();
+      sub.ele = (eleSub == NOFLOAT) ? NOINT : qRound(eleSub);
     }
   }
 }
@@ -20,7 +20,6 @@
 
 #include <QtWidgets>
 
-#include "CMainWindow.h"
 #include "gis/CGisListWks.h"
 #include "gis/fit/CFitStream.h"
 #include "gis/fit/defs/fit_enums.h"
@@ -40,15 +39,15 @@ CFitProject::CFitProject(const QString& filename, IDevice* parent) : IGisProject
 }
 
 void CFitProject::loadFitFromFile(const QString& filename, bool showErrorMsg) {
-  setIcon(CGisListWks::eColumnIcon, QIcon("://icons/32x32/FitProject.png"));
+  setProjectIcon("://icons/32x32/FitProject.png");
   blockUpdateItems(true);
   try {
     tryOpeningFitFile(filename);
   } catch (QString& errormsg) {
     if (showErrorMsg) {
-      QMessageBox::critical(CMainWindow::getBestWidgetForParent(), tr("Failed to load file %1...").arg(filename),
-                            errormsg, QMessageBox::Abort);
+      showLoadError(filename, errormsg);
     } else {
+      loadError = errormsg;
       qWarning() << "Failed to load FIT file:" << errormsg;
     }
     valid = false;
@@ -72,6 +72,11 @@ class CFitStream final {
 
   int countMesgOf(quint16 mesgNr);
 
+  /**
+     return: the values of all record messages. Use CFitMessage::getRecordIndex() to get the row of a record message.
+   */
+  const CFitRecordColumns& getRecords() const { return decode.getRecords(); }
+
   QString getFileName() const { return file.fileName(); }
 
  private:
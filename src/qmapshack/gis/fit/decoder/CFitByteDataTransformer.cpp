@@ -22,7 +22,7 @@
 #include "gis/fit/defs/CFitBaseType.h"
 #include "gis/fit/defs/fit_const.h"
 
-quint64 CFitByteDataTransformer::getUIntValue(const CFitBaseType& baseType, quint8* rawData) {
+quint64 CFitByteDataTransformer::getUIntValue(const CFitBaseType& baseType, const quint8* rawData) {
   switch (baseType.nr()) {
     case eBaseTypeNrUint8:
     case eBaseTypeNrUint8z:
@@ -46,7 +46,7 @@ quint64 CFitByteDataTransformer::getUIntValue(const CFitBaseType& baseType, quin
   }
 }
 
-qint64 CFitByteDataTransformer::getSIntValue(const CFitBaseType& baseType, quint8* rawData) {
+qint64 CFitByteDataTransformer::getSIntValue(const CFitBaseType& baseType, const quint8* rawData) {
   switch (baseType.nr()) {
     case eBaseTypeNrSint8:
       return getSint8(rawData);
@@ -65,7 +65,7 @@ qint64 CFitByteDataTransformer::getSIntValue(const CFitBaseType& baseType, quint
   }
 }
 
-qreal CFitByteDataTransformer::getFloatValue(const CFitBaseType& baseType, quint8* rawData) {
+qreal CFitByteDataTransformer::getFloatValue(const CFitBaseType& baseType, const quint8* rawData) {
   switch (baseType.nr()) {
     case eBaseTypeNrFloat32:
       return getFloat32(rawData);
@@ -78,35 +78,39 @@ qreal CFitByteDataTransformer::getFloatValue(const CFitBaseType& baseType, quint
   }
 }
 
-quint8 CFitByteDataTransformer::getUint8(quint8* rawData) { return (quint8)rawData[0]; }
+quint8 CFitByteDataTransformer::getUint8(const quint8* rawData) { return (quint8)rawData[0]; }
 
-quint16 CFitByteDataTransformer::getUint16(quint8* rawData) { return ((quint16)rawData[1] << 8) | (quint16)rawData[0]; }
+quint16 CFitByteDataTransformer::getUint16(const quint8* rawData) {
+  return ((quint16)rawData[1] << 8) | (quint16)rawData[0];
+}
 
-quint32 CFitByteDataTransformer::getUint32(quint8* rawData) {
+quint32 CFitByteDataTransformer::getUint32(const quint8* rawData) {
   return ((quint32)rawData[3] << 24) | ((quint32)rawData[2] << 16) | ((quint32)rawData[1] << 8) | (quint32)rawData[0];
 }
 
-quint64 CFitByteDataTransformer::getUint64(quint8* rawData) {
+quint64 CFitByteDataTransformer::getUint64(const quint8* rawData) {
   return ((quint64)rawData[7] << 56) | ((quint64)rawData[6] << 48) | ((quint64)rawData[5] << 40) |
          ((quint64)rawData[4] << 32) | ((quint64)rawData[3] << 24) | ((quint64)rawData[2] << 16) |
          ((quint64)rawData[1] << 8) | rawData[0];
 }
 
-qint8 CFitByteDataTransformer::getSint8(quint8* rawData) { return (qint8)rawData[0]; }
+qint8 CFitByteDataTransformer::getSint8(const quint8* rawData) { return (qint8)rawData[0]; }
 
-qint16 CFitByteDataTransformer::getSint16(quint8* rawData) { return ((qint16)rawData[1] << 8) | (qint16)rawData[0]; }
+qint16 CFitByteDataTransformer::getSint16(const quint8* rawData) {
+  return ((qint16)rawData[1] << 8) | (qint16)rawData[0];
+}
 
-qint32 CFitByteDataTransformer::getSint32(quint8* rawData) {
+qint32 CFitByteDataTransformer::getSint32(const quint8* rawData) {
   return ((qint32)rawData[3] << 24) | ((qint32)rawData[2] << 16) | ((qint32)rawData[1] << 8) | (qint32)rawData[0];
 }
 
-qint64 CFitByteDataTransformer::getSint64(quint8* rawData) {
+qint64 CFitByteDataTransformer::getSint64(const quint8* rawData) {
   return ((qint64)rawData[7] << 56) | ((qint64)rawData[6] << 48) | ((qint64)rawData[5] << 40) |
          ((qint64)rawData[4] << 32) | ((qint64)rawData[3] << 24) | ((qint64)rawData[2] << 16) |
          ((qint64)rawData[1] << 8) | rawData[0];
 }
 
-qreal CFitByteDataTransformer::getFloat32(quint8* rawData) {
+qreal CFitByteDataTransformer::getFloat32(const quint8* rawData) {
   qint32 fValue =
       (qint32)(((qint32)rawData[3] << 24) | ((qint32)rawData[2] << 16) | ((qint32)rawData[1] << 8) | rawData[0]);
   // comment: qreal is a double type (on almost all systems). Here we need to go through a 32 bit floating type.
@@ -116,7 +120,7 @@ qreal CFitByteDataTransformer::getFloat32(quint8* rawData) {
   return value;
 }
 
-qreal CFitByteDataTransformer::getFloat64(quint8* rawData) {
+qreal CFitByteDataTransformer::getFloat64(const quint8* rawData) {
   unsigned long long dValue = ((unsigned long long)rawData[7] << 56) | ((unsigned long long)rawData[6] << 48) |
                               ((unsigned long long)rawData[5] << 40) | ((unsigned long long)rawData[4] << 32) |
                               ((unsigned long long)rawData[3] << 24) | ((unsigned long long)rawData[2] << 16) |
@@ -128,21 +132,17 @@ qreal CFitByteDataTransformer::getFloat64(quint8* rawData) {
   return value;
 }
 
-QString CFitByteDataTransformer::getString(quint8* rawData, quint8 length) {
-  // find the 0 termination
+QString CFitByteDataTransformer::getString(const quint8* rawData, quint8 length) {
+  // find the 0 termination, but do not read beyond the field as the data is not copied anymore
   quint8 i = 0;
-  while (rawData[i] != 0) {
+  while ((i < length) && (rawData[i] != 0)) {
     i++;
-    // no 0 termination found, but length exceeded
-    if (i > length) {
-      break;
-    }
   }
 
   return QString::fromUtf8((const char*)rawData, i);
 }
 
-QByteArray CFitByteDataTransformer::getBytes(quint8* rawData, quint8 length) {
+QByteArray CFitByteDataTransformer::getBytes(const quint8* rawData, quint8 length) {
   return QByteArray((const char*)rawData, length);
 }
 
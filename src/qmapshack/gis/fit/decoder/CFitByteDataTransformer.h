@@ -27,27 +27,27 @@ class CFitFieldDefinition;
 class CFitByteDataTransformer {
  public:
   CFitByteDataTransformer() = delete;
-  static quint64 getUIntValue(const CFitBaseType& baseType, quint8* rawData);
-  static qint64 getSIntValue(const CFitBaseType& baseType, quint8* rawData);
-  static qreal getFloatValue(const CFitBaseType& baseType, quint8* rawData);
+  static quint64 getUIntValue(const CFitBaseType& baseType, const quint8* rawData);
+  static qint64 getSIntValue(const CFitBaseType& baseType, const quint8* rawData);
+  static qreal getFloatValue(const CFitBaseType& baseType, const quint8* rawData);
   /*
    * param rawData: the fit utf-8 string, 0 terminated.
    */
-  static QString getString(quint8* rawData, quint8 length);
-  static QByteArray getBytes(quint8* rawData, quint8 length);
+  static QString getString(const quint8* rawData, quint8 length);
+  static QByteArray getBytes(const quint8* rawData, quint8 length);
   static void swapFieldData(const CFitFieldDefinition& fieldDef, quint8* fieldData);
 
  private:
-  static quint8 getUint8(quint8* rawData);
-  static quint16 getUint16(quint8* rawData);
-  static quint32 getUint32(quint8* rawData);
-  static quint64 getUint64(quint8* rawData);
-  static qint8 getSint8(quint8* rawData);
-  static qint16 getSint16(quint8* rawData);
-  static qint32 getSint32(quint8* rawData);
-  static qint64 getSint64(quint8* rawData);
-  static qreal getFloat32(quint8* rawData);
-  static qreal getFloat64(quint8* rawData);
+  static quint8 getUint8(const quint8* rawData);
+  static quint16 getUint16(const quint8* rawData);
+  static quint32 getUint32(const quint8* rawData);
+  static quint64 getUint64(const quint8* rawData);
+  static qint8 getSint8(const quint8* rawData);
+  static qint16 getSint16(const quint8* rawData);
+  static qint32 getSint32(const quint8* rawData);
+  static qint64 getSint64(const quint8* rawData);
+  static qreal getFloat32(const quint8* rawData);
+  static qreal getFloat64(const quint8* rawData);
 };
 
 #endif  // CFITBYTEDATATRANSFORMER_H
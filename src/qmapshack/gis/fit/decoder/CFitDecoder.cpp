@@ -18,44 +18,153 @@
 
 #include "gis/fit/decoder/CFitDecoder.h"
 
-#include "gis/fit/decoder/CFitCrcState.h"
-#include "gis/fit/decoder/CFitDevFieldDefinitionState.h"
-#include "gis/fit/decoder/CFitFieldDataState.h"
-#include "gis/fit/decoder/CFitFieldDefinitionState.h"
-#include "gis/fit/decoder/CFitHeaderState.h"
-#include "gis/fit/decoder/CFitRecordContentState.h"
-#include "gis/fit/decoder/CFitRecordHeaderState.h"
+#include "gis/fit/decoder/CFitFieldBuilder.h"
+#include "gis/fit/defs/CFitBaseType.h"
+#include "gis/fit/defs/CFitProfileLookup.h"
 #include "gis/fit/defs/fit_const.h"
+#include "gis/fit/defs/fit_enums.h"
+#include "gis/fit/defs/fit_fields.h"
 
-CFitDecoder::CFitDecoder() {
-  stateMap[eDecoderStateFileHeader] = new CFitHeaderState(data);
-  stateMap[eDecoderStateRecord] = new CFitRecordHeaderState(data);
-  stateMap[eDecoderStateRecordContent] = new CFitRecordContentState(data);
-  stateMap[eDecoderStateFieldDef] = new CFitFieldDefinitionState(data);
-  stateMap[eDecoderStateDevFieldDef] = new CFitDevFieldDefinitionState(data);
-  stateMap[eDecoderStateFieldData] = new CFitFieldDataState(data);
-  stateMap[eDecoderStateFileCrc] = new CFitCrcState(data);
+/**
+ * file header
+ * 0: the header size (12 or 14)
+ * 1: protocol version
+ * 2: profil version LSB
+ * 3: profil version MSB
+ * 4: data size LSB
+ * 5: data size
+ * 6: data size
+ * 7: data size
+ * 8: "."
+ * 9: "F"
+ * 10: "I"
+ * 11: "T"
+ * 12: CRC LSB (optional)
+ * 13: CRC MSB (optional)
+ */
+static const quint8 fitHeaderSizeMin = 12;
+static const quint8 fitProtocolVersionMajor = 2;
+static const quint8 fitProtocolMajorVersionShift = 4;
+static const quint8 fitProtocolMajorVersionMask = 0x0F << fitProtocolMajorVersionShift;
+
+/*
+ * normal header
+ * bit: value description
+ * 7: 0 normal Header
+ * 6: 0/1 data message / definition message
+ * 5: 0/1 developer data flag
+ * 4: - reserved
+ * 3: 0/1 local message type (0-15 -> 0000 - 1111)
+ * 2:     local message type
+ * 1:     local message type
+ * 0:     local message type
+ */
+static const quint8 fitRecordHeaderDefBit = ((quint8)0x40);    // bit 6: 0100 0000
+static const quint8 fitRecordHeaderDevBit = ((quint8)0x20);    // bit 5: 0010 0000
+static const quint8 fitRecordHeaderMesgMask = ((quint8)0x0F);  // bit 0-3: 0000 1111
+
+/*
+ * compressed timestamp header
+ * bit: value description
+ * 7: 1 compressed timestamp header
+ * 6: 0/1 local message type
+ * 5:     local message type
+ * 4: 0/1 time offset (seconds) (0-31 -> 0 0000-1 1111)
+ * 3:     time offset
+ * 2:     time offset
+ * 1:     time offset
+ * 0:     time offset
+ */
+static const quint8 fitRecordHeaderTypeBit = ((quint8)0x80);       // bit 7: 1000 0000
+static const quint8 fitRecordHeaderTimeMesgMask = ((quint8)0x60);  // bit 5-6: 0110 0000
+static const quint8 fitRecordHeaderTimeMesgShift = 5;
+static const quint8 fitRecordHeaderTimeOffsetMask = 0x1F;  // bit 0-4: 0001 1111
+
+/**
+ * definition message content (without field definitions)
+ * 0: reserved
+ * 1: architecture (0 little, 1 big endian)
+ * 2: global message number
+ * 3: global message number
+ * 4: number of fields in the data message
+ *
+ * followed by 3 bytes per field definition:
+ * 0: field definition number
+ * 1: size in bytes of field data
+ * 2: base type
+ *
+ * if developer flag set, followed by the number of developer fields and 3 bytes per developer field:
+ * 0: field number
+ * 1: size in bytes of field data
+ * 2: developer data index (maps to developer data id message)
+ */
+static const quint8 fitDefinitionContentSize = 5;
+static const quint8 fitFieldDefinitionSize = 3;
+
+static quint16 fitCrc(const quint8* data, quint32 size) {
+  static const quint16 crc_table[16] = {0x0000, 0xCC01, 0xD801, 0x1400, 0xF001, 0x3C00, 0x2800, 0xE401,
+                                        0xA001, 0x6C00, 0x7800, 0xB401, 0x5000, 0x9C01, 0x8801, 0x4400};
+  quint16 crc = 0;
+  for (quint32 i = 0; i < size; i++) {
+    const quint8 byte = data[i];
+    // compute checksum of lower four bits of byte
+    quint16 tmp = crc_table[crc & 0xF];
+    crc = (crc >> 4) & 0x0FFF;
+    crc = crc ^ tmp ^ crc_table[byte & 0xF];
+    // now compute checksum of upper four bits of byte
+    tmp = crc_table[crc & 0xF];
+    crc = (crc >> 4) & 0x0FFF;
+    crc = crc ^ tmp ^ crc_table[(byte >> 4) & 0xF];
+  }
+  return crc;
 }
 
-CFitDecoder::~CFitDecoder() {
-  qDeleteAll(stateMap);
-  stateMap.clear();
+/// @return The record column a field of a record message is decoded to or -1 if the field is not used.
+static qint32 recordColumn(quint8 fieldDefNr) {
+  switch (fieldDefNr) {
+    case eRecordTimestamp:
+      return CFitRecordColumns::eColumnTimestamp;
+
+    case eRecordPositionLat:
+      return CFitRecordColumns::eColumnPositionLat;
+
+    case eRecordPositionLong:
+      return CFitRecordColumns::eColumnPositionLong;
+
+    case eRecordEnhancedAltitude:
+      return CFitRecordColumns::eColumnEnhancedAltitude;
+
+    case eRecordSpeed:
+      return CFitRecordColumns::eColumnSpeed;
+
+    case eRecordHeartRate:
+      return CFitRecordColumns::eColumnHeartRate;
 
-  data.messages.clear();
+    case eRecordCadence:
+      return CFitRecordColumns::eColumnCadence;
+
+    case eRecordPower:
+      return CFitRecordColumns::eColumnPower;
+
+    case eRecordTemperature:
+      return CFitRecordColumns::eColumnTemperature;
+
+    default:
+      return -1;
+  }
 }
 
-void CFitDecoder::resetSharedData() {
-  data.definitions = QMap<quint8, CFitDefinitionMessage>();
-  data.definitionHistory = QList<CFitDefinitionMessage>();
-  data.messages = QList<CFitMessage>();
-  data.devFieldProfiles = QList<CFitFieldProfile>();
-  data.lastDefinition = nullptr;
-  data.lastMessage = nullptr;
-  data.timestamp = 0;
-  data.lastTimeOffset = 0;
-  data.fileBytesRead = 0;
-  data.fileLength = 0;
-  data.crc = 0;
+void CFitDecoder::reset() {
+  timestamp = 0;
+  lastTimeOffset = 0;
+  for (quint8 i = 0; i < maxLocalMesgNr; i++) {
+    definitions[i] = CFitDefinitionMessage();
+    layouts[i] = layout_t();
+  }
+  definitionHistory.clear();
+  messages.clear();
+  devFieldProfiles.clear();
+  records.clear();
 }
 
 void printDefinitions(const QList<CFitDefinitionMessage>& defs) {
@@ -66,7 +175,7 @@ void printDefinitions(const QList<CFitDefinitionMessage>& defs) {
   }
 }
 
-void printMessages(const QList<CFitMessage>& messages) {
+void printMessages(const QVector<CFitMessage>& messages) {
   for (int i = 0; i < messages.size(); i++) {
     for (QString& s : messages[i].messageInfo()) {
       qDebug() << s;
@@ -74,45 +183,504 @@ void printMessages(const QList<CFitMessage>& messages) {
   }
 }
 
-void CFitDecoder::printDebugInfo(){FITDEBUG(1, printDefinitions(data.definitionHistory))
-                                       FITDEBUG(1, printMessages(data.messages))}
+void CFitDecoder::printDebugInfo(){FITDEBUG(1, printDefinitions(definitionHistory))
+                                       FITDEBUG(1, printMessages(messages))}
 
-QList<QString> decoderStateNames = {
-    "File Header", "Record", "Record Content", "Field Definition", "Development Field Definition", "Field Data",
-    "CRC",         "End"};
+void CFitDecoder::decode(QFile& file) {
+  // map the file into memory. If this is not possible read it as a whole. Either way the decoder
+  // parses complete records from memory and field data is never copied.
+  const qint64 size = file.size();
+  uchar* mapped = file.map(0, size);
+  QByteArray buffer;
+  if (mapped == nullptr) {
+    file.seek(0);
+    buffer = file.readAll();
+  }
 
-void printByte(QFile& file, decode_state_e state, quint8 dataByte) {
-  FITDEBUG(3, qDebug() << QString("decoding byte %1 - %2 - %3")
-                              .arg(file.pos(), 6, 10, QLatin1Char(' '))
-                              .arg(dataByte, 8, 2, QLatin1Char('0'))
-                              .arg(decoderStateNames.at(state)));
+  try {
+    if (mapped != nullptr) {
+      decode(mapped, size, file.fileName());
+    } else {
+      decode((const quint8*)buffer.constData(), buffer.size(), file.fileName());
+    }
+  } catch (QString& errormsg) {
+    if (mapped != nullptr) {
+      file.unmap(mapped);
+    }
+    throw errormsg;
+  }
+
+  if (mapped != nullptr) {
+    file.unmap(mapped);
+  }
 }
 
-void CFitDecoder::decode(QFile& file) {
-  resetSharedData();
-
-  file.seek(0);
-
-  quint8 dataByte;
-  decode_state_e state = eDecoderStateFileHeader;
-  while (!file.atEnd()) {
-    file.getChar((char*)&dataByte);
-    try {
-      printByte(file, state, dataByte);
-      state = stateMap[state]->processByte(dataByte);
-      if (state == eDecoderStateEnd) {
-        // end of file, everything ok
-        printDebugInfo();
-        return;
+void CFitDecoder::decode(const quint8* data, quint32 size, const QString& filename) {
+  this->filename = filename;
+  reset();
+
+  try {
+    if ((size == 0) || (size < data[0])) {
+      throw tr("FIT decoding error: unexpected end of file %1.").arg(filename);
+    }
+
+    const quint8 headerLength = data[0];
+    if (headerLength < fitHeaderSizeMin) {
+      throw tr("FIT decoding error: file header signature mismatch. File is not FIT.");
+    }
+    if ((data[1] & fitProtocolMajorVersionMask) > (fitProtocolVersionMajor << fitProtocolMajorVersionShift)) {
+      throw tr("FIT decoding error: protocol %1 version not supported.").arg(data[1] & fitProtocolMajorVersionMask);
+    }
+    if ((data[8] != '.') || (data[9] != 'F') || (data[10] != 'I') || (data[11] != 'T')) {
+      throw tr("FIT decoding error: file header signature mismatch. File is not FIT.");
+    }
+
+    const quint32 dataSize = (quint32)data[4] | ((quint32)data[5] << 8) | ((quint32)data[6] << 16) |
+                             ((quint32)data[7] << 24);
+    // header, data and 2 bytes crc
+    if (quint64(headerLength) + dataSize + 2 > size) {
+      throw tr("FIT decoding error: unexpected end of file %1.").arg(filename);
+    }
+
+    // the crc over everything including the crc itself is 0
+    if (fitCrc(data, headerLength + dataSize + 2) != 0) {
+      throw tr("FIT decoding error : invalid CRC.");
+    }
+
+    const quint8* pos = data + headerLength;
+    const quint8* end = pos + dataSize;
+    while (pos < end) {
+      const quint8 recordHeader = *pos++;
+      if ((recordHeader & fitRecordHeaderTypeBit) != 0) {
+        // this is a compressed timestamp header
+        setTimestampOffset(recordHeader);
+        const quint8 localMesgNr = (recordHeader & fitRecordHeaderTimeMesgMask) >> fitRecordHeaderTimeMesgShift;
+        pos = decodeData(localMesgNr, true, pos, end);
+      } else if ((recordHeader & fitRecordHeaderDefBit) != 0) {
+        // this is a definition message
+        const bool developerDataFlag = (recordHeader & fitRecordHeaderDevBit) != 0;
+        pos = decodeDefinition(recordHeader & fitRecordHeaderMesgMask, developerDataFlag, pos, end);
+      } else {
+        // this is a data message
+        pos = decodeData(recordHeader & fitRecordHeaderMesgMask, false, pos, end);
       }
-    } catch (QString& errormsg) {
-      printDebugInfo();
-      throw errormsg;
     }
+  } catch (QString& errormsg) {
+    printDebugInfo();
+    throw errormsg;
   }
-  // unexpected end of file
+
   printDebugInfo();
-  throw tr("FIT decoding error: unexpected end of file %1.").arg(file.fileName());
 }
 
-const QList<CFitMessage>& CFitDecoder::getMessages() const { return data.messages; }
+const quint8* CFitDecoder::decodeDefinition(quint8 localMesgNr, bool devFlag, const quint8* pos, const quint8* end) {
+  if (end - pos < fitDefinitionContentSize) {
+    throw tr("FIT decoding error: unexpected end of file %1.").arg(filename);
+  }
+
+  const quint8 architecture = pos[1];
+  if ((architecture != eFitArchEndianLittle) && (architecture != eFitArchEndianBig)) {
+    throw tr("FIT decoding error: architecture %1 not supported.").arg(architecture);
+  }
+  quint16 globalMesgNr = pos[2] | ((quint16)pos[3] << 8);
+  if (architecture == eFitArchEndianBig) {
+    globalMesgNr = (globalMesgNr >> 8) | ((globalMesgNr & 0xFF) << 8);
+  }
+  const quint8 nrOfFields = pos[4];
+  pos += fitDefinitionContentSize;
+
+  definitions[localMesgNr] = CFitDefinitionMessage(localMesgNr, devFlag);
+  CFitDefinitionMessage& def = definitions[localMesgNr];
+  def.setArchiteture(architecture);
+  def.setGlobalMesgNr(globalMesgNr);
+  def.setNrOfFields(nrOfFields);
+
+  if (end - pos < nrOfFields * fitFieldDefinitionSize + (devFlag ? 1 : 0)) {
+    throw tr("FIT decoding error: unexpected end of file %1.").arg(filename);
+  }
+  for (quint8 i = 0; i < nrOfFields; i++, pos += fitFieldDefinitionSize) {
+    def.addField(CFitFieldDefinition(&def, pos[0], pos[1], pos[2]));
+  }
+
+  if (devFlag) {
+    const quint8 nrOfDevFields = *pos++;
+    def.setNrOfDevFields(nrOfDevFields);
+    if (end - pos < nrOfDevFields * fitFieldDefinitionSize) {
+      throw tr("FIT decoding error: unexpected end of file %1.").arg(filename);
+    }
+    for (quint8 i = 0; i < nrOfDevFields; i++, pos += fitFieldDefinitionSize) {
+      const quint8 fieldNr = pos[0];
+      const quint8 size = pos[1];
+      const quint8 devDataIndex = pos[2];
+      CFitFieldProfile* profile = devFieldProfile(qMakePair(devDataIndex, fieldNr));
+      def.addDevField(
+          CFitFieldDefinition(&def, profile, fieldNr, devDataIndex, size, profile->getBaseType().baseTypeField()));
+    }
+  }
+
+  FITDEBUG(2, qDebug() << def.messageInfo())
+  definitionHistory.append(def);
+  compileLayout(def, layouts[localMesgNr]);
+  return pos;
+}
+
+void CFitDecoder::compileLayout(const CFitDefinitionMessage& def, layout_t& layout) const {
+  layout = layout_t();
+  for (const CFitFieldDefinition& fieldDef : def.getFields()) {
+    layout.size += fieldDef.getSize();
+  }
+  for (const CFitFieldDefinition& fieldDef : def.getDevFields()) {
+    layout.size += fieldDef.getSize();
+  }
+
+  layout.isRecord = def.getGlobalMesgNr() == eMesgNumRecord;
+  if (!layout.isRecord) {
+    return;
+  }
+
+  QVector<column_op_t> components;
+  quint16 offset = 0;
+  for (const CFitFieldDefinition& fieldDef : def.getFields()) {
+    const CFitBaseType& baseType = fieldDef.getBaseType();
+    const quint8 size = fieldDef.getSize();
+    // arrays are never valid and only integers and bytes are used by the columns
+    const bool isUsable = baseType.isSizeUndefined() ? (baseType.isByte() && (size > 0) && (size <= sizeof(quint64)))
+                                                     : (baseType.isInteger() && (size == baseType.size()));
+    if (isUsable) {
+      const CFitFieldProfile& profile = fieldDef.profile();
+
+      column_op_t op;
+      op.offset = offset;
+      op.size = size;
+      op.baseType = &baseType;
+      op.swap = fieldDef.getEndianAbilityFlag() && (def.getArchitectureBit() != eFitArchEndianLittle);
+
+      qint32 column = recordColumn(fieldDef.getDefNr());
+      if (column != -1) {
+        column_op_t fieldOp = op;
+        fieldOp.column = CFitRecordColumns::column_e(column);
+        fieldOp.isSigned = baseType.isSignedInt();
+        fieldOp.scale = profile.getScale();
+        fieldOp.valueOffset = profile.getOffset();
+        layout.ops << fieldOp;
+      }
+
+      if (profile.hasComponents()) {
+        quint8 shift = 0;
+        for (const CFitComponentfieldProfile* component : profile.getComponents()) {
+          column = recordColumn(component->getFieldDefNum());
+          if (column != -1) {
+            column_op_t componentOp = op;
+            componentOp.column = CFitRecordColumns::column_e(column);
+            componentOp.shift = shift;
+            componentOp.mask = component->getBitmask();
+            componentOp.scale = component->getScale();
+            componentOp.valueOffset = component->getOffset();
+            components << componentOp;
+          }
+          shift += component->getBits();
+        }
+      }
+    }
+    offset += fieldDef.getSize();
+  }
+
+  // a field takes precedence over the same value expanded from another field
+  for (const column_op_t& componentOp : qAsConst(components)) {
+    bool hasColumn = false;
+    for (const column_op_t& op : qAsConst(layout.ops)) {
+      hasColumn |= op.column == componentOp.column;
+    }
+    if (!hasColumn) {
+      layout.ops << componentOp;
+    }
+  }
+}
+
+const quint8* CFitDecoder::decodeData(quint8 localMesgNr, bool compressedTimestamp, const quint8* pos,
+                                      const quint8* end) {
+  const CFitDefinitionMessage& def = definitions[localMesgNr];
+  const layout_t& layout = layouts[localMesgNr];
+  if (quint32(end - pos) < layout.size) {
+    throw tr("FIT decoding error: unexpected end of file %1.").arg(filename);
+  }
+
+  if (layout.isRecord) {
+    const qint32 row = records.append();
+    messages.append(CFitMessage(def, row));
+    decodeRecord(layout, row, pos);
+    if (compressedTimestamp) {
+      records.timestamp[row] = timestamp;
+    }
+    return pos + layout.size;
+  }
+
+  messages.append(CFitMessage(def));
+  CFitMessage& mesg = messages.last();
+
+  if (compressedTimestamp) {
+    // remark on enum for timestamp (RecordTimestamp):
+    // the timestamp field has for all message types the same number (253) therefore it does not matter which
+    // enum is taken here.
+    const CFitFieldProfile* profile = CFitProfileLookup::getFieldForProfile(def.getGlobalMesgNr(), eRecordTimestamp);
+    CFitField timeField = CFitField(def.getGlobalMesgNr(), eRecordTimestamp, profile, QVariant(timestamp), true);
+    mesg.addField(timeField);
+  }
+
+  const quint8* fieldData = pos;
+  for (const CFitFieldDefinition& fieldDef : def.getFields()) {
+    CFitField f = CFitFieldBuilder::buildField(fieldDef, fieldData, mesg);
+    mesg.addField(f);
+
+    // The special case time record.
+    // timestamp has always the same value for all enums. it does not matter against which we're comparing.
+    if (fieldDef.getDefNr() == eRecordTimestamp) {
+      setTimestamp(f.getValue().toUInt());
+    }
+    fieldData += fieldDef.getSize();
+  }
+
+  for (const CFitFieldDefinition& fieldDef : def.getDevFields()) {
+    // handling developer data for mapping the field data to its definitions:
+    // part 2, reading field data and attach dynamic profile
+    CFitFieldProfile* fieldProfile = devFieldProfile(fieldDef.getDevProfileId());
+    if (fieldProfile->getBaseType().nr() == eBaseTypeNrInvalid) {
+      // test if profile exists
+      throw tr("Missing field definition for development field.");
+    }
+
+    CFitField f = CFitFieldBuilder::buildField(*fieldProfile, fieldDef, fieldData, mesg);
+    mesg.addField(f);
+    fieldData += fieldDef.getSize();
+  }
+
+  // Now that the entire message is decoded we may evaluate subfields and expand components
+  CFitFieldBuilder::evaluateSubfieldsAndExpandComponents(mesg);
+
+  devProfile(mesg);
+
+  FITDEBUG(2, qDebug() << mesg.messageInfo())
+  return pos + layout.size;
+}
+
+void CFitDecoder::decodeRecord(const layout_t& layout, qint32 row, const quint8* pos) {
+  for (const column_op_t& op : layout.ops) {
+    const quint8* fieldData = pos + op.offset;
+
+    quint8 swapped[sizeof(quint64)];
+    if (op.swap) {
+      for (quint8 i = 0; i < op.size; i++) {
+        swapped[i] = fieldData[op.size - i - 1];
+      }
+      fieldData = swapped;
+    }
+
+    quint64 raw = 0;
+    for (quint8 i = op.size; i > 0; i--) {
+      raw = (raw << 8) | fieldData[i - 1];
+    }
+
+    if (op.column == CFitRecordColumns::eColumnTimestamp) {
+      setTimestamp(quint32(raw));
+    }
+
+    if (!CFitFieldBuilder::isValueValid(*op.baseType, op.size, fieldData)) {
+      continue;
+    }
+
+    qreal value;
+    if (op.isSigned) {
+      // sign extend the field
+      const quint8 unusedBits = 64 - 8 * op.size;
+      value = qint64(raw << unusedBits) >> unusedBits;
+    } else {
+      value = (raw >> op.shift) & op.mask;
+    }
+
+    if ((op.scale != 0) || (op.valueOffset != 0)) {
+      value = value / op.scale - op.valueOffset;
+    }
+
+    records.setValue(op.column, row, value);
+  }
+}
+
+void CFitDecoder::setTimestamp(quint32 fullTimestamp) {
+  timestamp = fullTimestamp;
+  lastTimeOffset = (quint8)(timestamp & fitRecordHeaderTimeOffsetMask);
+}
+
+void CFitDecoder::setTimestampOffset(quint32 offsetTimestamp) {
+  quint8 timeOffset = offsetTimestamp & fitRecordHeaderTimeOffsetMask;
+  timestamp += (timeOffset - lastTimeOffset) & fitRecordHeaderTimeOffsetMask;
+  lastTimeOffset = timeOffset;
+}
+
+void CFitDecoder::devProfile(const CFitMessage& mesg) {
+  // handling developer data for mapping the field data to its definitions:
+  // part 1, dynamic profiles creation
+  if (mesg.getGlobalMesgNr() == eMesgNumDeveloperDataId) {
+    // Get developer ID
+    quint8 devDataIdx = fitDevDataIndexInvalid;
+    const QList<CFitField>& fields = mesg.getFields();
+    for (const CFitField& field : fields) {
+      if (field.isValidValue() && field.getFieldDefNr() == eDeveloperDataIdDeveloperDataIndex) {
+        devDataIdx = (quint8)field.getValue().toUInt();
+        break;
+      }
+    }
+    // Delete all developer field profiles for this ID
+    if (devDataIdx != fitDevDataIndexInvalid) {
+      clearDevFieldProfiles(devDataIdx);
+    }
+  }
+  if (mesg.getGlobalMesgNr() == eMesgNumFieldDescription) {
+    CFitFieldProfile devFieldProfile = buildDevFieldProfile(mesg);
+    FITDEBUG(2, qDebug() << devFieldProfile.fieldProfileInfo());
+    addDevFieldProfile(devFieldProfile);
+  }
+}
+
+CFitFieldProfile CFitDecoder::buildDevFieldProfile(const CFitMessage& mesg) {
+  QString fieldName;
+  quint8 fieldDefNr = 0;
+  quint8 devDataIdx = 0;
+  quint8 baseType = eBaseTypeNrInvalid;
+  qreal scale = 0;
+  quint8 array = 0;
+  QString components;
+  qint16 offset = 0;
+  QString units;
+  QString bits;
+  QString accumulate;
+  quint8 baseUnitId = 0;
+  quint8 natvieMesgNum = 0;
+  quint8 nativeFieldNum = 0;
+
+  const QList<CFitField>& fields = mesg.getFields();
+  for (const CFitField& field : fields) {
+    if (field.isValidValue()) {
+      switch (field.getFieldDefNr()) {
+        case eFieldDescriptionDeveloperDataIndex:
+          devDataIdx = (quint8)field.getValue().toUInt();
+          break;
+
+        case eFieldDescriptionFieldDefinitionNumber:
+          fieldDefNr = (quint8)field.getValue().toUInt();
+          break;
+
+        case eFieldDescriptionFitBaseTypeId:
+          baseType = (quint8)field.getValue().toUInt();  // enum
+          break;
+
+        case eFieldDescriptionFieldName:
+          fieldName = field.getValue().toString();
+          break;
+
+        case eFieldDescriptionArray:
+          array = (quint8)field.getValue().toUInt();
+          break;
+
+        case eFieldDescriptionComponents:
+          components = field.getValue().toString();
+          break;
+
+        case eFieldDescriptionScale:
+          scale = (qreal)field.getValue().toDouble();
+          break;
+
+        case eFieldDescriptionOffset:
+          offset = (qint16)field.getValue().toInt();
+          break;
+
+        case eFieldDescriptionUnits:
+          units = field.getValue().toString();
+          break;
+
+        case eFieldDescriptionBits:
+          bits = field.getValue().toString();
+          break;
+
+        case eFieldDescriptionAccumulate:
+          accumulate = field.getValue().toString();
+          break;
+
+        case eFieldDescriptionFitBaseUnitId:
+          baseUnitId = (quint8)field.getValue().toUInt();  // enum
+          break;
+
+        case eFieldDescriptionNativeMesgNum:
+          natvieMesgNum = (quint8)field.getValue().toUInt();  // enum
+          break;
+
+        case eFieldDescriptionNativeFieldNum:
+          nativeFieldNum = (quint8)field.getValue().toUInt();
+          break;
+
+        default:
+          throw tr("FIT decoding error: invalid field def nr %1 while creating dev field profile.")
+              .arg(field.getFieldDefNr());
+          break;
+      }
+    }
+  }
+
+  Q_UNUSED(array)
+  Q_UNUSED(baseUnitId)
+
+  if (natvieMesgNum && nativeFieldNum) {
+    const CFitFieldProfile* nativeFieldProfile = CFitProfileLookup::getFieldForProfile(natvieMesgNum, nativeFieldNum);
+    if (nativeFieldProfile->getBaseType().nr() == eBaseTypeNrInvalid) {
+      qWarning() << "DEV field" << fieldName << " field profile for mesg num" << natvieMesgNum << "and field num"
+                 << nativeFieldNum << "does not exist.";
+    }
+    if (nativeFieldProfile->getUnits() != units) {
+      qWarning() << "DEV field" << fieldName << "units" << units << " do not match existing profile units"
+                 << nativeFieldProfile->getUnits();
+    }
+    // scale and offset not allowed if a fit field is overwritten.
+    scale = 0;
+    offset = 0;
+  }
+
+  CFitFieldProfile devFieldProfile = CFitFieldProfile(nullptr, fieldName, *CFitBaseTypeMap::get(baseType), fieldDefNr,
+                                                      devDataIdx, scale, offset, units, eFieldTypeDevelopment);
+  // for documentation: the development field profile may contain more fields in the future as can be adumbrated by
+  // the description field enumeration. According to the FIT specification Rev 2.3  table 4-9 - Field Description
+  // Messages those fields are not yet used.
+
+  return devFieldProfile;
+}
+
+void CFitDecoder::addDevFieldProfile(const CFitFieldProfile& fieldProfile) {
+  // for documentation: a development field definition is linked to an developer data ID. The tuple developer data index
+  // and field definition number must be unique.
+  if (devFieldProfile(fieldProfile.getDevProfileId())->getDevProfileId() == fieldProfile.getDevProfileId()) {
+    throw tr("FIT decoding error: a development field with the field_definition_number %1 already exists.")
+        .arg(fieldProfile.getFieldDefNum());
+  }
+  devFieldProfiles.append(fieldProfile);
+}
+
+CFitFieldProfile* CFitDecoder::devFieldProfile(const QPair<quint8, quint8>& devProfileId) {
+  for (CFitFieldProfile& devFieldPro : devFieldProfiles) {
+    if (devProfileId == devFieldPro.getDevProfileId()) {
+      return &devFieldPro;
+    }
+  }
+  // dummy field for unknown field nr.
+  static CFitFieldProfile dummyFieldProfile;
+  return &dummyFieldProfile;
+
+  // return devFieldProfiles[fieldNr];
+}
+
+void CFitDecoder::clearDevFieldProfiles(quint8 devDataIdx) {
+  for (QList<CFitFieldProfile>::iterator it = devFieldProfiles.begin(); it != devFieldProfiles.end();) {
+    if (it->getDevDataIdx() == devDataIdx) {
+      it = devFieldProfiles.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
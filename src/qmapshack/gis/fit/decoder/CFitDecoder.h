@@ -21,28 +21,99 @@
 
 #include <QtCore>
 
-#include "gis/fit/decoder/IFitDecoderState.h"
+#include "gis/fit/decoder/CFitDefinitionMessage.h"
+#include "gis/fit/decoder/CFitMessage.h"
+#include "gis/fit/decoder/CFitRecordColumns.h"
+#include "gis/fit/defs/CFitFieldProfile.h"
 
-class CFitMessage;
+class CFitBaseType;
 
+/**
+   @brief Decode a FIT file into messages
+
+   The file is mapped into memory (or read as a whole if mapping fails) and decoded one record
+   at a time. The layout of each data message is compiled once, when its definition message is
+   read. Record messages are decoded straight into CFitRecordColumns. All other messages are
+   decoded into a CFitMessage with all fields.
+ */
 class CFitDecoder final {
   Q_DECLARE_TR_FUNCTIONS(CFitDecoder)
  public:
-  CFitDecoder();
-  ~CFitDecoder();
+  CFitDecoder() = default;
+  ~CFitDecoder() = default;
+
+  /**
+     @brief Decode a FIT file
 
+     @param file  the file, already opened for reading
+     @throw QString in case of a decoding failure
+   */
   void decode(QFile& file);
-  const QList<CFitMessage>& getMessages() const;
+  /**
+     @brief Decode FIT data already in memory
+
+     @param data      the complete FIT file
+     @param size      the size of data in bytes
+     @param filename  the name of the file used in error messages
+     @throw QString in case of a decoding failure
+   */
+  void decode(const quint8* data, quint32 size, const QString& filename);
+
+  const QVector<CFitMessage>& getMessages() const { return messages; }
+  const CFitRecordColumns& getRecords() const { return records; }
 
  private:
-  void resetSharedData();
+  /// a value of a record message that is written to a column
+  struct column_op_t {
+    CFitRecordColumns::column_e column = CFitRecordColumns::eColumnCount;
+    quint16 offset = 0;  //< offset of the field in the data message
+    quint8 size = 0;     //< size of the field in bytes
+    const CFitBaseType* baseType = nullptr;
+    bool swap = false;      //< the field is big endian
+    bool isSigned = false;  //< sign extend the field, never set for components
+    quint8 shift = 0;       //< bit offset of a component in the field
+    quint64 mask = ~quint64(0);
+    qreal scale = 0;
+    qreal valueOffset = 0;
+  };
+
+  /// the layout of a data message, compiled from its definition message
+  struct layout_t {
+    quint32 size = 0;       //< size of the data message in bytes
+    bool isRecord = false;  //< decode the data message into the record columns
+    QVector<column_op_t> ops;
+  };
+
+  static constexpr quint8 maxLocalMesgNr = 16;
+
+  void reset();
   void printDebugInfo();
 
-  // map containing all states for the decoder. Needs to be pointer because decoder state is abstract class
-  QMap<decode_state_e, IFitDecoderState*> stateMap;
+  const quint8* decodeDefinition(quint8 localMesgNr, bool devFlag, const quint8* pos, const quint8* end);
+  const quint8* decodeData(quint8 localMesgNr, bool compressedTimestamp, const quint8* pos, const quint8* end);
+  void decodeRecord(const layout_t& layout, qint32 row, const quint8* pos);
+  void compileLayout(const CFitDefinitionMessage& def, layout_t& layout) const;
+
+  void setTimestamp(quint32 fullTimestamp);
+  void setTimestampOffset(quint32 offsetTimestamp);
+
+  void devProfile(const CFitMessage& mesg);
+  CFitFieldProfile buildDevFieldProfile(const CFitMessage& mesg);
+  void addDevFieldProfile(const CFitFieldProfile& fieldProfile);
+  CFitFieldProfile* devFieldProfile(const QPair<quint8, quint8>& devProfileId);
+  /// Delete local developer profiles with the developer data index devDataIdx
+  void clearDevFieldProfiles(quint8 devDataIdx);
+
+  QString filename;
+  quint32 timestamp = 0;
+  quint8 lastTimeOffset = 0;
 
-  // shared data passed along the decoder state instances.
-  IFitDecoderState::shared_state_data_t data;
+  CFitDefinitionMessage definitions[maxLocalMesgNr];
+  layout_t layouts[maxLocalMesgNr];
+  QList<CFitDefinitionMessage> definitionHistory;
+  QVector<CFitMessage> messages;
+  QList<CFitFieldProfile> devFieldProfiles;
+  CFitRecordColumns records;
 };
 
 #endif  // CFITDECODER_H
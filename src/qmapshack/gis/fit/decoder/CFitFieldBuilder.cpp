@@ -19,12 +19,14 @@
 #include "gis/fit/decoder/CFitFieldBuilder.h"
 
 #include "gis/fit/decoder/CFitByteDataTransformer.h"
+#include "gis/fit/decoder/CFitDefinitionMessage.h"
 #include "gis/fit/decoder/CFitField.h"
 #include "gis/fit/decoder/CFitFieldDefinition.h"
 #include "gis/fit/decoder/CFitMessage.h"
 #include "gis/fit/defs/CFitBaseType.h"
 #include "gis/fit/defs/CFitFieldProfile.h"
 #include "gis/fit/defs/CFitProfileLookup.h"
+#include "gis/fit/defs/fit_const.h"
 
 void CFitFieldBuilder::evaluateSubfieldsAndExpandComponents(CFitMessage& mesg) {
   const QList<CFitField>& fields = mesg.getFields();
@@ -36,15 +38,22 @@ void CFitFieldBuilder::evaluateSubfieldsAndExpandComponents(CFitMessage& mesg) {
   }
 }
 
-CFitField CFitFieldBuilder::buildField(const CFitFieldDefinition& def, quint8* fieldData, const CFitMessage& message) {
+CFitField CFitFieldBuilder::buildField(const CFitFieldDefinition& def, const quint8* fieldData,
+                                       const CFitMessage& message) {
   const CFitFieldProfile* fieldProfile =
       CFitProfileLookup::getFieldForProfile(message.getGlobalMesgNr(), def.getDefNr());
   return buildField(*fieldProfile, def, fieldData, message);
 }
 
 CFitField CFitFieldBuilder::buildField(const CFitFieldProfile& fieldProfile, const CFitFieldDefinition& def,
-                                       quint8* fieldData, const CFitMessage& /*message*/) {
-  CFitByteDataTransformer::swapFieldData(def, fieldData);
+                                       const quint8* fieldData, const CFitMessage& /*message*/) {
+  // the field data points into the file buffer, swap a copy only
+  quint8 swapped[fitMaxFieldSize];
+  if (def.getEndianAbilityFlag() && (def.parent().getArchitectureBit() != eFitArchEndianLittle)) {
+    memcpy(swapped, fieldData, def.getSize());
+    CFitByteDataTransformer::swapFieldData(def, swapped);
+    fieldData = swapped;
+  }
   const CFitBaseType& baseType = def.getBaseType();
 
   QVariant value;
@@ -62,25 +71,24 @@ CFitField CFitFieldBuilder::buildField(const CFitFieldProfile& fieldProfile, con
     // should not be possible
     throw tr("FIT decoding error: unknown base type %1.").arg(baseType.nr());
   }
-  bool valid = isValueValid(def, fieldData);
+  bool valid = isValueValid(baseType, def.getSize(), fieldData);
   return CFitField(def, &fieldProfile, value, valid);
 }
 
-bool CFitFieldBuilder::isValueValid(const CFitFieldDefinition& def, quint8* fieldData) {
-  const CFitBaseType& baseType = def.getBaseType();
+bool CFitFieldBuilder::isValueValid(const CFitBaseType& baseType, quint8 size, const quint8* fieldData) {
   const quint8* invalidBytes = baseType.invalidValueBytes();
   quint8 invalidCount = 0;
 
-  if (!baseType.isSizeUndefined() && def.getSize() != baseType.size()) {
+  if (!baseType.isSizeUndefined() && size != baseType.size()) {
     return false;
   }
-  for (quint8 i = 0; i < def.getSize(); i++) {
+  for (quint8 i = 0; i < size; i++) {
     quint8 b = baseType.isSizeUndefined() ? invalidBytes[0] : invalidBytes[i];
     if (fieldData[i] == b) {
       invalidCount++;
     }
   }
-  return invalidCount < def.getSize();
+  return invalidCount < size;
 }
 
 void CFitFieldBuilder::evaluateFieldProfile(CFitMessage& mesg, const CFitField& field) {
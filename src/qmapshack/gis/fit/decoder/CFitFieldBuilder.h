@@ -25,18 +25,27 @@ class CFitField;
 class CFitMessage;
 class CFitFieldDefinition;
 class CFitFieldProfile;
+class CFitBaseType;
 
 class CFitFieldBuilder {
   Q_DECLARE_TR_FUNCTIONS(CFitFieldBuilder)
  public:
   CFitFieldBuilder() = delete;
   static void evaluateSubfieldsAndExpandComponents(CFitMessage& mesg);
-  static CFitField buildField(const CFitFieldDefinition& def, quint8* fieldData, const CFitMessage& message);
-  static CFitField buildField(const CFitFieldProfile& fieldProfile, const CFitFieldDefinition& def, quint8* fieldData,
-                              const CFitMessage& message);
+  static CFitField buildField(const CFitFieldDefinition& def, const quint8* fieldData, const CFitMessage& message);
+  static CFitField buildField(const CFitFieldProfile& fieldProfile, const CFitFieldDefinition& def,
+                              const quint8* fieldData, const CFitMessage& message);
+  /**
+     @brief Test the raw field data against the invalid value of the base type
+
+     @param baseType    the base type of the field
+     @param size        the size of the field in bytes
+     @param fieldData   the field data in little endian
+     @return False if all bytes are invalid or the size does not match the base type.
+   */
+  static bool isValueValid(const CFitBaseType& baseType, quint8 size, const quint8* fieldData);
 
  private:
-  static bool isValueValid(const CFitFieldDefinition& def, quint8* fieldData);
   static void evaluateFieldProfile(CFitMessage& mesg, const CFitField& field);
   static void expandComponents(CFitMessage& mesg, const CFitField& field);
 };
@@ -24,11 +24,12 @@
 #include "gis/fit/defs/CFitProfileLookup.h"
 #include "gis/fit/defs/fit_const.h"
 
-CFitMessage::CFitMessage(const CFitDefinitionMessage& def)
+CFitMessage::CFitMessage(const CFitDefinitionMessage& def, qint32 recordIndex)
     : fields(),
       devFields(),
       globalMesgNr(def.getGlobalMesgNr()),
       localMesgNr(def.getLocalMesgNr()),
+      recordIndex(recordIndex),
       messageProfile(CFitProfileLookup::getProfile(globalMesgNr)) {}
 
 CFitMessage::CFitMessage()
@@ -36,6 +37,7 @@ CFitMessage::CFitMessage()
       devFields(),
       globalMesgNr(fitGlobalMesgNrInvalid),
       localMesgNr(fitLocalMesgNrInvalid),
+      recordIndex(fitRecordIndexInvalid),
       messageProfile(CFitProfileLookup::getProfile(fitGlobalMesgNrInvalid)) {}
 
 bool CFitMessage::isValid() const { return getGlobalMesgNr() != fitGlobalMesgNrInvalid; }
@@ -52,6 +54,9 @@ void CFitMessage::updateFieldProfile(quint8 fieldDefNr, const CFitFieldProfile*
 QStringList CFitMessage::messageInfo() const {
   QStringList list;
   list << QString("Message %1 (%3) %4 [loc]").arg(profile().getName()).arg(getGlobalMesgNr()).arg(getLocalMesgNr());
+  if (recordIndex != fitRecordIndexInvalid) {
+    list << QString("record %1 in record columns").arg(recordIndex);
+  }
 
   for (const CFitField& field : fields) {
     list << field.fieldInfo();
@@ -22,6 +22,7 @@
 #include <QtCore>
 
 #include "gis/fit/decoder/CFitField.h"
+#include "gis/fit/defs/fit_const.h"
 
 class CFitDefinitionMessage;
 class CFitProfile;
@@ -29,12 +30,20 @@ class CFitFieldProfile;
 
 class CFitMessage final {
  public:
-  CFitMessage(const CFitDefinitionMessage& def);
+  CFitMessage(const CFitDefinitionMessage& def, qint32 recordIndex = fitRecordIndexInvalid);
   CFitMessage();
 
   bool isValid() const;
   quint16 getGlobalMesgNr() const { return globalMesgNr; }
   quint8 getLocalMesgNr() const { return localMesgNr; }
+  /**
+     @brief The row of a record message in CFitRecordColumns
+
+     Record messages carry no fields. Their values are stored in the record columns of the decoder.
+
+     @return The row or fitRecordIndexInvalid for all other messages.
+   */
+  qint32 getRecordIndex() const { return recordIndex; }
 
   bool hasField(const quint8 fieldDefNum) const;
 
@@ -52,6 +61,7 @@ class CFitMessage final {
   QMap<quint8, CFitField> devFields;
   quint16 globalMesgNr;
   quint8 localMesgNr;
+  qint32 recordIndex;
   const CFitProfile* messageProfile;
 };
 
@@ -0,0 +1,73 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "gis/fit/decoder/CFitRecordColumns.h"
+
+void CFitRecordColumns::clear() {
+  timestamp.clear();
+  positionLat.clear();
+  positionLong.clear();
+  for (QVector<qreal>& column : values) {
+    column.clear();
+  }
+}
+
+qint32 CFitRecordColumns::append() {
+  timestamp.append(fitTimestampInvalid);
+  positionLat.append(fitPositionInvalid);
+  positionLong.append(fitPositionInvalid);
+  for (qint32 column = eColumnEnhancedAltitude; column < eColumnCount; column++) {
+    values[column].append(NAN);
+  }
+  return timestamp.size() - 1;
+}
+
+qreal CFitRecordColumns::value(column_e column, qint32 row) const {
+  switch (column) {
+    case eColumnTimestamp:
+      return timestamp[row];
+
+    case eColumnPositionLat:
+      return positionLat[row];
+
+    case eColumnPositionLong:
+      return positionLong[row];
+
+    default:
+      return values[column][row];
+  }
+}
+
+void CFitRecordColumns::setValue(column_e column, qint32 row, qreal value) {
+  switch (column) {
+    case eColumnTimestamp:
+      timestamp[row] = quint32(value);
+      break;
+
+    case eColumnPositionLat:
+      positionLat[row] = qint32(value);
+      break;
+
+    case eColumnPositionLong:
+      positionLong[row] = qint32(value);
+      break;
+
+    default:
+      values[column][row] = value;
+  }
+}
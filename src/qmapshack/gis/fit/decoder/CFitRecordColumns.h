@@ -0,0 +1,71 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CFITRECORDCOLUMNS_H
+#define CFITRECORDCOLUMNS_H
+
+#include <QtCore>
+
+#include "gis/fit/defs/fit_const.h"
+
+/**
+   @brief The record messages of a FIT file decoded into typed columns
+
+   Record messages make up almost all of an activity. Instead of a CFitMessage with a map of
+   fields each, the decoder writes the values used by QMapShack straight into one array per value.
+   Row n belongs to the record message with the record index n.
+
+   Values that are missing or invalid in a record are NAN. The timestamp and the position keep
+   the invalid value of their FIT base type.
+ */
+class CFitRecordColumns final {
+ public:
+  enum column_e {
+    eColumnTimestamp,
+    eColumnPositionLat,
+    eColumnPositionLong,
+    eColumnEnhancedAltitude,
+    eColumnSpeed,
+    eColumnHeartRate,
+    eColumnCadence,
+    eColumnPower,
+    eColumnTemperature,
+    eColumnCount
+  };
+
+  qint32 size() const { return timestamp.size(); }
+
+  void clear();
+  /// append a row with all values invalid and return its index
+  qint32 append();
+
+  bool isPositionValid(qint32 row) const {
+    return positionLat[row] != fitPositionInvalid && positionLong[row] != fitPositionInvalid;
+  }
+
+  /// the value of the column at row. Timestamp and position are returned as raw integers
+  qreal value(column_e column, qint32 row) const;
+  void setValue(column_e column, qint32 row, qreal value);
+
+  QVector<quint32> timestamp;
+  QVector<qint32> positionLat;          //< [semicircles]
+  QVector<qint32> positionLong;         //< [semicircles]
+  QVector<qreal> values[eColumnCount];  //< all other columns, the ones above stay empty
+};
+
+#endif  // CFITRECORDCOLUMNS_H
@@ -37,6 +37,11 @@ static const quint8 fitLocalMesgNrInvalid = 255;
 static const quint16 fitGlobalMesgNrInvalid = 0xffff;
 static const quint8 fitFieldDefNrInvalid = 255;
 static const quint8 fitDevDataIndexInvalid = 255;
+static const qint32 fitRecordIndexInvalid = -1;
+static const quint32 fitTimestampInvalid = 0xFFFFFFFF;
+static const qint32 fitPositionInvalid = 0x7FFFFFFF;
+/// the largest possible size of a single field in bytes
+static const int fitMaxFieldSize = 255;
 
 typedef enum { eFitArchEndianLittle = 0, eFitArchEndianBig = 1 } fit_arch_e;
 
@@ -50,48 +50,44 @@ static QString dateTimeAsString(quint32 timestamp) {
 }
 
 template <typename T>
-static void readKnownExtensions(T& exts, const CFitMessage& mesg) {
+static void readKnownExtensions(T& exts, const CFitRecordColumns& records, qint32 row) {
   // see gis/trk/CKnownExtension for the keys of the extensions
-  if (mesg.isFieldValueValid(eRecordHeartRate)) {
-    exts["gpxtpx:TrackPointExtension|gpxtpx:hr"] = mesg.getFieldValue(eRecordHeartRate);
-  }
-  if (mesg.isFieldValueValid(eRecordTemperature)) {
-    exts["gpxtpx:TrackPointExtension|gpxtpx:atemp"] = mesg.getFieldValue(eRecordTemperature);
-  }
-  if (mesg.isFieldValueValid(eRecordCadence)) {
-    exts["gpxtpx:TrackPointExtension|gpxtpx:cad"] = mesg.getFieldValue(eRecordCadence);
-  }
-  if (mesg.isFieldValueValid(eRecordPower)) {
-    exts["gpxtpx:TrackPointExtension|gpxtpx:power"] = mesg.getFieldValue(eRecordPower);
-  }
-  if (mesg.isFieldValueValid(eRecordSpeed)) {
-    const QVariant& speed = mesg.getFieldValue(eRecordSpeed);
-    exts["speed"] = speed.toDouble() / 1000.;
-  }
+  auto setExtension = [&](const QString& key, CFitRecordColumns::column_e column, qreal divisor) {
+    const qreal value = records.value(column, row);
+    if (!qIsNaN(value)) {
+      exts[key] = value / divisor;
+    }
+  };
+  setExtension("gpxtpx:TrackPointExtension|gpxtpx:hr", CFitRecordColumns::eColumnHeartRate, 1);
+  setExtension("gpxtpx:TrackPointExtension|gpxtpx:atemp", CFitRecordColumns::eColumnTemperature, 1);
+  setExtension("gpxtpx:TrackPointExtension|gpxtpx:cad", CFitRecordColumns::eColumnCadence, 1);
+  setExtension("gpxtpx:TrackPointExtension|gpxtpx:power", CFitRecordColumns::eColumnPower, 1);
+  setExtension("speed", CFitRecordColumns::eColumnSpeed, 1000.);
 }
 
-static bool readFitRecord(const CFitMessage& mesg, IGisItem::wpt_t& pt) {
-  if (mesg.isFieldValueValid(eRecordPositionLong) && mesg.isFieldValueValid(eRecordPositionLat)) {
-    pt.lon = toDegree(mesg.getFieldValue(eRecordPositionLong).toInt());
-    pt.lat = toDegree(mesg.getFieldValue(eRecordPositionLat).toInt());
-    if (mesg.isFieldValueValid(eRecordEnhancedAltitude)) {
-      pt.ele = mesg.getFieldValue(eRecordEnhancedAltitude).toInt();
+static bool readFitRecord(const CFitRecordColumns& records, qint32 row, IGisItem::wpt_t& pt) {
+  if (records.isPositionValid(row)) {
+    pt.lon = toDegree(records.positionLong[row]);
+    pt.lat = toDegree(records.positionLat[row]);
+    const qreal ele = records.value(CFitRecordColumns::eColumnEnhancedAltitude, row);
+    if (!qIsNaN(ele)) {
+      pt.ele = qRound(ele);
     }
-    pt.time = toDateTime(mesg.getFieldValue(eRecordTimestamp).toUInt());
+    pt.time = toDateTime(records.timestamp[row]);
 
-    readKnownExtensions(pt.extensions, mesg);
+    readKnownExtensions(pt.extensions, records, row);
 
     return true;
   }
   return false;
 }
 
-static bool readFitRecord(const CFitMessage& mesg, CTrackData::trkpt_t& pt) {
-  if (readFitRecord(mesg, (IGisItem::wpt_t&)pt)) {
-    pt.speed = mesg.getFieldValue(eRecordSpeed).toDouble();
-
-    readKnownExtensions(pt.extensions, mesg);
-
+static bool readFitRecord(const CFitRecordColumns& records, qint32 row, CTrackData::trkpt_t& pt) {
+  if (readFitRecord(records, row, (IGisItem::wpt_t&)pt)) {
+    const qreal speed = records.value(CFitRecordColumns::eColumnSpeed, row);
+    if (!qIsNaN(speed)) {
+      pt.speed = speed;
+    }
     pt.extensions.squeeze();
     return true;
   }
@@ -200,13 +196,15 @@ void CGisItemTrk::readTrkFromFit(CFitStream& stream) {
   // Record messages can either be at the beginning or in chronological order within the record
   // messages. Garmin devices uses the chronological ordering. We only consider the chronological
   // order, otherwise timestamps (of records and events) must be compared to each other.
+  const CFitRecordColumns& records = stream.getRecords();
   CTrackData::trkseg_t seg;
+  seg.pts.reserve(records.size());
   do {
     const CFitMessage& mesg = stream.nextMesg();
     if (mesg.getGlobalMesgNr() == eMesgNumRecord) {
       // for documentation: MesgNumActivity, MesgNumSession, MesgNumLap, MesgNumLength could also contain data
       CTrackData::trkpt_t pt;
-      if (readFitRecord(mesg, pt)) {
+      if (readFitRecord(records, mesg.getRecordIndex(), pt)) {
         seg.pts.append(std::move(pt));
       }
     } else if (mesg.getGlobalMesgNr() == eMesgNumEvent) {
@@ -252,11 +250,12 @@ void CGisItemRte::readRteFromFit(CFitStream& stream) {
   // a course file could be considered as a route...
   rte.name = evaluateTrkName(stream);
   stream.reset();
+  const CFitRecordColumns& records = stream.getRecords();
   do {
     const CFitMessage& mesg = stream.nextMesg();
     if (mesg.getGlobalMesgNr() == eMesgNumRecord) {
       rtept_t pt;
-      if (readFitRecord(mesg, pt)) {
+      if (readFitRecord(records, mesg.getRecordIndex(), pt)) {
         rte.pts.append(std::move(pt));
       }
     }
@@ -29,16 +29,17 @@
 #include "gis/trk/CKnownExtension.h"
 #include "gis/wpt/CGisItemWpt.h"
 #include "helpers/CSelectCopyAction.h"
+#include "helpers/CXmlDomStream.h"
 
 CGpxProject::CGpxProject(const QString& filename, CGisListWks* parent) : IGisProject(eTypeGpx, filename, parent) {
-  setIcon(CGisListWks::eColumnIcon, QIcon("://icons/32x32/GpxProject.png"));
+  setProjectIcon("://icons/32x32/GpxProject.png");
   blockUpdateItems(true);
   loadGpx(filename);
   blockUpdateItems(false);
 }
 
 CGpxProject::CGpxProject(const QString& filename, IDevice* parent) : IGisProject(eTypeGpx, filename, parent) {
-  setIcon(CGisListWks::eColumnIcon, QIcon("://icons/32x32/GpxProject.png"));
+  setProjectIcon("://icons/32x32/GpxProject.png");
   blockUpdateItems(true);
   loadGpx(filename);
   blockUpdateItems(false);
@@ -46,7 +47,7 @@ CGpxProject::CGpxProject(const QString& filename, IDevice* parent) : IGisProject
 
 CGpxProject::CGpxProject(const QString& filename, const IGisProject* project, IDevice* parent)
     : IGisProject(eTypeGpx, filename, parent) {
-  setIcon(CGisListWks::eColumnIcon, QIcon("://icons/32x32/GpxProject.png"));
+  setProjectIcon("://icons/32x32/GpxProject.png");
   *(IGisProject*)this = *project;
   blockUpdateItems(project->blockUpdateItems());
 
@@ -71,8 +72,7 @@ void CGpxProject::loadGpx(const QString& filename) {
   try {
     loadGpx(filename, this);
   } catch (QString& errormsg) {
-    QMessageBox::critical(CMainWindow::getBestWidgetForParent(), tr("Failed to load file %1...").arg(filename),
-                          errormsg, QMessageBox::Abort);
+    showLoadError(filename, errormsg);
     valid = false;
   }
 }
@@ -94,42 +94,84 @@ void CGpxProject::loadGpx(const QString& filename, CGpxProject* project) {
     throw tr("Failed to open %1").arg(filename);
   }
 
-  // load file content to xml document
-  QDomDocument xml;
-  QString msg;
-  int line;
-  int column;
-  if (!xml.setContent(&file, false, &msg, &line, &column)) {
-    file.close();
-    throw tr("Failed to read: %1\nline %2, column %3:\n %4").arg(filename).arg(line).arg(column).arg(msg);
-  }
-  file.close();
-
-  int N;
-  QDomElement xmlGpx = xml.documentElement();
-  if (xmlGpx.tagName() != "gpx") {
+  // The file is read as stream. Only tracks can become really large. They
+  // are created right from the stream. All other elements are small and
+  // read into a DOM element each to be processed by the common DOM code.
+  QXmlStreamReader xml(&file);
+  xml.setNamespaceProcessing(false);
+
+  if (!xml.readNextStartElement() || xml.qualifiedName() != "gpx") {
+    if (xml.hasError()) {
+      throw tr("Failed to read: %1\nline %2, column %3:\n %4")
+          .arg(filename)
+          .arg(xml.lineNumber())
+          .arg(xml.columnNumber())
+          .arg(xml.errorString());
+    }
     throw tr("Not a GPX file: %1").arg(filename);
   }
 
   // Read all attributes and find any registrations for actually known extensions.
   // This is used to properly detect valid .gpx files using uncommon namespaces.
-  QDomNamedNodeMap attributes = xmlGpx.attributes();
-  for (int i = 0; i < attributes.size(); ++i) {
+  auto registerNamespace = [](const QString& prefix, const QStringRef& uri) {
+    if (uri == gpxtpx_ns) {
+      CKnownExtension::initGarminTPXv1(IUnit::self(), prefix);
+    } else if (uri == gpxdata_ns) {
+      CKnownExtension::initClueTrustTPXv1(IUnit::self(), prefix);
+    }
+  };
+
+  const QXmlStreamAttributes& attributes = xml.attributes();
+  for (const QXmlStreamAttribute& att : attributes) {
     const QString xmlns("xmlns");
-    QDomAttr att = attributes.item(i).toAttr();
+    const QString& name = att.qualifiedName().toString();
+    if (name.startsWith(xmlns + ":")) {
+      registerNamespace(name.mid(xmlns.length() + 1), att.value());
+    }
+  }
 
-    if (att.name().startsWith(xmlns + ":")) {
-      QString ns = att.name().mid(xmlns.length() + 1);
+  const QXmlStreamNamespaceDeclarations& namespaces = xml.namespaceDeclarations();
+  for (const QXmlStreamNamespaceDeclaration& ns : namespaces) {
+    registerNamespace(ns.prefix().toString(), ns.namespaceUri());
+  }
 
-      if (att.value() == gpxtpx_ns) {
-        CKnownExtension::initGarminTPXv1(IUnit::self(), ns);
-      } else if (att.value() == gpxdata_ns) {
-        CKnownExtension::initClueTrustTPXv1(IUnit::self(), ns);
-      }
+  QDomDocument doc;
+  QDomElement xmlMetadata;
+  QDomElement xmlExtension;
+  QList<QDomElement> xmlRtes;
+  QList<QDomElement> xmlWpts;
+
+  /** @note   If you change the order of the item types read you have to
+              take care of the order enforced in IGisItem(). Therefore
+              only tracks are created while reading. All other items
+              are created after the stream has been read.
+   */
+  while (xml.readNextStartElement()) {
+    const QStringRef& tag = xml.qualifiedName();
+    if (tag == "trk") {
+      new CGisItemTrk(xml, project);
+    } else if (tag == "rte") {
+      xmlRtes << CXmlDomStream::read(xml, doc);
+    } else if (tag == "wpt") {
+      xmlWpts << CXmlDomStream::read(xml, doc);
+    } else if (tag == "metadata") {
+      xmlMetadata = CXmlDomStream::read(xml, doc);
+    } else if (tag == "extensions") {
+      xmlExtension = CXmlDomStream::read(xml, doc);
+    } else {
+      xml.skipCurrentElement();
     }
   }
+  file.close();
+
+  if (xml.hasError()) {
+    throw tr("Failed to read: %1\nline %2, column %3:\n %4")
+        .arg(filename)
+        .arg(xml.lineNumber())
+        .arg(xml.columnNumber())
+        .arg(xml.errorString());
+  }
 
-  const QDomElement& xmlExtension = xmlGpx.namedItem("extensions").toElement();
   if (xmlExtension.namedItem("ql:key").isElement()) {
     project->key = xmlExtension.namedItem("ql:key").toElement().text();
   }
@@ -151,32 +193,15 @@ void CGpxProject::loadGpx(const QString& filename, CGpxProject* project) {
     project->invalidDataOk = bool(xmlExtension.namedItem("ql:invalidDataOk").toElement().text().toInt() != 0);
   }
 
-  const QDomNode& xmlMetadata = xmlGpx.namedItem("metadata");
-  if (xmlMetadata.isElement()) {
+  if (!xmlMetadata.isNull()) {
     project->readMetadata(xmlMetadata, project->metadata);
   }
 
-  /** @note   If you change the order of the item types read you have to
-              take care of the order enforced in IGisItem().
-   */
-  const QDomNodeList& xmlTrks = xmlGpx.elementsByTagName("trk");
-  N = xmlTrks.count();
-  for (int n = 0; n < N; ++n) {
-    const QDomNode& xmlTrk = xmlTrks.item(n);
-    new CGisItemTrk(xmlTrk, project);
-  }
-
-  const QDomNodeList& xmlRtes = xmlGpx.elementsByTagName("rte");
-  N = xmlRtes.count();
-  for (int n = 0; n < N; ++n) {
-    const QDomNode& xmlRte = xmlRtes.item(n);
+  for (const QDomElement& xmlRte : qAsConst(xmlRtes)) {
     new CGisItemRte(xmlRte, project);
   }
 
-  const QDomNodeList& xmlWpts = xmlGpx.elementsByTagName("wpt");
-  N = xmlWpts.count();
-  for (int n = 0; n < N; ++n) {
-    const QDomNode& xmlWpt = xmlWpts.item(n);
+  for (const QDomElement& xmlWpt : qAsConst(xmlWpts)) {
     CGisItemWpt* wpt = new CGisItemWpt(xmlWpt, project);
 
     /*
@@ -191,7 +216,7 @@ void CGpxProject::loadGpx(const QString& filename, CGpxProject* project) {
   }
 
   const QDomNodeList& xmlAreas = xmlExtension.elementsByTagName("ql:area");
-  N = xmlAreas.count();
+  const int N = xmlAreas.count();
   for (int n = 0; n < N; ++n) {
     const QDomNode& xmlArea = xmlAreas.item(n);
     new CGisItemOvlArea(xmlArea, project);
@@ -218,12 +243,11 @@ bool CGpxProject::saveAs(const QString& fn, IGisProject& project, bool strictGpx
     file.open(QIODevice::ReadOnly);
     bool createdByQMS = false;
 
-    // load file content to xml document
-    QDomDocument xml;
-    if (xml.setContent(&file, false)) {
-      const QDomElement& docElem = xml.documentElement();
-      const QDomNamedNodeMap& attr = docElem.attributes();
-      createdByQMS = attr.namedItem("creator").nodeValue().startsWith("QMapShack");
+    // the creator is an attribute of the root element. No need to read any further.
+    QXmlStreamReader xml(&file);
+    xml.setNamespaceProcessing(false);
+    if (xml.readNextStartElement()) {
+      createdByQMS = xml.attributes().value("creator").startsWith("QMapShack");
     }
 
     if (!createdByQMS) {
@@ -276,16 +300,10 @@ bool CGpxProject::saveAs(const QString& fn, IGisProject& project, bool strictGpx
     }
     item->save(gpx, strictGpx11);
   }
-  for (int i = 0; i < project.childCount(); i++) {
-    CGisItemTrk* item = dynamic_cast<CGisItemTrk*>(project.child(i));
-    if (nullptr == item) {
-      continue;
-    }
-    item->save(gpx, strictGpx11);
-  }
-
+  // the tracks are streamed in between the routes and the extensions later on
+  QDomElement xmlExt;
   if (!strictGpx11) {
-    QDomElement xmlExt = doc.createElement("extensions");
+    xmlExt = doc.createElement("extensions");
     gpx.appendChild(xmlExt);
     for (int i = 0; i < project.childCount(); i++) {
       CGisItemOvlArea* item = dynamic_cast<CGisItemOvlArea*>(project.child(i));
@@ -337,13 +355,35 @@ bool CGpxProject::saveAs(const QString& fn, IGisProject& project, bool strictGpx
     if (!file.open(QIODevice::WriteOnly)) {
       throw tr("Failed to create file '%1'").arg(_fn_);
     }
-    QTextStream out(&file);
-    out.setCodec("UTF-8");
-    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\" ?>" << Qt::endl;
+    QXmlStreamWriter xml(&file);
+    xml.setAutoFormatting(true);
+    xml.setAutoFormattingIndent(1);
+    xml.writeStartDocument("1.0", false);
+
+    xml.writeStartElement("gpx");
+    CXmlDomStream::writeAttributes(xml, gpx.toElement());
+    for (QDomNode child = gpx.firstChild(); !child.isNull(); child = child.nextSibling()) {
+      if (child != xmlExt) {
+        CXmlDomStream::write(xml, child);
+      }
+    }
+
+    for (int i = 0; i < project.childCount(); i++) {
+      CGisItemTrk* item = dynamic_cast<CGisItemTrk*>(project.child(i));
+      if (nullptr == item) {
+        continue;
+      }
+      item->save(xml, strictGpx11);
+    }
+
+    if (!xmlExt.isNull()) {
+      CXmlDomStream::write(xml, xmlExt);
+    }
+    xml.writeEndElement();
+    xml.writeEndDocument();
 
-    out << doc.toString();
     file.close();
-    if (file.error() != QFile::NoError) {
+    if (xml.hasError() || (file.error() != QFile::NoError)) {
       throw tr("Failed to write file '%1'").arg(_fn_);
     }
   } catch (const QString& msg) {
@@ -26,7 +26,7 @@
 #include "gis/trk/CGisItemTrk.h"
 #include "gis/trk/CKnownExtension.h"
 #include "gis/wpt/CGisItemWpt.h"
-#include "helpers/CWptIconManager.h"
+#include "helpers/CXmlDomStream.h"
 #include "version.h"
 
 const QString IGisProject::gpx_ns = "http://www.topografix.com/GPX/1/1";
@@ -331,6 +331,260 @@ static void writeXml(QDomNode& ext, const QHash<QString, QVariant>& extensions)
   }
 }
 
+// ---- streamed track points ----
+//
+// The functions below work on the current element of a QXmlStreamReader
+// or write a complete element to a QXmlStreamWriter. They are the stream
+// counterparts of the DOM functions above and used for the track points.
+
+static void readXml(QXmlStreamReader& xml, qint32& value) {
+  const QString& text = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+  bool ok = false;
+  qint32 tmp = text.toInt(&ok);
+  if (!ok) {
+    tmp = qRound(text.toDouble(&ok));
+  }
+  if (ok) {
+    value = tmp;
+  }
+}
+
+static void readXml(QXmlStreamReader& xml, trkact_t& value) {
+  bool ok = false;
+  qint32 tmp = xml.readElementText(QXmlStreamReader::IncludeChildElements).toInt(&ok);
+  value = ok ? trkact_t(tmp) : CTrackData::trkpt_t::eAct20None;
+}
+
+static void readXml(QXmlStreamReader& xml, quint32& value) {
+  bool ok = false;
+  quint32 tmp = xml.readElementText(QXmlStreamReader::IncludeChildElements).toUInt(&ok);
+  if (ok) {
+    value = tmp;
+  }
+}
+
+static void readXml(QXmlStreamReader& xml, QString& value) {
+  value = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+}
+
+static void readXml(QXmlStreamReader& xml, QDateTime& value) {
+  IUnit::parseTimestamp(xml.readElementText(QXmlStreamReader::IncludeChildElements), value);
+}
+
+static void readXml(QXmlStreamReader& xml, QList<IGisItem::link_t>& l) {
+  IGisItem::link_t tmp;
+  tmp.uri.setUrl(xml.attributes().value("href").toString());
+  while (xml.readNextStartElement()) {
+    const QStringRef& tag = xml.qualifiedName();
+    if (tag == "text") {
+      readXml(xml, tmp.text);
+    } else if (tag == "type") {
+      readXml(xml, tmp.type);
+    } else {
+      xml.skipCurrentElement();
+    }
+  }
+
+  l << tmp;
+}
+
+static void readXml(QXmlStreamReader& xml, const QString& parentTags, QHash<QString, QVariant>& extensions) {
+  const QString& tag = xml.qualifiedName().toString();
+  if ((tag.left(8) == "ql:flags") || (tag.left(11) == "ql:activity")) {
+    xml.skipCurrentElement();
+    return;
+  }
+
+  // Like the DOM version an element with text is stored as value. Else
+  // the child elements are stored with the concatenated tags as key.
+  const QString& tags = parentTags.isEmpty() ? tag : parentTags + "|" + tag;
+  QString text;
+  bool hasText = false;
+  bool hasChildren = false;
+  while (!xml.atEnd()) {
+    xml.readNext();
+    if (xml.isStartElement()) {
+      hasChildren = true;
+      readXml(xml, tags, extensions);
+    } else if (xml.isCharacters()) {
+      hasText = hasText || !xml.isWhitespace();
+      text += xml.text();
+    } else if (xml.isEndElement()) {
+      break;
+    }
+  }
+
+  if (hasText && !hasChildren) {
+    extensions[tags] = text;
+  }
+}
+
+static void readTrkpt(QXmlStreamReader& xml, CTrackData::trkpt_t& trkpt) {
+  const QXmlStreamAttributes& attr = xml.attributes();
+  trkpt.lat = attr.value("lat").toDouble();
+  trkpt.lon = attr.value("lon").toDouble();
+
+  QString url;
+  QString urlname;
+  while (xml.readNextStartElement()) {
+    const QStringRef& tag = xml.qualifiedName();
+    if (tag == "ele") {
+      readXml(xml, trkpt.ele);
+    } else if (tag == "time") {
+      readXml(xml, trkpt.time);
+    } else if (tag == "extensions") {
+      while (xml.readNextStartElement()) {
+        const QStringRef& extTag = xml.qualifiedName();
+        if (extTag == "ql:flags") {
+          readXml(xml, trkpt.flags);
+        } else if (extTag == "ql:activity") {
+          readXml(xml, trkpt.activity);
+        } else {
+          readXml(xml, "", trkpt.extensions);
+        }
+      }
+      trkpt.sanitizeFlags();
+      trkpt.extensions.squeeze();
+    } else if (tag == "magvar") {
+      readXml(xml, trkpt.magvar);
+    } else if (tag == "geoidheight") {
+      readXml(xml, trkpt.geoidheight);
+    } else if (tag == "name") {
+      readXml(xml, trkpt.name);
+    } else if (tag == "cmt") {
+      readXml(xml, trkpt.cmt);
+    } else if (tag == "desc") {
+      readXml(xml, trkpt.desc);
+    } else if (tag == "src") {
+      readXml(xml, trkpt.src);
+    } else if (tag == "link") {
+      readXml(xml, trkpt.links);
+    } else if (tag == "sym") {
+      readXml(xml, trkpt.sym);
+    } else if (tag == "type") {
+      readXml(xml, trkpt.type);
+    } else if (tag == "fix") {
+      readXml(xml, trkpt.fix);
+    } else if (tag == "sat") {
+      readXml(xml, trkpt.sat);
+    } else if (tag == "hdop") {
+      readXml(xml, trkpt.hdop);
+    } else if (tag == "vdop") {
+      readXml(xml, trkpt.vdop);
+    } else if (tag == "pdop") {
+      readXml(xml, trkpt.pdop);
+    } else if (tag == "ageofdgpsdata") {
+      readXml(xml, trkpt.ageofdgpsdata);
+    } else if (tag == "dgpsid") {
+      readXml(xml, trkpt.dgpsid);
+    } else if (tag == "url") {
+      readXml(xml, url);
+    } else if (tag == "urlname") {
+      readXml(xml, urlname);
+    } else {
+      xml.skipCurrentElement();
+    }
+  }
+
+  // some GPX 1.0 backward compatibility
+  if (!url.isEmpty()) {
+    IGisItem::link_t link;
+    link.uri.setUrl(url);
+    link.text = urlname;
+
+    trkpt.links << link;
+  }
+}
+
+static void writeXml(QXmlStreamWriter& xml, const QString& tag, qint32 val) {
+  if (val != NOINT) {
+    xml.writeTextElement(tag, QString::number(val));
+  }
+}
+
+static void writeXml(QXmlStreamWriter& xml, const QString& tag, quint32 val) {
+  if (val != NOINT) {
+    xml.writeTextElement(tag, QString::number(val));
+  }
+}
+
+static void writeXml(QXmlStreamWriter& xml, const QString& tag, const QString& val) {
+  if (!val.isEmpty()) {
+    xml.writeTextElement(tag, val);
+  }
+}
+
+static void writeXml(QXmlStreamWriter& xml, const QString& tag, const QDateTime& time) {
+  if (time.isValid()) {
+    xml.writeTextElement(tag, time.toString("yyyy-MM-dd'T'hh:mm:ss.zzz'Z'"));
+  }
+}
+
+static void writeXml(QXmlStreamWriter& xml, const QString& tag, const QList<IGisItem::link_t>& links) {
+  for (const IGisItem::link_t& link : links) {
+    xml.writeStartElement(tag);
+    xml.writeAttribute("href", link.uri.toString());
+    writeXml(xml, "text", link.text);
+    writeXml(xml, "type", link.type);
+    xml.writeEndElement();
+  }
+}
+
+struct xmlext_t {
+  int order;
+  QStringList tags;
+  QString value;
+};
+
+static void writeXml(QXmlStreamWriter& xml, const QList<xmlext_t>& extensions, int level) {
+  QSet<QString> done;
+  const int N = extensions.size();
+  for (int n = 0; n < N; n++) {
+    const xmlext_t& ext = extensions[n];
+    const QString& tag = ext.tags[level];
+    if (ext.tags.size() == level + 1) {
+      xml.writeTextElement(tag, ext.value);
+      continue;
+    }
+
+    // all extensions with the same parent tag are collected in a single element
+    if (done.contains(tag)) {
+      continue;
+    }
+    done << tag;
+
+    QList<xmlext_t> children;
+    for (int m = n; m < N; m++) {
+      const xmlext_t& child = extensions[m];
+      if ((child.tags.size() > level + 1) && (child.tags[level] == tag)) {
+        children << child;
+      }
+    }
+
+    xml.writeStartElement(tag);
+    writeXml(xml, children, level + 1);
+    xml.writeEndElement();
+  }
+}
+
+static void writeXml(QXmlStreamWriter& xml, const QHash<QString, QVariant>& extensions) {
+  if (extensions.isEmpty()) {
+    return;
+  }
+
+  QList<xmlext_t> list;
+  for (auto it = extensions.cbegin(); it != extensions.cend(); ++it) {
+    const QStringList& tags = it.key().split('|', Qt::SkipEmptyParts);
+    if (!tags.isEmpty()) {
+      list << xmlext_t{CKnownExtension::get(it.key()).order, tags, it.value().toString()};
+    }
+  }
+
+  std::sort(list.begin(), list.end(), [](const xmlext_t& e1, const xmlext_t& e2) { return e1.order < e2.order; });
+
+  writeXml(xml, list, 0);
+}
+
 void IGisProject::readMetadata(const QDomNode& xml, metadata_t& metadata) {
   readXml(xml, "name", metadata.name);
   readXml(xml, "desc", metadata.desc);
@@ -660,13 +914,7 @@ void CGisItemWpt::writeGcExt(QDomNode& xmlCache) {
 }
 
 void CGisItemTrk::readTrk(const QDomNode& xml, CTrackData& trk) {
-  readXml(xml, "name", trk.name);
-  readXml(xml, "cmt", trk.cmt);
-  readXml(xml, "desc", trk.desc);
-  readXml(xml, "src", trk.src);
-  readXml(xml, "link", trk.links);
-  readXml(xml, "number", trk.number);
-  readXml(xml, "type", trk.type);
+  readTrkHeader(xml, trk);
 
   const QDomNodeList& trksegs = xml.toElement().elementsByTagName("trkseg");
   int N = trksegs.count();
@@ -693,6 +941,46 @@ void CGisItemTrk::readTrk(const QDomNode& xml, CTrackData& trk) {
     }
   }
 
+  deriveSecondaryData();
+}
+
+void CGisItemTrk::readTrk(QXmlStreamReader& xml, CTrackData& trk) {
+  // Everything but the track segments is small. It is collected
+  // as DOM element to be read by the same code as the DOM version.
+  QDomDocument doc;
+  QDomElement xmlTrk = doc.createElement("trk");
+
+  while (xml.readNextStartElement()) {
+    if (xml.qualifiedName() != "trkseg") {
+      xmlTrk.appendChild(CXmlDomStream::read(xml, doc));
+      continue;
+    }
+
+    trk.segs.append(CTrackData::trkseg_t());
+    CTrackData::trkseg_t& seg = trk.segs.last();
+    while (xml.readNextStartElement()) {
+      if (xml.qualifiedName() == "trkpt") {
+        seg.pts.append(CTrackData::trkpt_t());
+        readTrkpt(xml, seg.pts.last());
+      } else {
+        xml.skipCurrentElement();
+      }
+    }
+  }
+
+  readTrkHeader(xmlTrk, trk);
+  deriveSecondaryData();
+}
+
+void CGisItemTrk::readTrkHeader(const QDomNode& xml, CTrackData& trk) {
+  readXml(xml, "name", trk.name);
+  readXml(xml, "cmt", trk.cmt);
+  readXml(xml, "desc", trk.desc);
+  readXml(xml, "src", trk.src);
+  readXml(xml, "link", trk.links);
+  readXml(xml, "number", trk.number);
+  readXml(xml, "type", trk.type);
+
   // decode some well known extensions
   const QDomNode& ext = xml.namedItem("extensions");
   if (ext.isElement()) {
@@ -704,8 +992,6 @@ void CGisItemTrk::readTrk(const QDomNode& xml, CTrackData& trk) {
     readXml(gpxx, "gpxx:DisplayColor", trk.color);
     setColor(str2color(trk.color));
   }
-
-  deriveSecondaryData();
 }
 
 void CGisItemTrk::save(QDomNode& gpx, bool strictGpx11) {
@@ -713,6 +999,61 @@ void CGisItemTrk::save(QDomNode& gpx, bool strictGpx11) {
 
   QDomElement xmlTrk = doc.createElement("trk");
   gpx.appendChild(xmlTrk);
+  saveHeader(xmlTrk, strictGpx11);
+
+  for (const CTrackData::trkseg_t& seg : qAsConst(trk.segs)) {
+    QDomElement xmlTrkseg = doc.createElement("trkseg");
+    xmlTrk.appendChild(xmlTrkseg);
+
+    for (const CTrackData::trkpt_t& pt : seg.pts) {
+      QDomElement xmlTrkpt = doc.createElement("trkpt");
+      xmlTrkseg.appendChild(xmlTrkpt);
+      writeWpt(xmlTrkpt, pt, strictGpx11);
+
+      if (!strictGpx11) {
+        QDomElement xmlExt = doc.createElement("extensions");
+        xmlTrkpt.appendChild(xmlExt);
+        writeXml(xmlExt, "ql:flags", pt.flags);
+        writeXml(xmlExt, "ql:activity", pt.activity);
+        writeXml(xmlExt, pt.extensions);
+      }
+    }
+  }
+}
+
+void CGisItemTrk::save(QXmlStreamWriter& xml, bool strictGpx11) {
+  // the header is small. Build it with the DOM code and stream the track points only
+  QDomDocument doc;
+  QDomElement xmlTrk = doc.createElement("trk");
+  saveHeader(xmlTrk, strictGpx11);
+
+  xml.writeStartElement("trk");
+  CXmlDomStream::writeChildren(xml, xmlTrk);
+
+  for (const CTrackData::trkseg_t& seg : qAsConst(trk.segs)) {
+    xml.writeStartElement("trkseg");
+
+    for (const CTrackData::trkpt_t& pt : seg.pts) {
+      xml.writeStartElement("trkpt");
+      writeWpt(xml, pt, strictGpx11);
+
+      if (!strictGpx11) {
+        xml.writeStartElement("extensions");
+        writeXml(xml, "ql:flags", pt.flags);
+        writeXml(xml, "ql:activity", pt.activity);
+        writeXml(xml, pt.extensions);
+        xml.writeEndElement();
+      }
+      xml.writeEndElement();
+    }
+    xml.writeEndElement();
+  }
+
+  xml.writeEndElement();
+}
+
+void CGisItemTrk::saveHeader(QDomElement& xmlTrk, bool strictGpx11) {
+  QDomDocument doc = xmlTrk.ownerDocument();
 
   writeXml(xmlTrk, "name", trk.name);
   writeXml(xmlTrk, "cmt", html2Dev(trk.cmt, strictGpx11));
@@ -735,25 +1076,6 @@ void CGisItemTrk::save(QDomNode& gpx, bool strictGpx11) {
     xmlExt.appendChild(gpxx);
     writeXml(gpxx, "gpxx:DisplayColor", trk.color);
   }
-
-  for (const CTrackData::trkseg_t& seg : qAsConst(trk.segs)) {
-    QDomElement xmlTrkseg = doc.createElement("trkseg");
-    xmlTrk.appendChild(xmlTrkseg);
-
-    for (const CTrackData::trkpt_t& pt : seg.pts) {
-      QDomElement xmlTrkpt = doc.createElement("trkpt");
-      xmlTrkseg.appendChild(xmlTrkpt);
-      writeWpt(xmlTrkpt, pt, strictGpx11);
-
-      if (!strictGpx11) {
-        QDomElement xmlExt = doc.createElement("extensions");
-        xmlTrkpt.appendChild(xmlExt);
-        writeXml(xmlExt, "ql:flags", pt.flags);
-        writeXml(xmlExt, "ql:activity", pt.activity);
-        writeXml(xmlExt, pt.extensions);
-      }
-    }
-  }
 }
 
 void CGisItemRte::readRte(const QDomNode& xml, rte_t& rte) {
@@ -772,7 +1094,6 @@ void CGisItemRte::readRte(const QDomNode& xml, rte_t& rte) {
     rtept_t& rtept = rte.pts[m];
     const QDomNode& xmlRtept = xmlRtepts.item(m);
     readWpt(xmlRtept, rtept);
-    rtept.icon = CWptIconManager::self().getWptIconByName(rtept.sym, rtept.focus);
   }
 
   // decode some well known extensions
@@ -934,6 +1255,32 @@ void IGisItem::writeWpt(QDomElement& xml, const wpt_t& wpt, bool strictGpx11) {
   writeXml(xml, "dgpsid", wpt.dgpsid);
 }
 
+void IGisItem::writeWpt(QXmlStreamWriter& xml, const wpt_t& wpt, bool strictGpx11) {
+  xml.writeAttribute("lat", QString::asprintf("%1.8f", wpt.lat));
+  xml.writeAttribute("lon", QString::asprintf("%1.8f", wpt.lon));
+
+  writeXml(xml, "ele", wpt.ele);
+  writeXml(xml, "time", wpt.time);
+  writeXml(xml, "magvar", wpt.magvar);
+  writeXml(xml, "geoidheight", wpt.geoidheight);
+  writeXml(xml, "name", wpt.name);
+  writeXml(xml, "cmt", html2Dev(wpt.cmt, strictGpx11));
+  writeXml(xml, "desc", html2Dev(wpt.desc, strictGpx11));
+  if (isOnDevice() != IDevice::eTypeGarmin) {
+    writeXml(xml, "src", wpt.src);
+  }
+  writeXml(xml, "link", wpt.links);
+  writeXml(xml, "sym", wpt.sym);
+  writeXml(xml, "type", wpt.type);
+  writeXml(xml, "fix", wpt.fix);
+  writeXml(xml, "sat", wpt.sat);
+  writeXml(xml, "hdop", wpt.hdop);
+  writeXml(xml, "vdop", wpt.vdop);
+  writeXml(xml, "pdop", wpt.pdop);
+  writeXml(xml, "ageofdgpsdata", wpt.ageofdgpsdata);
+  writeXml(xml, "dgpsid", wpt.dgpsid);
+}
+
 void CDeviceGarmin::createAdventureFromProject(IGisProject* project, const QString& gpxFilename) {
   if (pathAdventures.isEmpty()) {
     return;
@@ -180,6 +180,8 @@ void CGisItemOvlArea::edit() {
 }
 
 void CGisItemOvlArea::deriveSecondaryData() {
+  geometryChanged();
+
   qreal north = -90;
   qreal east = -180;
   qreal south = 90;
@@ -238,14 +240,16 @@ void CGisItemOvlArea::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRe
 
   QPointF pt1;
 
-  for (const pt_t& pt : qAsConst(area.pts)) {
-    pt1.setX(pt.lon);
-    pt1.setY(pt.lat);
-    pt1 *= DEG_TO_RAD;
-    polygonArea << pt1;
-  }
+  if (!gis->restoreLine(this, polygonArea)) {
+    for (const pt_t& pt : qAsConst(area.pts)) {
+      pt1.setX(pt.lon);
+      pt1.setY(pt.lat);
+      pt1 *= DEG_TO_RAD;
+      polygonArea << pt1;
+    }
 
-  gis->convertRad2Px(polygonArea);
+    gis->storeLine(this, polygonArea);
+  }
 
   p.save();
   p.setOpacity(area.opacity ? 0.3 : 1.0);
@@ -262,12 +266,9 @@ void CGisItemOvlArea::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRe
   p.drawPolygon(polygonArea);
 
   // close polygon (required by isCloseTo)
-  const pt_t& pt = area.pts.first();
-  pt1.setX(pt.lon);
-  pt1.setY(pt.lat);
-  pt1 *= DEG_TO_RAD;
-  gis->convertRad2Px(pt1);
-  polygonArea << pt1;
+  if (!polygonArea.isEmpty()) {
+    polygonArea << polygonArea.first();
+  }
 
   p.restore();
 }
@@ -461,7 +462,6 @@ void CGisItemOvlArea::setColor(const QColor& c) {
     if (colorMap[n].color == c) {
       colorIdx = n;
       color = colorMap[n].color;
-      bullet = QPixmap(colorMap[n].bullet);
       break;
     }
   }
@@ -469,9 +469,16 @@ void CGisItemOvlArea::setColor(const QColor& c) {
   if (n == colorMap.size()) {
     colorIdx = DEFAULT_COLOR;
     color = colorMap[DEFAULT_COLOR].color;
-    bullet = QPixmap(colorMap[DEFAULT_COLOR].bullet);
   }
 
+  if (IGisProject::isLoadedByWorker()) {
+    // pixmaps are created by IGisProject::finishLoading() on the GUI thread
+    area.color = color.name();
+    return;
+  }
+
+  bullet = QPixmap(colorMap[colorIdx].bullet);
+
   setIcon(color.name());
 }
 
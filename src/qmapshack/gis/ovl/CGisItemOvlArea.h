@@ -106,6 +106,8 @@ class CGisItemOvlArea : public IGisItem, public IGisLine {
 
  protected:
   void setSymbol() override;
+  quint8 writeItemData(QByteArray& buffer) const override;
+  void readItemData(const QByteArray& buffer, quint8 version) override;
 
  public:
   struct pt_t : public wpt_t {};
@@ -139,6 +139,94 @@ IGisProject* IGisProject::create(const QString filename, CGisListWks* parent) {
   return item;
 }
 
+bool IGisProject::canCreateDetached(const QString& filename) {
+  const QFileInfo fi(filename);
+  const QString& suffix = fi.suffix().toLower();
+  return fi.exists() && (suffix == "gpx" || suffix == "tcx" || suffix == "fit" || suffix == "slf");
+}
+
+IGisProject* IGisProject::createDetached(const QString& filename, QString& errormsg) {
+  IGisProject* item = nullptr;
+  QString suffix = QFileInfo(filename).suffix().toLower();
+  if (suffix == "gpx") {
+    item = new CGpxProject(filename, (CGisListWks*)nullptr);
+  } else if (suffix == "slf") {
+    item = new CSlfProject(filename);
+  } else if (suffix == "fit") {
+    item = new CFitProject(filename, (CGisListWks*)nullptr);
+  } else if (suffix == "tcx") {
+    item = new CTcxProject(filename, (CGisListWks*)nullptr);
+  } else {
+    errormsg = tr("Unsupported file type.");
+    return nullptr;
+  }
+
+  if (!item->isValid()) {
+    errormsg = item->loadError;
+    delete item;
+    return nullptr;
+  }
+
+  // The limits of the tracks are QObjects. They have been created with the affinity
+  // of the worker thread, that has no event loop. Hand them over to the GUI thread.
+  QThread* thread = QCoreApplication::instance()->thread();
+  const int N = item->childCount();
+  for (int n = 0; n < N; n++) {
+    CGisItemTrk* trk = dynamic_cast<CGisItemTrk*>(item->child(n));
+    if (trk != nullptr) {
+      trk->moveToThread(thread);
+    }
+  }
+
+  return item;
+}
+
+bool IGisProject::isLoadedByWorker() {
+  const QCoreApplication* app = QCoreApplication::instance();
+  return (app != nullptr) && (QThread::currentThread() != app->thread());
+}
+
+void IGisProject::finishLoading() {
+  // The worker did not create any icons. Update the decoration to set them.
+  setIcon(CGisListWks::eColumnIcon, QIcon(iconPath));
+  const int N = childCount();
+  for (int n = 0; n < N; n++) {
+    IGisItem* item = dynamic_cast<IGisItem*>(child(n));
+    if (item != nullptr) {
+      item->updateDecoration(IGisItem::eMarkNone, IGisItem::eMarkNone);
+    }
+  }
+
+  // The worker skipped the correlation of tracks and waypoints. As it has
+  // updated the item hash already, that hash has to be reset to force it.
+  hashTrkWpt[0].clear();
+  updateItems();
+
+  for (int n = 0; n < N; n++) {
+    CGisItemTrk* trk = dynamic_cast<CGisItemTrk*>(child(n));
+    if (trk != nullptr) {
+      trk->checkForInvalidPoints();
+    }
+  }
+}
+
+void IGisProject::setProjectIcon(const QString& path) {
+  iconPath = path;
+  if (!isLoadedByWorker()) {
+    setIcon(CGisListWks::eColumnIcon, QIcon(path));
+  }
+}
+
+void IGisProject::showLoadError(const QString& filename, const QString& errormsg) {
+  loadError = errormsg;
+  if (isLoadedByWorker()) {
+    qWarning() << "Failed to load file" << filename << errormsg;
+    return;
+  }
+  QMessageBox::critical(CMainWindow::getBestWidgetForParent(), tr("Failed to load file %1...").arg(filename),
+                        errormsg, QMessageBox::Abort);
+}
+
 QString IGisProject::html2Dev(const QString& str) {
   return isOnDevice() == IDevice::eTypeGarmin ? IGisItem::removeHtml(str) : str;
 }
@@ -300,7 +388,8 @@ void IGisProject::updateItems() {
   sortItems();
   updateItemCounters();
 
-  if (noCorrelation) {
+  // the correlation needs a progress dialog. A worker leaves it to finishLoading()
+  if (noCorrelation || isLoadedByWorker()) {
     return;
   }
 
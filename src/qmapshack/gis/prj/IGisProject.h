@@ -113,6 +113,40 @@ class IGisProject : public QTreeWidgetItem {
 
   static IGisProject* create(const QString filename, CGisListWks* parent);
 
+  /**
+     @brief Test if a file can be loaded by createDetached()
+
+     These are the activity formats that load without user interaction (GPX, TCX, FIT, SLF). The file
+     has to exist, as otherwise the file name is taken as name for a new project.
+   */
+  static bool canCreateDetached(const QString& filename);
+
+  /**
+     @brief Load a project without adding it to the workspace
+
+     This is used by the bulk import of CGisWorkspace to load files in a thread pool. No dialog is
+     shown. Anything that needs the GUI thread is postponed to finishLoading().
+
+     @param filename    the file to load
+     @param errormsg    receives the reason if the file could not be loaded
+     @return The project or nullptr on error.
+   */
+  static IGisProject* createDetached(const QString& filename, QString& errormsg);
+
+  /**
+     @brief Test if the calling thread is a worker thread and not the GUI thread
+
+     Projects and items must not show dialogs or update the canvas in that case.
+   */
+  static bool isLoadedByWorker();
+
+  /**
+     @brief Complete a project created by createDetached() after it has been added to the workspace
+
+     This must be called by the GUI thread. It creates the icons of the project and it's items, too.
+   */
+  void finishLoading();
+
   /**
      @brief Ask to save the project before it is closed.
 
@@ -465,6 +499,25 @@ class IGisProject : public QTreeWidgetItem {
   void sortItems();
   void sortItems(QList<IGisItem*>& items) const;
 
+  /**
+     @brief Report an error while loading the project
+
+     The message is stored for createDetached(). If called by the GUI thread a message box is shown, too.
+
+     @param filename    the file that failed to load
+     @param errormsg    the reason
+   */
+  void showLoadError(const QString& filename, const QString& errormsg);
+
+  /**
+     @brief Set the icon of the project in the workspace
+
+     A worker thread must not create icons. The path is kept and the icon is set by finishLoading().
+
+     @param path        the path of the icon
+   */
+  void setProjectIcon(const QString& path);
+
   /**
      @brief Converts a string with HTML tags to a string without HTML depending on the device
 
@@ -507,6 +560,8 @@ class IGisProject : public QTreeWidgetItem {
 
   metadata_t metadata;
   QString nameSuffix;
+  QString loadError;  ///< the reason if loading the file failed
+  QString iconPath;   ///< the path of the project's icon
 
   sorting_roadbook_e sortingRoadbook = eSortRoadbookNone;
   sorting_folder_e sortingFolder = eSortFolderTime;
@@ -45,13 +45,13 @@
 #define VER_COPYRIGHT quint8(1)
 #define VER_PERSON quint8(1)
 #define VER_HIST quint8(1)
-#define VER_HIST_EVT quint8(3)
+#define VER_HIST_EVT quint8(4)
 #define VER_ITEM quint8(3)
 #define VER_CVALUE quint8(1)
 #define VER_CLIMIT quint8(1)
 #define VER_ENERGYCYCLE quint8(1)
 
-#define MAGIC_SIZE 10
+#define MAGIC_SIZE IGisItem::sizeMagic
 #define MAGIC_TRK "QMTrk     "
 #define MAGIC_WPT "QMWpt     "
 #define MAGIC_RTE "QMRte     "
@@ -129,6 +129,7 @@ QDataStream& operator<<(QDataStream& stream, const IGisItem::history_event_t& e)
   stream << e.data;
   stream << e.hash;
   stream << e.who;
+  stream << e.isDelta;
 
   return stream;
 }
@@ -146,6 +147,9 @@ QDataStream& operator>>(QDataStream& stream, IGisItem::history_event_t& e) {
   if (version > 2) {
     stream >> e.who;
   }
+  if (version > 3) {
+    stream >> e.isDelta;
+  }
 
   return stream;
 }
@@ -164,6 +168,7 @@ QDataStream& operator>>(QDataStream& stream, IGisItem::history_t& h) {
   stream >> h.histIdxInitial;
   stream >> h.histIdxCurrent;
   stream >> h.events;
+  h.resetPayload();
 
   if (h.histIdxCurrent >= h.events.size()) {
     h.histIdxCurrent = h.events.size() - 1;
@@ -490,6 +495,15 @@ QDataStream& operator>>(QDataStream& stream, CEnergyCycling::energy_set_t& e) {
 
 QDataStream& CGisItemTrk::operator>>(QDataStream& stream) const {
   QByteArray buffer;
+  writeItemData(buffer);
+
+  stream.writeRawData(MAGIC_TRK, MAGIC_SIZE);
+  stream << VER_TRK;
+  stream << qCompress(buffer, 9);
+  return stream;
+}
+
+quint8 CGisItemTrk::writeItemData(QByteArray& buffer) const {
   QDataStream out(&buffer, QIODevice::WriteOnly);
   out.setByteOrder(QDataStream::LittleEndian);
   out.setVersion(QDataStream::Qt_5_2);
@@ -519,10 +533,7 @@ QDataStream& CGisItemTrk::operator>>(QDataStream& stream) const {
 
   out << trk.segs;
 
-  stream.writeRawData(MAGIC_TRK, MAGIC_SIZE);
-  stream << VER_TRK;
-  stream << qCompress(buffer, 9);
-  return stream;
+  return VER_TRK;
 }
 
 QDataStream& CGisItemTrk::operator<<(QDataStream& stream) {
@@ -539,13 +550,17 @@ QDataStream& CGisItemTrk::operator<<(QDataStream& stream) {
     return stream;
   }
 
-  resetMouseRange();
-
   stream >> version;
   stream >> buffer;
-  buffer = qUncompress(buffer);
+  readItemData(qUncompress(buffer), version);
 
-  QDataStream in(&buffer, QIODevice::ReadOnly);
+  return stream;
+}
+
+void CGisItemTrk::readItemData(const QByteArray& buffer, quint8 version) {
+  resetMouseRange();
+
+  QDataStream in(buffer);
   in.setByteOrder(QDataStream::LittleEndian);
   in.setVersion(QDataStream::Qt_5_2);
 
@@ -615,7 +630,6 @@ QDataStream& CGisItemTrk::operator<<(QDataStream& stream) {
   setToolTip(CGisListWks::eColumnName, getInfo(IGisItem::eFeatureShowName));
 
   checkForInvalidPoints();
-  return stream;
 }
 
 QDataStream& CGisItemWpt::operator<<(QDataStream& stream) {
@@ -634,9 +648,13 @@ QDataStream& CGisItemWpt::operator<<(QDataStream& stream) {
 
   stream >> version;
   stream >> buffer;
-  buffer = qUncompress(buffer);
+  readItemData(qUncompress(buffer), version);
+
+  return stream;
+}
 
-  QDataStream in(&buffer, QIODevice::ReadOnly);
+void CGisItemWpt::readItemData(const QByteArray& buffer, quint8 version) {
+  QDataStream in(buffer);
   in.setByteOrder(QDataStream::LittleEndian);
   in.setVersion(QDataStream::Qt_5_2);
 
@@ -666,12 +684,19 @@ QDataStream& CGisItemWpt::operator<<(QDataStream& stream) {
 
   detBoundingRect();
   radius = NOFLOAT;
-
-  return stream;
 }
 
 QDataStream& CGisItemWpt::operator>>(QDataStream& stream) const {
   QByteArray buffer;
+  writeItemData(buffer);
+
+  stream.writeRawData(MAGIC_WPT, MAGIC_SIZE);
+  stream << VER_WPT;
+  stream << qCompress(buffer, 9);
+  return stream;
+}
+
+quint8 CGisItemWpt::writeItemData(QByteArray& buffer) const {
   QDataStream out(&buffer, QIODevice::WriteOnly);
   out.setByteOrder(QDataStream::LittleEndian);
   out.setVersion(QDataStream::Qt_5_2);
@@ -687,11 +712,7 @@ QDataStream& CGisItemWpt::operator>>(QDataStream& stream) const {
   out << rating;
   out << keywords;
 
-  stream.writeRawData(MAGIC_WPT, MAGIC_SIZE);
-  stream << VER_WPT;
-  stream << qCompress(buffer, 9);
-
-  return stream;
+  return VER_WPT;
 }
 
 QDataStream& CGisItemRte::operator<<(QDataStream& stream) {
@@ -710,9 +731,13 @@ QDataStream& CGisItemRte::operator<<(QDataStream& stream) {
 
   stream >> version;
   stream >> buffer;
-  buffer = qUncompress(buffer);
+  readItemData(qUncompress(buffer), version);
 
-  QDataStream in(&buffer, QIODevice::ReadOnly);
+  return stream;
+}
+
+void CGisItemRte::readItemData(const QByteArray& buffer, quint8 version) {
+  QDataStream in(buffer);
   in.setByteOrder(QDataStream::LittleEndian);
   in.setVersion(QDataStream::Qt_5_2);
 
@@ -745,12 +770,19 @@ QDataStream& CGisItemRte::operator<<(QDataStream& stream) {
   deriveSecondaryData();
   setText(CGisListWks::eColumnName, getName());
   setToolTip(CGisListWks::eColumnName, getInfo(IGisItem::eFeatureShowName));
-
-  return stream;
 }
 
 QDataStream& CGisItemRte::operator>>(QDataStream& stream) const {
   QByteArray buffer;
+  writeItemData(buffer);
+
+  stream.writeRawData(MAGIC_RTE, MAGIC_SIZE);
+  stream << VER_RTE;
+  stream << qCompress(buffer, 9);
+  return stream;
+}
+
+quint8 CGisItemRte::writeItemData(QByteArray& buffer) const {
   QDataStream out(&buffer, QIODevice::WriteOnly);
   out.setByteOrder(QDataStream::LittleEndian);
   out.setVersion(QDataStream::Qt_5_2);
@@ -774,15 +806,11 @@ QDataStream& CGisItemRte::operator>>(QDataStream& stream) const {
   out << rating;
   out << keywords;
 
-  stream.writeRawData(MAGIC_RTE, MAGIC_SIZE);
-  stream << VER_RTE;
-  stream << qCompress(buffer, 9);
-
-  return stream;
+  return VER_RTE;
 }
 
 QDataStream& CGisItemOvlArea::operator<<(QDataStream& stream) {
-  quint8 version, tmp8;
+  quint8 version;
   QByteArray buffer;
   QIODevice* dev = stream.device();
   qint64 pos = dev->pos();
@@ -797,9 +825,14 @@ QDataStream& CGisItemOvlArea::operator<<(QDataStream& stream) {
 
   stream >> version;
   stream >> buffer;
-  buffer = qUncompress(buffer);
+  readItemData(qUncompress(buffer), version);
 
-  QDataStream in(&buffer, QIODevice::ReadOnly);
+  return stream;
+}
+
+void CGisItemOvlArea::readItemData(const QByteArray& buffer, quint8 version) {
+  quint8 tmp8;
+  QDataStream in(buffer);
   in.setByteOrder(QDataStream::LittleEndian);
   in.setVersion(QDataStream::Qt_5_2);
 
@@ -828,12 +861,19 @@ QDataStream& CGisItemOvlArea::operator<<(QDataStream& stream) {
   setColor(str2color(area.color));
   setText(CGisListWks::eColumnName, getName());
   setToolTip(CGisListWks::eColumnName, getInfo(IGisItem::eFeatureShowName));
-
-  return stream;
 }
 
 QDataStream& CGisItemOvlArea::operator>>(QDataStream& stream) const {
   QByteArray buffer;
+  writeItemData(buffer);
+
+  stream.writeRawData(MAGIC_AREA, MAGIC_SIZE);
+  stream << VER_AREA;
+  stream << qCompress(buffer, 9);
+  return stream;
+}
+
+quint8 CGisItemOvlArea::writeItemData(QByteArray& buffer) const {
   QDataStream out(&buffer, QIODevice::WriteOnly);
   out.setByteOrder(QDataStream::LittleEndian);
   out.setVersion(QDataStream::Qt_5_2);
@@ -855,11 +895,7 @@ QDataStream& CGisItemOvlArea::operator>>(QDataStream& stream) const {
   out << rating;
   out << keywords;
 
-  stream.writeRawData(MAGIC_AREA, MAGIC_SIZE);
-  stream << VER_AREA;
-  stream << qCompress(buffer, 9);
-
-  return stream;
+  return VER_AREA;
 }
 
 QDataStream& IGisProject::operator<<(QDataStream& stream) {
@@ -187,6 +187,11 @@ void CGisItemRte::setElevation(qreal ele, subpt_t& subpt, qreal& lastEle) {
 }
 
 void CGisItemRte::deriveSecondaryData() {
+  geometryChanged();
+
+  // a worker thread leaves the icons of the route points to setSymbol() called on the GUI thread
+  missingIcons = IGisProject::isLoadedByWorker();
+
   QPolygonF pos;
   QPolygonF ele;
   qreal north = -90;
@@ -213,7 +218,9 @@ void CGisItemRte::deriveSecondaryData() {
       pos << (QPointF(subpt.lon, subpt.lat) * DEG_TO_RAD);
       subpt.ele = NOINT;
     }
-    rtept.updateIcon();
+    if (!missingIcons) {
+      rtept.updateIcon();
+    }
   }
 
   ele.resize(pos.size());
@@ -301,6 +308,18 @@ void CGisItemRte::toTrack() {
 }
 
 void CGisItemRte::setSymbol() {
+  if (IGisProject::isLoadedByWorker()) {
+    // the icons are loaded by IGisProject::finishLoading() on the GUI thread
+    return;
+  }
+
+  if (missingIcons) {
+    for (rtept_t& rtept : rte.pts) {
+      rtept.updateIcon();
+    }
+    missingIcons = false;
+  }
+
   IGisItem::setIcon(QPixmap("://icons/48x48/Route.png").scaled(22, 22, Qt::KeepAspectRatio, Qt::SmoothTransformation));
 }
 
@@ -467,21 +486,25 @@ void CGisItemRte::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>
   QVector<QPixmap> icons;
   QVector<QPointF> focus;
 
-  for (const rtept_t& rtept : qAsConst(rte.pts)) {
-    QPointF pt(rtept.lon * DEG_TO_RAD, rtept.lat * DEG_TO_RAD);
-
-    gis->convertRad2Px(pt);
+  if (!gis->restoreLine(this, line)) {
+    for (const rtept_t& rtept : qAsConst(rte.pts)) {
+      line << QPointF(rtept.lon * DEG_TO_RAD, rtept.lat * DEG_TO_RAD);
+      for (const subpt_t& subpt : rtept.subpts) {
+        line << QPointF(subpt.lon * DEG_TO_RAD, subpt.lat * DEG_TO_RAD);
+      }
+    }
+    gis->storeLine(this, line);
+  }
 
-    line << pt;
+  qint32 idx = 0;
+  for (const rtept_t& rtept : qAsConst(rte.pts)) {
     points << 1;
     icons << rtept.icon;
     focus << rtept.focus;
 
-    blockedAreas << QRectF(pt - rtept.focus, rtept.icon.size());
+    blockedAreas << QRectF(line[idx++] - rtept.focus, rtept.icon.size());
     for (const subpt_t& subpt : rtept.subpts) {
-      QPointF pt(subpt.lon * DEG_TO_RAD, subpt.lat * DEG_TO_RAD);
-      gis->convertRad2Px(pt);
-      line << pt;
+      idx++;
       if (subpt.type != subpt_t::eTypeNone) {
         points << 2;
       } else {
@@ -187,6 +187,8 @@ class CGisItemRte : public IGisItem, public IGisLine {
   void deriveSecondaryData();
   void setElevation(qreal ele, subpt_t& subpt, qreal& lastEle);
   void setSymbol() override;
+  quint8 writeItemData(QByteArray& buffer) const override;
+  void readItemData(const QByteArray& buffer, quint8 version) override;
   void readRte(const QDomNode& xml, rte_t& rte);
   void readRteFromFit(CFitStream& stream);
   void readRouteDataFromGisLine(const SGisLine& l);
@@ -199,6 +201,8 @@ class CGisItemRte : public IGisItem, public IGisLine {
   QPen penForegroundFocus{Qt::magenta, 3, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin};
 
   rte_t rte;
+  /// the icons of the route points have not been loaded yet
+  bool missingIcons = false;
   QPolygonF line;
 
   const subpt_t* mouseMoveFocus = nullptr;
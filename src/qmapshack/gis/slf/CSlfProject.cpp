@@ -20,13 +20,12 @@
 
 #include <QtWidgets>
 
-#include "CMainWindow.h"
 #include "gis/CGisListWks.h"
 #include "gis/slf/CSlfReader.h"
 
 CSlfProject::CSlfProject(const QString& filename, bool readFile)
     : IGisProject(eTypeSlf, filename, (CGisListWks*)nullptr) {
-  setIcon(CGisListWks::eColumnIcon, QIcon("://icons/32x32/SlfProject.png"));
+  setProjectIcon("://icons/32x32/SlfProject.png");
   blockUpdateItems(true);
 
   valid = true;
@@ -34,8 +33,7 @@ CSlfProject::CSlfProject(const QString& filename, bool readFile)
     try {
       CSlfReader::readFile(filename, this);
     } catch (QString& errormsg) {
-      QMessageBox::critical(CMainWindow::getBestWidgetForParent(), tr("Failed to load file %1...").arg(filename),
-                            errormsg, QMessageBox::Abort);
+      showLoadError(filename, errormsg);
       valid = false;
     }
   } else {
@@ -27,6 +27,7 @@
 #include "gis/trk/CGisItemTrk.h"
 #include "gis/wpt/CGisItemWpt.h"
 #include "helpers/CSelectCopyAction.h"
+#include "helpers/CXmlDomStream.h"
 #include "version.h"
 
 CTcxProject::CTcxProject(const QString& filename, CGisListWks* parent) : IGisProject(eTypeTcx, filename, parent) {
@@ -39,7 +40,7 @@ CTcxProject::CTcxProject(const QString& filename, IDevice* parent) : IGisProject
 
 CTcxProject::CTcxProject(const QString& filename, const IGisProject* project, IDevice* parent)
     : IGisProject(eTypeGpx, filename, parent) {
-  setIcon(CGisListWks::eColumnIcon, QIcon("://icons/32x32/TcxProject.png"));
+  setProjectIcon("://icons/32x32/TcxProject.png");
   *(IGisProject*)this = *project;
   blockUpdateItems(project->blockUpdateItems());
 
@@ -59,7 +60,7 @@ CTcxProject::CTcxProject(const QString& filename, const IGisProject* project, ID
 }
 
 void CTcxProject::setup() {
-  setIcon(CGisListWks::eColumnIcon, QIcon("://icons/32x32/TcxProject.png"));
+  setProjectIcon("://icons/32x32/TcxProject.png");
   blockUpdateItems(true);
   loadTcx(filename);
   blockUpdateItems(false);
@@ -70,8 +71,7 @@ void CTcxProject::loadTcx(const QString& filename) {
   try {
     loadTcx(filename, this);
   } catch (QString& errormsg) {
-    QMessageBox::critical(CMainWindow::getBestWidgetForParent(), tr("Failed to load file %1...").arg(filename),
-                          errormsg, QMessageBox::Abort);
+    showLoadError(filename, errormsg);
     valid = false;
   }
 }
@@ -92,26 +92,53 @@ void CTcxProject::loadTcx(const QString& filename, CTcxProject* project) {
     throw tr("Failed to open %1").arg(filename);
   }
 
-  QDomDocument xml;
-  QString msg;
-  int line;
-  int column;
-  if (!xml.setContent(&file, false, &msg, &line, &column)) {
-    file.close();
-    throw tr("Failed to read: %1\nline %2, column %3:\n %4").arg(filename).arg(line).arg(column).arg(msg);
+  // The file is read as stream. Activities and courses are picked up
+  // wherever they are placed in the document tree.
+  QXmlStreamReader xml(&file);
+  xml.setNamespaceProcessing(false);
+
+  if (!xml.readNextStartElement() || xml.qualifiedName() != "TrainingCenterDatabase") {
+    if (xml.hasError()) {
+      throw tr("Failed to read: %1\nline %2, column %3:\n %4")
+          .arg(filename)
+          .arg(xml.lineNumber())
+          .arg(xml.columnNumber())
+          .arg(xml.errorString());
+    }
+    throw tr("Not a TCX file: %1").arg(filename);
   }
-  file.close();
 
-  QDomElement xmlTcx = xml.documentElement();
-  if (xmlTcx.tagName() != "TrainingCenterDatabase") {
-    throw tr("Not a TCX file: %1").arg(filename);
+  bool hasActivityOrCourse = false;
+  bool hasWorkout = false;
+  while (!xml.atEnd()) {
+    if (xml.readNext() != QXmlStreamReader::StartElement) {
+      continue;
+    }
+
+    const QStringRef& tag = xml.qualifiedName();
+    if (tag == "Activity") {
+      project->loadActivity(xml);
+      hasActivityOrCourse = true;
+    } else if (tag == "Course") {
+      project->loadCourse(xml);
+      hasActivityOrCourse = true;
+    } else if (tag == "Workout") {
+      hasWorkout = true;
+      xml.skipCurrentElement();
+    }
   }
+  file.close();
 
-  const QDomNodeList& tcxActivities = xmlTcx.elementsByTagName("Activity");
-  const QDomNodeList& tcxCourses = xmlTcx.elementsByTagName("Course");
+  if (xml.hasError()) {
+    throw tr("Failed to read: %1\nline %2, column %3:\n %4")
+        .arg(filename)
+        .arg(xml.lineNumber())
+        .arg(xml.columnNumber())
+        .arg(xml.errorString());
+  }
 
-  if (!tcxActivities.item(0).isElement() && !tcxCourses.item(0).isElement()) {
-    if (xmlTcx.elementsByTagName("Workout").item(0).isElement()) {
+  if (!hasActivityOrCourse) {
+    if (hasWorkout) {
       throw tr(
           "This TCX file contains at least 1 workout, but neither an activity nor a course. "
           "As workouts do not contain position data, they can not be imported to QMapShack.");
@@ -120,189 +147,160 @@ void CTcxProject::loadTcx(const QString& filename, CTcxProject* project) {
     }
   }
 
-  for (int i = 0; i < tcxActivities.count(); i++) {
-    project->loadActivity(tcxActivities.item(i));
-  }
-
-  for (int i = 0; i < tcxCourses.count(); i++) {
-    project->loadCourse(tcxCourses.item(i));
-  }
-
   project->sortItems();
   project->setupName(QFileInfo(filename).completeBaseName().replace("_", " "));
   project->setToolTip(CGisListWks::eColumnName, project->getInfo());
   project->valid = true;
 }
 
-void CTcxProject::loadActivity(const QDomNode& activityRootNode) {
-  if (activityRootNode.isElement()) {
-    CTrackData trk;
-
-    trk.name = activityRootNode.toElement()
-                   .elementsByTagName("Id")
-                   .item(0)
-                   .firstChild()
-                   .nodeValue();  // activities do not have a "Name" but an "Id" instead (containing start date-time)
-
-    const QDomNodeList& tcxLaps = activityRootNode.toElement().elementsByTagName("Lap");
-
-    trk.segs.resize(tcxLaps.count());
-    for (int i = 0; i < tcxLaps.count(); i++)  // browse laps
-    {
-      CTrackData::trkseg_t* seg = &(trk.segs[i]);
-
-      const QDomNodeList& tcxLapTrackpts = tcxLaps.item(i).toElement().elementsByTagName("Trackpoint");
-
-      for (int j = 0; j < tcxLapTrackpts.count(); j++)  // browse trackpoints
-      {
-        const QDomElement& positionElement =
-            tcxLapTrackpts.item(j).toElement().elementsByTagName("Position").item(0).toElement();
-
-        if (positionElement
-                .isElement())  // if this trackpoint contains position, i.e. GPSr was able to capture position
-        {
-          CTrackData::trkpt_t trkpt;
-
-          IUnit::parseTimestamp(
-              tcxLapTrackpts.item(j).toElement().elementsByTagName("Time").item(0).firstChild().nodeValue(),
-              trkpt.time);
-
-          trkpt.lat = positionElement.elementsByTagName("LatitudeDegrees").item(0).firstChild().nodeValue().toDouble();
-          trkpt.lon = positionElement.elementsByTagName("LongitudeDegrees").item(0).firstChild().nodeValue().toDouble();
-          trkpt.ele = tcxLapTrackpts.item(j)
-                          .toElement()
-                          .elementsByTagName("AltitudeMeters")
-                          .item(0)
-                          .firstChild()
-                          .nodeValue()
-                          .toDouble();
-
-          const QDomElement& HRElement =
-              tcxLapTrackpts.item(j).toElement().elementsByTagName("HeartRateBpm").item(0).toElement();
-          if (HRElement.isElement())  // if this trackpoint contains heartrate data, i.e. heartrate sensor data has been
-                                      // captured
-          {
-            trkpt.extensions["gpxtpx:TrackPointExtension|gpxtpx:hr"] =
-                HRElement.elementsByTagName("Value").item(0).firstChild().nodeValue().toDouble();
-          }
-
-          const QDomElement& CADElement =
-              tcxLapTrackpts.item(j).toElement().elementsByTagName("Cadence").item(0).toElement();
-          if (CADElement
-                  .isElement())  // if this trackpoint contains cadence data, i.e. cadence sensor data has been captured
-          {
-            trkpt.extensions["gpxtpx:TrackPointExtension|gpxtpx:cad"] = CADElement.firstChild().nodeValue().toDouble();
-          }
+static void readPosition(QXmlStreamReader& xml, qreal& lat, qreal& lon) {
+  while (xml.readNextStartElement()) {
+    const QStringRef& tag = xml.qualifiedName();
+    if (tag == "LatitudeDegrees") {
+      lat = xml.readElementText().toDouble();
+    } else if (tag == "LongitudeDegrees") {
+      lon = xml.readElementText().toDouble();
+    } else {
+      xml.skipCurrentElement();
+    }
+  }
+}
 
-          seg->pts.append(trkpt);  // 1 TCX lap gives 1 GPX track segment
+/**
+   @brief Read a <Trackpoint> element
+   @return False if the trackpoint has no position, i.e. the GPSr was not able to capture a position
+ */
+static bool readTrackpoint(QXmlStreamReader& xml, CTrackData::trkpt_t& trkpt) {
+  bool hasPosition = false;
+  trkpt.lat = 0;
+  trkpt.lon = 0;
+  trkpt.ele = 0;
+
+  while (xml.readNextStartElement()) {
+    const QStringRef& tag = xml.qualifiedName();
+    if (tag == "Time") {
+      IUnit::parseTimestamp(xml.readElementText(), trkpt.time);
+    } else if (tag == "Position") {
+      readPosition(xml, trkpt.lat, trkpt.lon);
+      hasPosition = true;
+    } else if (tag == "AltitudeMeters") {
+      trkpt.ele = xml.readElementText().toDouble();
+    } else if (tag == "HeartRateBpm") {
+      // if this trackpoint contains heartrate data, i.e. heartrate sensor data has been captured
+      qreal value = 0;
+      while (xml.readNextStartElement()) {
+        if (xml.qualifiedName() == "Value") {
+          value = xml.readElementText().toDouble();
+        } else {
+          xml.skipCurrentElement();
         }
       }
+      trkpt.extensions["gpxtpx:TrackPointExtension|gpxtpx:hr"] = value;
+    } else if (tag == "Cadence") {
+      // if this trackpoint contains cadence data, i.e. cadence sensor data has been captured
+      trkpt.extensions["gpxtpx:TrackPointExtension|gpxtpx:cad"] = xml.readElementText().toDouble();
+    } else {
+      xml.skipCurrentElement();
     }
-
-    CGisItemTrk* trkItem = new CGisItemTrk(trk, this);
-    trackTypes.insert(trkItem->getKey().item, eActivity);  // store the track type according to its key
   }
-}
-
-void CTcxProject::loadCourse(const QDomNode& courseRootNode) {
-  if (courseRootNode.isElement()) {
-    CTrackData trk;
-
-    trk.name = courseRootNode.toElement().elementsByTagName("Name").item(0).firstChild().nodeValue();
-    trk.segs.resize(1);
-    CTrackData::trkseg_t* seg = &(trk.segs[0]);
 
-    const QDomNodeList& tcxTrackpts = courseRootNode.toElement().elementsByTagName("Trackpoint");
+  return hasPosition;
+}
 
-    for (int i = 0; i < tcxTrackpts.count(); i++)  // browse trackpoints
-    {
-      const QDomElement& positionElement =
-          tcxTrackpts.item(i).toElement().elementsByTagName("Position").item(0).toElement();
+/// read all <Trackpoint> elements of a <Track> element into a segment
+static void readTrack(QXmlStreamReader& xml, CTrackData::trkseg_t& seg) {
+  while (xml.readNextStartElement()) {
+    if (xml.qualifiedName() == "Trackpoint") {
+      CTrackData::trkpt_t trkpt;
+      if (readTrackpoint(xml, trkpt)) {
+        seg.pts.append(trkpt);
+      }
+    } else {
+      xml.skipCurrentElement();
+    }
+  }
+}
 
-      if (positionElement.isElement())  // if this trackpoint contains position, i.e. GPSr was able to capture position
-      {
-        CTrackData::trkpt_t trkpt;
-
-        IUnit::parseTimestamp(
-            tcxTrackpts.item(i).toElement().elementsByTagName("Time").item(0).firstChild().nodeValue(), trkpt.time);
-
-        trkpt.lat = positionElement.elementsByTagName("LatitudeDegrees").item(0).firstChild().nodeValue().toDouble();
-        trkpt.lon = positionElement.elementsByTagName("LongitudeDegrees").item(0).firstChild().nodeValue().toDouble();
-        trkpt.ele = tcxTrackpts.item(i)
-                        .toElement()
-                        .elementsByTagName("AltitudeMeters")
-                        .item(0)
-                        .firstChild()
-                        .nodeValue()
-                        .toDouble();
-
-        const QDomElement& HRElement =
-            tcxTrackpts.item(i).toElement().elementsByTagName("HeartRateBpm").item(0).toElement();
-        if (HRElement.isElement())  // if this trackpoint contains heartrate data, i.e. heartrate sensor data has been
-                                    // captured
-        {
-          trkpt.extensions["gpxtpx:TrackPointExtension|gpxtpx:hr"] =
-              HRElement.elementsByTagName("Value").item(0).firstChild().nodeValue().toDouble();
+void CTcxProject::loadActivity(QXmlStreamReader& xml) {
+  CTrackData trk;
+
+  while (xml.readNextStartElement()) {
+    const QStringRef& tag = xml.qualifiedName();
+    if (tag == "Id") {
+      // activities do not have a "Name" but an "Id" instead (containing start date-time)
+      trk.name = xml.readElementText();
+    } else if (tag == "Lap") {
+      // 1 TCX lap gives 1 GPX track segment
+      trk.segs.append(CTrackData::trkseg_t());
+      CTrackData::trkseg_t& seg = trk.segs.last();
+      while (xml.readNextStartElement()) {
+        if (xml.qualifiedName() == "Track") {
+          readTrack(xml, seg);
+        } else {
+          xml.skipCurrentElement();
         }
+      }
+    } else {
+      xml.skipCurrentElement();
+    }
+  }
 
-        const QDomElement& CADElement =
-            tcxTrackpts.item(i).toElement().elementsByTagName("Cadence").item(0).toElement();
-        if (CADElement
-                .isElement())  // if this trackpoint contains cadence data, i.e. cadence sensor data has been captured
-        {
-          trkpt.extensions["gpxtpx:TrackPointExtension|gpxtpx:cad"] = CADElement.firstChild().nodeValue().toDouble();
-        }
+  CGisItemTrk* trkItem = new CGisItemTrk(trk, this);
+  trackTypes.insert(trkItem->getKey().item, eActivity);  // store the track type according to its key
+}
 
-        seg->pts.append(trkpt);
+void CTcxProject::loadCourse(QXmlStreamReader& xml) {
+  struct coursept_t {
+    QString name;
+    qreal lat = 0;
+    qreal lon = 0;
+    qreal ele = 0;
+    QString icon;
+  };
+
+  CTrackData trk;
+  trk.segs.resize(1);
+  CTrackData::trkseg_t& seg = trk.segs[0];
+
+  QList<coursept_t> coursePts;
+
+  while (xml.readNextStartElement()) {
+    const QStringRef& tag = xml.qualifiedName();
+    if (tag == "Name") {
+      trk.name = xml.readElementText();
+    } else if (tag == "Track") {
+      readTrack(xml, seg);
+    } else if (tag == "CoursePoint") {
+      coursept_t pt;
+      while (xml.readNextStartElement()) {
+        const QStringRef& ptTag = xml.qualifiedName();
+        if (ptTag == "Name") {
+          pt.name = xml.readElementText();
+        } else if (ptTag == "Position") {
+          readPosition(xml, pt.lat, pt.lon);
+        } else if (ptTag == "AltitudeMeters") {
+          pt.ele = xml.readElementText().toDouble();
+        } else if (ptTag == "PointType") {
+          // there is no "icon" in course points ;  "PointType" is used instead (can be
+          // "turn left", "turn right", etc... See list in
+          // http://www8.garmin.com/xmlschemas/TrainingCenterDatabasev2.xsd)
+          pt.icon = xml.readElementText();
+        } else {
+          xml.skipCurrentElement();
+        }
       }
+      coursePts << pt;
+    } else {
+      xml.skipCurrentElement();
     }
+  }
 
-    CGisItemTrk* trkItem = new CGisItemTrk(trk, this);
-    trackTypes.insert(trkItem->getKey().item, eCourse);  // store the track type according to its key
-
-    const QDomNodeList& tcxCoursePts = courseRootNode.toElement().elementsByTagName("CoursePoint");
-    for (int i = 0; i < tcxCoursePts.count(); i++)  // browse course points
-    {
-      QString name = tcxCoursePts.item(i).toElement().elementsByTagName("Name").item(0).firstChild().nodeValue();
-      qreal lat = tcxCoursePts.item(i)
-                      .toElement()
-                      .elementsByTagName("Position")
-                      .item(0)
-                      .toElement()
-                      .elementsByTagName("LatitudeDegrees")
-                      .item(0)
-                      .firstChild()
-                      .nodeValue()
-                      .toDouble();
-      qreal lon = tcxCoursePts.item(i)
-                      .toElement()
-                      .elementsByTagName("Position")
-                      .item(0)
-                      .toElement()
-                      .elementsByTagName("LongitudeDegrees")
-                      .item(0)
-                      .firstChild()
-                      .nodeValue()
-                      .toDouble();
-      qreal ele = tcxCoursePts.item(i)
-                      .toElement()
-                      .elementsByTagName("AltitudeMeters")
-                      .item(0)
-                      .firstChild()
-                      .nodeValue()
-                      .toDouble();
-      QString icon = tcxCoursePts.item(i)
-                         .toElement()
-                         .elementsByTagName("PointType")
-                         .item(0)
-                         .firstChild()
-                         .nodeValue();  // there is no "icon" in course points ;  "PointType" is used instead (can be
-                                        // "turn left", "turn right", etc... See list in
-                                        // http://www8.garmin.com/xmlschemas/TrainingCenterDatabasev2.xsd)
-
-      new CGisItemWpt(QPointF(lon, lat), ele, QDateTime::currentDateTimeUtc(), name, icon,
-                      this);  // 1 TCX course point gives 1 GPX waypoint
-    }
+  CGisItemTrk* trkItem = new CGisItemTrk(trk, this);
+  trackTypes.insert(trkItem->getKey().item, eCourse);  // store the track type according to its key
+
+  for (const coursept_t& pt : qAsConst(coursePts)) {
+    // 1 TCX course point gives 1 GPX waypoint
+    new CGisItemWpt(QPointF(pt.lon, pt.lat), pt.ele, QDateTime::currentDateTimeUtc(), pt.name, pt.icon, this);
   }
 }
 
@@ -321,13 +319,19 @@ bool CTcxProject::saveAs(const QString& fn, IGisProject& project) {
     file.open(QIODevice::ReadOnly);
     bool createdByQMS = false;
 
-    // load file content to xml document
-    QDomDocument xmlTcx;
-    if (xmlTcx.setContent(&file, false)) {
-      const QDomNodeList& tcxAuthor = xmlTcx.elementsByTagName("Author");
-      if (tcxAuthor.item(0).isElement()) {
-        const QDomNodeList& tcxAuthorName = tcxAuthor.item(0).toElement().elementsByTagName("Name");
-        createdByQMS = tcxAuthorName.item(0).firstChild().nodeValue() == "QMapShack";
+    // search the file for the first <Author> element and test it's name
+    QXmlStreamReader xml(&file);
+    xml.setNamespaceProcessing(false);
+    while (!xml.atEnd()) {
+      if ((xml.readNext() == QXmlStreamReader::StartElement) && (xml.qualifiedName() == "Author")) {
+        while (xml.readNextStartElement()) {
+          if (xml.qualifiedName() == "Name") {
+            createdByQMS = xml.readElementText() == "QMapShack";
+            break;
+          }
+          xml.skipCurrentElement();
+        }
+        break;
       }
     }
 
@@ -458,24 +462,6 @@ bool CTcxProject::saveAs(const QString& fn, IGisProject& project) {
   }
   project.blockUpdateItems(false);
 
-  QDomNode activitiesNode = doc.createElement("Activities");
-  if (activityTrks.size() != 0) {
-    tcx.appendChild(activitiesNode);
-  }
-  for (CGisItemTrk* trkToBeSaved : qAsConst(activityTrks)) {
-    trkToBeSaved->saveTCXactivity(activitiesNode);
-  }
-
-  QDomNode coursesNode = doc.createElement("Courses");
-  if (courseTrks.size() != 0) {
-    tcx.appendChild(coursesNode);
-  }
-  for (CGisItemTrk* trkToBeSaved : qAsConst(courseTrks)) {
-    trkToBeSaved->saveTCXcourse(coursesNode);
-  }
-
-  saveAuthor(tcx);
-
   bool res = true;
   QString msg;
 
@@ -494,15 +480,47 @@ bool CTcxProject::saveAs(const QString& fn, IGisProject& project) {
     } else {
       throw msg;
     }
-    res = false;
+    return false;
   }
-  QTextStream out(&file);
-  out.setCodec("UTF-8");
-  out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\" ?>" << Qt::endl;
 
-  out << doc.toString();
+  QXmlStreamWriter xml(&file);
+  xml.setAutoFormatting(true);
+  xml.setAutoFormattingIndent(1);
+  xml.writeStartDocument("1.0", false);
+
+  xml.writeStartElement(tcx.tagName());
+  CXmlDomStream::writeAttributes(xml, tcx);
+
+  // Each track is converted into a DOM tree of its own and written
+  // right away. Thus there is never more than one track in memory.
+  if (activityTrks.size() != 0) {
+    xml.writeStartElement("Activities");
+    for (CGisItemTrk* trkToBeSaved : qAsConst(activityTrks)) {
+      QDomNode activitiesNode = doc.createElement("Activities");
+      trkToBeSaved->saveTCXactivity(activitiesNode);
+      CXmlDomStream::writeChildren(xml, activitiesNode);
+    }
+    xml.writeEndElement();
+  }
+
+  if (courseTrks.size() != 0) {
+    xml.writeStartElement("Courses");
+    for (CGisItemTrk* trkToBeSaved : qAsConst(courseTrks)) {
+      QDomNode coursesNode = doc.createElement("Courses");
+      trkToBeSaved->saveTCXcourse(coursesNode);
+      CXmlDomStream::writeChildren(xml, coursesNode);
+    }
+    xml.writeEndElement();
+  }
+
+  saveAuthor(tcx);
+  CXmlDomStream::writeChildren(xml, tcx);
+
+  xml.writeEndElement();
+  xml.writeEndDocument();
+
   file.close();
-  if (file.error() != QFile::NoError) {
+  if (xml.hasError() || (file.error() != QFile::NoError)) {
     if (QThread::currentThread() == qApp->thread()) {
       CCanvasCursorLock cursorLock(Qt::ArrowCursor, __func__);
       msg = tr("Failed to write file '%1'").arg(_fn_);
@@ -21,6 +21,8 @@
 
 #include "gis/prj/IGisProject.h"
 
+class QXmlStreamReader;
+
 class CTcxProject : public IGisProject {
   Q_DECLARE_TR_FUNCTIONS(CTcxProject)
  public:
@@ -42,8 +44,8 @@ class CTcxProject : public IGisProject {
  private:
   void setup();
   void loadTcx(const QString& filename);
-  void loadActivity(const QDomNode& activityRootNode);
-  void loadCourse(const QDomNode& courseRootNode);
+  void loadActivity(QXmlStreamReader& xml);
+  void loadCourse(QXmlStreamReader& xml);
 
   static void saveAuthor(QDomNode& nodeToAttachAuthor);
 
@@ -139,13 +139,6 @@ void CActivityTrk::update() {
     lastTrkpt = &pt;
     if (pt.getAct() != lastAct) {
       if (startTrkpt != nullptr) {
-        summary_t& summary = activitySummary[lastAct];
-        summary.distance += lastTrkpt->distance - startTrkpt->distance;
-        summary.ascent += lastTrkpt->ascent - startTrkpt->ascent;
-        summary.descent += lastTrkpt->descent - startTrkpt->descent;
-        summary.ellapsedSeconds += lastTrkpt->elapsedSeconds - startTrkpt->elapsedSeconds;
-        summary.ellapsedSecondsMoving += lastTrkpt->elapsedSecondsMoving - startTrkpt->elapsedSecondsMoving;
-
         activityRanges << range_t();
         range_t& activity = activityRanges.last();
 
@@ -163,13 +156,6 @@ void CActivityTrk::update() {
     return;
   }
 
-  summary_t& summary = activitySummary[lastAct];
-  summary.distance += lastTrkpt->distance - startTrkpt->distance;
-  summary.ascent += lastTrkpt->ascent - startTrkpt->ascent;
-  summary.descent += lastTrkpt->descent - startTrkpt->descent;
-  summary.ellapsedSeconds += lastTrkpt->elapsedSeconds - startTrkpt->elapsedSeconds;
-  summary.ellapsedSecondsMoving += lastTrkpt->elapsedSecondsMoving - startTrkpt->elapsedSecondsMoving;
-
   activityRanges << range_t();
   range_t& activity = activityRanges.last();
 
@@ -177,6 +163,8 @@ void CActivityTrk::update() {
   activity.idxTotalEnd = lastTrkpt->idxTotal;
   activity.activity = lastAct;
 
+  updateSummary();
+
   //    for(int i = 0; i < 9; i++)
   //    {
   //        summary_t& stat   = summaries[i];
@@ -189,6 +177,26 @@ void CActivityTrk::update() {
   //    }
 }
 
+void CActivityTrk::updateSummary() {
+  activitySummary.clear();
+
+  const CTrackData& data = trk->getTrackData();
+  for (const range_t& range : qAsConst(activityRanges)) {
+    const CTrackData::trkpt_t* startTrkpt = data.getTrkPtByTotalIndex(range.idxTotalBeg);
+    const CTrackData::trkpt_t* lastTrkpt = data.getTrkPtByTotalIndex(range.idxTotalEnd);
+    if ((startTrkpt == nullptr) || (lastTrkpt == nullptr)) {
+      continue;
+    }
+
+    summary_t& summary = activitySummary[range.activity];
+    summary.distance += lastTrkpt->distance - startTrkpt->distance;
+    summary.ascent += lastTrkpt->ascent - startTrkpt->ascent;
+    summary.descent += lastTrkpt->descent - startTrkpt->descent;
+    summary.ellapsedSeconds += lastTrkpt->elapsedSeconds - startTrkpt->elapsedSeconds;
+    summary.ellapsedSecondsMoving += lastTrkpt->elapsedSecondsMoving - startTrkpt->elapsedSecondsMoving;
+  }
+}
+
 void CActivityTrk::printSummary(QString& str) const { printSummary(activitySummary, allActivities, str); }
 
 void CActivityTrk::printSummary(const QMap<trkact_t, summary_t>& summary, const QSet<trkact_t>& acts, QString& str) {
@@ -125,6 +125,14 @@ class CActivityTrk {
    */
   void update();
 
+  /**
+     @brief Update the summary array from the activity ranges found by update()
+
+     Use this if the track's distance, time or elevation changed, but not the
+     activities of its points.
+   */
+  void updateSummary();
+
   /**
      @brief Update track point flags
 
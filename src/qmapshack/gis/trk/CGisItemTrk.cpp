@@ -190,6 +190,19 @@ CGisItemTrk::CGisItemTrk(const QDomNode& xml, IGisProject* project)
   checkForInvalidPoints();
 }
 
+CGisItemTrk::CGisItemTrk(QXmlStreamReader& xml, IGisProject* project)
+    : IGisItem(project, eTypeTrk, project->childCount()) {
+  // --- start read and process data ----
+  setColor(penForeground.color());
+  readTrk(xml, trk);
+  // --- stop read and process data ----
+
+  setupHistory();
+  updateDecoration(eMarkNone, eMarkNone);
+
+  checkForInvalidPoints();
+}
+
 CGisItemTrk::CGisItemTrk(const QString& filename, IGisProject* project)
     : IGisItem(project, eTypeTrk, project->childCount()) {
   // --- start read and process data ----
@@ -301,7 +314,9 @@ void CGisItemTrk::setDataFromPolyline(const SGisLine& l) {
    */
   resetInternalData();
 
-  readTrackDataFromGisLine(l);
+  if (!moveTrackDataFromGisLine(l)) {
+    readTrackDataFromGisLine(l);
+  }
 
   flags |= eFlagTainted;
   changed(tr("Changed trackpoints, sacrificed all previous data."), "://icons/48x48/LineMove.png");
@@ -333,6 +348,76 @@ void CGisItemTrk::readTrackDataFromGisLine(const SGisLine& l) {
   deriveSecondaryData();
 }
 
+// true if the point holds nothing but the data CTrackData::readFrom() creates from a polyline
+static bool isLinePoint(const CTrackData::trkpt_t& pt) {
+  return ((pt.flags & ~quint32(CTrackData::trkpt_t::eFlagSubpt | CTrackData::trkpt_t::eFlagActivity)) == 0) &&
+         (pt.activity == CTrackData::trkpt_t::eAct20None) && !pt.time.isValid() && (pt.magvar == NOINT) &&
+         (pt.geoidheight == NOINT) && pt.name.isEmpty() && pt.cmt.isEmpty() && pt.desc.isEmpty() &&
+         pt.src.isEmpty() && pt.links.isEmpty() && pt.sym.isEmpty() && pt.type.isEmpty() && pt.fix.isEmpty() &&
+         (pt.sat == NOINT) && (pt.hdop == NOINT) && (pt.vdop == NOINT) && (pt.pdop == NOINT) &&
+         (pt.ageofdgpsdata == NOINT) && (pt.dgpsid == NOINT) && pt.keyWpt.item.isEmpty() && pt.extensions.isEmpty();
+}
+
+bool CGisItemTrk::moveTrackDataFromGisLine(const SGisLine& l) {
+  QMutexLocker lock(&mutexItems);
+
+  if (trk.segs.size() != 1) {
+    return false;
+  }
+
+  // the points of the polyline in the order CTrackData::readFrom() stores them and if they are subpoints
+  QVector<QPair<const IGisLine::subpt_t*, bool>> ptsLine;
+  for (const IGisLine::point_t& pt : l) {
+    ptsLine << qMakePair(static_cast<const IGisLine::subpt_t*>(&pt), false);
+    for (const IGisLine::subpt_t& sub : pt.subpts) {
+      ptsLine << qMakePair(&sub, true);
+    }
+  }
+
+  QVector<CTrackData::trkpt_t>& pts = trk.segs.first().pts;
+  const qint32 N = pts.size();
+  if ((N == 0) || (ptsLine.size() != N)) {
+    return false;
+  }
+
+  qint32 idx1 = NOIDX;
+  qint32 idx2 = NOIDX;
+  for (qint32 idx = 0; idx < N; idx++) {
+    const CTrackData::trkpt_t& trkpt = qAsConst(pts)[idx];
+    const IGisLine::subpt_t& pt = *ptsLine[idx].first;
+
+    // the first and the last point are never subpoints, see consolidatePoints()
+    const bool isSubpt = ptsLine[idx].second && (idx != 0) && (idx != N - 1);
+    if (!isLinePoint(trkpt) || (trkpt.hasFlag(CTrackData::trkpt_t::eFlagSubpt) != isSubpt)) {
+      return false;
+    }
+
+    const QPointF& coord = trkpt.radPoint();
+    if ((coord.x() != pt.coord.x()) || (coord.y() != pt.coord.y()) || (trkpt.ele != pt.ele)) {
+      if (idx1 == NOIDX) {
+        idx1 = idx;
+      }
+      idx2 = idx;
+    }
+  }
+
+  if (idx1 == NOIDX) {
+    return true;
+  }
+
+  for (qint32 idx = idx1; idx <= idx2; idx++) {
+    CTrackData::trkpt_t& trkpt = pts[idx];
+    const IGisLine::subpt_t& pt = *ptsLine[idx].first;
+
+    trkpt.lon = pt.coord.x() * RAD_TO_DEG;
+    trkpt.lat = pt.coord.y() * RAD_TO_DEG;
+    trkpt.ele = pt.ele;
+  }
+
+  deriveSecondaryData(idx1, idx2);
+  return true;
+}
+
 void CGisItemTrk::registerVisual(INotifyTrk* visual) { registeredVisuals << visual; }
 
 void CGisItemTrk::unregisterVisual(INotifyTrk* visual) { registeredVisuals.remove(visual); }
@@ -754,8 +839,9 @@ static qint32 getIdxPointCloseBy(const QPoint& pos, const QPolygonF& line) {
 QPointF CGisItemTrk::getPointCloseBy(const QPoint& screenPos) {
   QMutexLocker lock(&mutexItems);
 
-  qint32 bestIdx = getIdxPointCloseBy(screenPos, lineSimple);
-  return (NOIDX == bestIdx) ? NOPOINTF : lineSimple[bestIdx];
+  const QPolygonF& line = getLineSimple();
+  qint32 bestIdx = getIdxPointCloseBy(screenPos, line);
+  return (NOIDX == bestIdx) ? NOPOINTF : line[bestIdx];
 }
 
 bool CGisItemTrk::isRangeSelected() const { return mouseRange1 != mouseRange2; }
@@ -806,6 +892,12 @@ void CGisItemTrk::updateExtremaAndExtensions() {
     updateExtrema(extremaProgress, pt.distance, pos);
   }
 
+  addInternalExtrema(extremaEle, extremaSlope, extremaSpeed, extremaProgress);
+  existingExtensions.subtract(nonRealExtensions);
+}
+
+void CGisItemTrk::addInternalExtrema(const limits_t& extremaEle, const limits_t& extremaSlope,
+                                     const limits_t& extremaSpeed, const limits_t& extremaProgress) {
   if (extremaEle.min < extremaEle.max) {
     existingExtensions << CKnownExtension::internalEle;
     extrema[CKnownExtension::internalEle] = extremaEle;
@@ -827,10 +919,203 @@ void CGisItemTrk::updateExtremaAndExtensions() {
     existingExtensions << CKnownExtension::internalProgress;
     extrema[CKnownExtension::internalProgress] = extremaProgress;
   }
+}
+
+static CGisItemTrk::limits_t limitsFromTree(const CMinMaxTree& tree, const QVector<CTrackData::trkpt_t*>& alltrk) {
+  CGisItemTrk::limits_t limits;
+
+  const qint32 idxMin = tree.getIdxMin();
+  if (idxMin != NOIDX) {
+    limits.setMin(tree.value(idxMin), {alltrk[idxMin]->lon, alltrk[idxMin]->lat});
+  }
+
+  const qint32 idxMax = tree.getIdxMax();
+  if (idxMax != NOIDX) {
+    limits.setMax(tree.value(idxMax), {alltrk[idxMax]->lon, alltrk[idxMax]->lat});
+  }
 
+  return limits;
+}
+
+void CGisItemTrk::updateExtremaFromDeriveState(const QVector<CTrackData::trkpt_t*>& alltrk,
+                                               const QVector<CTrackData::trkpt_t*>& lintrk) {
+  extrema = QHash<QString, limits_t>();
+  existingExtensions = QSet<QString>();
+
+  for (auto it = cntRealExtensions.cbegin(); it != cntRealExtensions.cend(); ++it) {
+    if (it.value() > 0) {
+      existingExtensions << it.key();
+      extrema[it.key()] = limitsFromTree(treeExtensions[it.key()], alltrk);
+    }
+  }
+
+  QSet<QString> nonRealExtensions;
+  for (auto it = cntNonRealExtensions.cbegin(); it != cntNonRealExtensions.cend(); ++it) {
+    if (it.value() > 0) {
+      nonRealExtensions << it.key();
+    }
+  }
+
+  // the progress is monotonic: the minimum is at the first point, the
+  // maximum at the first point reaching the total distance
+  limits_t extremaProgress;
+  const CTrackData::trkpt_t* first = lintrk.first();
+  extremaProgress.setMin(first->distance, {first->lon, first->lat});
+
+  qint32 p = lintrk.size() - 1;
+  while ((p > 0) && (lintrk[p - 1]->distance == lintrk[p]->distance)) {
+    --p;
+  }
+  extremaProgress.setMax(lintrk[p]->distance, {lintrk[p]->lon, lintrk[p]->lat});
+
+  addInternalExtrema(limitsFromTree(treeEle, alltrk), limitsFromTree(treeSlope, alltrk),
+                     limitsFromTree(treeSpeed, alltrk), extremaProgress);
   existingExtensions.subtract(nonRealExtensions);
 }
 
+void CGisItemTrk::buildDeriveState(const QVector<CTrackData::trkpt_t*>& alltrk) {
+  const qint32 N = alltrk.size();
+  QVector<qreal> lon(N, NOFLOAT);
+  QVector<qreal> lat(N, NOFLOAT);
+  QVector<qreal> ele(N, NOFLOAT);
+  QVector<qreal> slope(N, NOFLOAT);
+  QVector<qreal> speed(N, NOFLOAT);
+  QHash<QString, QVector<qreal>> extensions;
+
+  cntValidBits.fill(0, 32);
+  cntInvalidPoints = 0;
+  cntRealExtensions.clear();
+  cntNonRealExtensions.clear();
+  treeExtensions.clear();
+  hasDeriveState = true;
+
+  for (qint32 idx = 0; idx < N; idx++) {
+    const CTrackData::trkpt_t& trkpt = *alltrk[idx];
+    if (trkpt.isHidden()) {
+      continue;
+    }
+
+    lon[idx] = trkpt.lon;
+    lat[idx] = trkpt.lat;
+    ele[idx] = trkpt.ele;
+    slope[idx] = trkpt.slope1;
+    speed[idx] = trkpt.speed;
+    countValid(trkpt.valid, 1);
+
+    for (auto it = trkpt.extensions.cbegin(); it != trkpt.extensions.cend(); ++it) {
+      bool isReal = false;
+      qreal val = it.value().toReal(&isReal);
+
+      if (isReal) {
+        QVector<qreal>& values = extensions[it.key()];
+        if (values.isEmpty()) {
+          values.fill(NOFLOAT, N);
+        }
+        values[idx] = val;
+        cntRealExtensions[it.key()]++;
+      } else {
+        cntNonRealExtensions[it.key()]++;
+      }
+    }
+  }
+
+  treeLon.build(lon);
+  treeLat.build(lat);
+  treeEle.build(ele);
+  treeSlope.build(slope);
+  treeSpeed.build(speed);
+  for (auto it = extensions.cbegin(); it != extensions.cend(); ++it) {
+    treeExtensions[it.key()].build(it.value());
+  }
+}
+
+void CGisItemTrk::resetDeriveState() {
+  hasDeriveState = false;
+  eleRefs.clear();
+  cntValidBits.clear();
+  treeLon.clear();
+  treeLat.clear();
+  treeEle.clear();
+  treeSlope.clear();
+  treeSpeed.clear();
+  treeExtensions.clear();
+  cntRealExtensions.clear();
+  cntNonRealExtensions.clear();
+  derivePtsAll.clear();
+  derivePtsVisible.clear();
+}
+
+bool CGisItemTrk::isDerivePtsValid() {
+  qint32 idx = 0;
+  for (CTrackData::trkseg_t& seg : trk.segs) {
+    if (seg.pts.isEmpty()) {
+      continue;
+    }
+
+    // data() detaches point arrays shared with a copy of the track data, too
+    if ((idx >= derivePtsAll.size()) || (seg.pts.data() != derivePtsAll[idx])) {
+      return false;
+    }
+    idx += seg.pts.size();
+  }
+
+  return (idx > 0) && (idx == derivePtsAll.size());
+}
+
+void CGisItemTrk::updateDeriveState(const CTrackData::trkpt_t& trkpt, bool wasVisible) {
+  if (!hasDeriveState) {
+    return;
+  }
+
+  const bool isVisible = !trkpt.isHidden();
+  const qint32 idx = trkpt.idxTotal;
+
+  treeLon.set(idx, isVisible ? trkpt.lon : NOFLOAT);
+  treeLat.set(idx, isVisible ? trkpt.lat : NOFLOAT);
+  treeEle.set(idx, isVisible ? trkpt.ele : NOFLOAT);
+  if (!isVisible) {
+    treeSlope.set(idx, NOFLOAT);
+    treeSpeed.set(idx, NOFLOAT);
+  }
+
+  if (isVisible == wasVisible) {
+    return;
+  }
+
+  const qint32 sign = isVisible ? 1 : -1;
+  for (auto it = trkpt.extensions.cbegin(); it != trkpt.extensions.cend(); ++it) {
+    bool isReal = false;
+    qreal val = it.value().toReal(&isReal);
+
+    if (isReal) {
+      CMinMaxTree& tree = treeExtensions[it.key()];
+      if (tree.size() == 0) {
+        tree.build(QVector<qreal>(treeLon.size(), NOFLOAT));
+      }
+      tree.set(idx, isVisible ? val : NOFLOAT);
+      cntRealExtensions[it.key()] += sign;
+    } else {
+      cntNonRealExtensions[it.key()] += sign;
+    }
+  }
+}
+
+void CGisItemTrk::countValid(quint32 valid, qint32 sign) {
+  if (!hasDeriveState) {
+    return;
+  }
+
+  if ((valid & 0xFFFF0000) != 0) {
+    cntInvalidPoints += sign;
+  }
+
+  for (qint32 bit = 0; bit < 32; bit++) {
+    if (valid & (1u << bit)) {
+      cntValidBits[bit] += sign;
+    }
+  }
+}
+
 void CGisItemTrk::resetInternalData() {
   mouseClickFocus = nullptr;
   mouseMoveFocus = nullptr;
@@ -875,6 +1160,111 @@ void CGisItemTrk::consolidatePoints() {
   }
 }
 
+// Accumulate distance, ascent/descent and time from the previous visible point. lastEle is the
+// reference elevation of the ascent/descent hysteresis.
+static void deriveProgress(const CTrackData::trkpt_t* lastTrkpt, CTrackData::trkpt_t& trkpt, qreal& timestampStart,
+                           qint32& lastEle) {
+  if (lastTrkpt != nullptr) {
+    trkpt.deltaDistance = lastTrkpt->distanceTo(trkpt);
+    trkpt.distance = lastTrkpt->distance + trkpt.deltaDistance;
+    trkpt.elapsedSeconds = trkpt.time.toMSecsSinceEpoch() / 1000.0 - timestampStart;
+
+    // ascent descent
+    if (lastEle != NOINT) {
+      qint32 delta = trkpt.ele - lastEle;
+
+      trkpt.ascent = lastTrkpt->ascent;
+      trkpt.descent = lastTrkpt->descent;
+
+      if (qAbs(delta) >= ASCENT_THRESHOLD) {
+        const qint32 step = (delta / ASCENT_THRESHOLD) * ASCENT_THRESHOLD;
+
+        if (delta > 0) {
+          trkpt.ascent += step;
+        } else {
+          trkpt.descent -= step;
+        }
+        lastEle += step;
+      }
+    }
+
+    // time moving
+    trkpt.elapsedSecondsMoving = lastTrkpt->elapsedSecondsMoving;
+    qreal dt = (trkpt.time.toMSecsSinceEpoch() - lastTrkpt->time.toMSecsSinceEpoch()) / 1000.0;
+    if (dt > 0 && ((trkpt.deltaDistance / dt) > 0.2)) {
+      trkpt.elapsedSecondsMoving += dt;
+    }
+  } else {
+    timestampStart = trkpt.time.toMSecsSinceEpoch() / 1000.0;
+    lastEle = trkpt.ele;
+
+    trkpt.deltaDistance = 0;
+    trkpt.distance = 0;
+    trkpt.ascent = 0;
+    trkpt.descent = 0;
+    trkpt.elapsedSeconds = 0;
+    trkpt.elapsedSecondsMoving = 0;
+  }
+}
+
+// Derive slope and speed of point p from the points about 25m before and after it.
+// n1 and n2 return the window used, -1 and lintrk.size() if it reaches the track's ends.
+static void deriveSlopeAndSpeed(const QVector<CTrackData::trkpt_t*>& lintrk, qint32 p, qint32& n1, qint32& n2) {
+  CTrackData::trkpt_t& trkpt = *lintrk[p];
+
+  qreal d1 = trkpt.distance;
+  qreal e1 = trkpt.ele;
+  qreal t1 = trkpt.time.toMSecsSinceEpoch() / 1000.0;
+  for (n1 = p; n1 > 0; --n1) {
+    CTrackData::trkpt_t& trkpt2 = *lintrk[n1];
+    if (trkpt2.ele == NOINT) {
+      continue;
+    }
+
+    if (trkpt.distance - trkpt2.distance >= 25) {
+      d1 = trkpt2.distance;
+      e1 = trkpt2.ele;
+      t1 = trkpt2.time.toMSecsSinceEpoch() / 1000.0;
+      break;
+    }
+  }
+  if (n1 == 0) {
+    n1 = -1;
+  }
+
+  qreal d2 = trkpt.distance;
+  qreal e2 = trkpt.ele;
+  qreal t2 = trkpt.time.toMSecsSinceEpoch() / 1000.0;
+  for (n2 = p; n2 < lintrk.size(); ++n2) {
+    CTrackData::trkpt_t& trkpt2 = *lintrk[n2];
+    if (trkpt2.ele == NOINT) {
+      continue;
+    }
+
+    if (trkpt2.distance - trkpt.distance >= 25) {
+      d2 = trkpt2.distance;
+      e2 = trkpt2.ele;
+      t2 = trkpt2.time.toMSecsSinceEpoch() / 1000.0;
+      break;
+    }
+  }
+
+  if (d1 < d2) {
+    qreal a = qAtan((e2 - e1) / (d2 - d1));
+    trkpt.slope1 = a * 360.0 / (2 * M_PI);
+    trkpt.slope2 = qTan(trkpt.slope1 * DEG_TO_RAD) * 100;
+  } else {
+    trkpt.slope1 = NOFLOAT;
+    trkpt.slope2 = NOFLOAT;
+  }
+
+  if (t1 < t2) {
+    trkpt.speed = (d2 - d1) / (t2 - t1);
+  } else {
+    trkpt.speed = NOFLOAT;
+  }
+}
+
 void CGisItemTrk::deriveSecondaryData() {
   consolidatePoints();
 
@@ -895,6 +1285,9 @@ void CGisItemTrk::deriveSecondaryData() {
   totalDescent = NOFLOAT;
   totalElapsedSeconds = NOTIME;
   totalElapsedSecondsMoving = NOTIME;
+  // force update of projected track line
+  projectionIdM = -1;
+  resetDeriveState();
 
   trk.removeEmptySegments();
 
@@ -918,6 +1311,7 @@ void CGisItemTrk::deriveSecondaryData() {
 
     if (trkpt.isHidden()) {
       trkpt.reset();
+      eleRefs << lastEle;
       continue;
     }
 
@@ -929,129 +1323,316 @@ void CGisItemTrk::deriveSecondaryData() {
     south = qMin(south, trkpt.lat);
     north = qMax(north, trkpt.lat);
 
-    if (lastTrkpt != nullptr) {
-      trkpt.deltaDistance = lastTrkpt->distanceTo(trkpt);
-      trkpt.distance = lastTrkpt->distance + trkpt.deltaDistance;
-      trkpt.elapsedSeconds = trkpt.time.toMSecsSinceEpoch() / 1000.0 - timestampStart;
+    deriveProgress(lastTrkpt, trkpt, timestampStart, lastEle);
+    eleRefs << lastEle;
+
+    lastTrkpt = &trkpt;
+  }
+
+  constexpr qreal kMargin = 0.0001 * DEG_TO_RAD;  // ~5m
+  boundingRect = QRectF(QPointF(west * DEG_TO_RAD - kMargin, north * DEG_TO_RAD + kMargin),
+                        QPointF(east * DEG_TO_RAD + kMargin, south * DEG_TO_RAD - kMargin));
+
+  for (int p = 0; p < lintrk.size(); p++) {
+    CTrackData::trkpt_t& trkpt = *lintrk[p];
 
-      // ascent descent
-      if (lastEle != NOINT) {
-        qint32 delta = trkpt.ele - lastEle;
+    qint32 n1, n2;
+    deriveSlopeAndSpeed(lintrk, p, n1, n2);
 
-        trkpt.ascent = lastTrkpt->ascent;
-        trkpt.descent = lastTrkpt->descent;
+    // verify data
+    verifyTrkPt(lastValid, trkpt);
+    // add current status to allValidFlags
+    allValidFlags |= trkpt.valid;
+    if ((trkpt.valid & 0xFFFF0000) != 0) {
+      cntInvalidPoints++;
+    }
+  }
 
-        if (qAbs(delta) >= ASCENT_THRESHOLD) {
-          const qint32 step = (delta / ASCENT_THRESHOLD) * ASCENT_THRESHOLD;
+  if (nullptr != lastTrkpt) {
+    timeStart = lintrk.first()->time;
+    timeEnd = lastTrkpt->time;
+    totalDistance = lastTrkpt->distance;
+    totalAscent = lastTrkpt->ascent;
+    totalDescent = lastTrkpt->descent;
+    totalElapsedSeconds = lastTrkpt->elapsedSeconds;
+    totalElapsedSecondsMoving = lastTrkpt->elapsedSecondsMoving;
+  }
 
-          if (delta > 0) {
-            trkpt.ascent += step;
-          } else {
-            trkpt.descent -= step;
-          }
-          lastEle += step;
-        }
-      }
+  activities.update();
 
-      // time moving
-      trkpt.elapsedSecondsMoving = lastTrkpt->elapsedSecondsMoving;
-      qreal dt = (trkpt.time.toMSecsSinceEpoch() - lastTrkpt->time.toMSecsSinceEpoch()) / 1000.0;
-      if (dt > 0 && ((trkpt.deltaDistance / dt) > 0.2)) {
-        trkpt.elapsedSecondsMoving += dt;
+  updateExtremaAndExtensions();
+  updateSecondaryObjects();
+
+  //    qDebug() << "--------------" << getName() << "------------------";
+  //    qDebug() << "allValidFlags" << Qt::hex << allValidFlags;
+  //    qDebug() << "totalDistance" << totalDistance;
+  //    qDebug() << "totalAscent" << totalAscent;
+  //    qDebug() << "totalDescent" << totalDescent;
+  //    qDebug() << "totalElapsedSeconds" << totalElapsedSeconds;
+  //    qDebug() << "totalElapsedSecondsMoving" << totalElapsedSecondsMoving;
+}
+
+void CGisItemTrk::deriveSecondaryData(qint32 idx1, qint32 idx2) {
+  if (idx1 > idx2) {
+    qSwap(idx1, idx2);
+  }
+
+  if ((idx1 < 0) || (idx2 >= eleRefs.size()) || (cntVisiblePoints == 0)) {
+    deriveSecondaryData();
+    return;
+  }
+
+  // All points by total index and the visible points as of the last derivation. Both are
+  // kept until the next full derivation or until the point arrays are reallocated.
+  QVector<CTrackData::trkpt_t*>& alltrk = derivePtsAll;
+  QVector<CTrackData::trkpt_t*>& lintrk = derivePtsVisible;
+  if (!isDerivePtsValid()) {
+    alltrk.clear();
+    alltrk.reserve(eleRefs.size());
+    for (CTrackData::trkpt_t& trkpt : trk) {
+      alltrk << &trkpt;
+    }
+
+    lintrk.clear();
+    lintrk.reserve(cntVisiblePoints);
+    for (CTrackData::trkpt_t* trkpt : qAsConst(alltrk)) {
+      if (trkpt->idxVisible != NOIDX) {
+        lintrk << trkpt;
       }
-    } else {
-      timeStart = trkpt.time;
-      timestampStart = timeStart.toMSecsSinceEpoch() / 1000.0;
-      lastEle = trkpt.ele;
+    }
+  }
 
-      trkpt.deltaDistance = 0;
-      trkpt.distance = 0;
-      trkpt.ascent = 0;
-      trkpt.descent = 0;
-      trkpt.elapsedSeconds = 0;
-      trkpt.elapsedSecondsMoving = 0;
+  if (alltrk.size() != eleRefs.size()) {
+    deriveSecondaryData();
+    return;
+  }
+
+  // The list of visible points and the visible index of the points after the change
+  // have to be updated only if points have been hidden or shown.
+  bool isVisibilityChanged = false;
+  for (qint32 idx = idx1; idx <= idx2; idx++) {
+    if ((alltrk[idx]->idxVisible != NOIDX) == alltrk[idx]->isHidden()) {
+      isVisibilityChanged = true;
+      break;
     }
+  }
 
-    lastTrkpt = &trkpt;
+  // force update of projected track line
+  projectionIdM = -1;
+
+  // points before the change keep all their values
+  CTrackData::trkpt_t* lastTrkpt = nullptr;
+  for (qint32 idx = idx1 - 1; idx >= 0; idx--) {
+    if (!alltrk[idx]->isHidden()) {
+      lastTrkpt = alltrk[idx];
+      break;
+    }
   }
 
-  constexpr qreal kMargin = 0.0001 * DEG_TO_RAD;  // ~5m
-  boundingRect = QRectF(QPointF(west * DEG_TO_RAD - kMargin, north * DEG_TO_RAD + kMargin),
-                        QPointF(east * DEG_TO_RAD + kMargin, south * DEG_TO_RAD - kMargin));
+  qreal timestampStart = NOFLOAT;
+  qint32 lastEle = NOINT;
+  if (lastTrkpt != nullptr) {
+    timestampStart = lintrk.first()->time.toMSecsSinceEpoch() / 1000.0;
+  }
 
-  for (int p = 0; p < lintrk.size(); p++) {
-    CTrackData::trkpt_t& trkpt = *lintrk[p];
+  if (idx1 > 0) {
+    lastEle = eleRefs[idx1 - 1];
+  }
 
-    qreal d1 = trkpt.distance;
-    qreal e1 = trkpt.ele;
-    qreal t1 = trkpt.time.toMSecsSinceEpoch() / 1000.0;
-    for (int n = p; n > 0; --n) {
-      CTrackData::trkpt_t& trkpt2 = *lintrk[n];
-      if (trkpt2.ele == NOINT) {
-        continue;
-      }
+  if (isVisibilityChanged) {
+    lintrk.resize(lastTrkpt == nullptr ? 0 : lastTrkpt->idxVisible + 1);
+  }
 
-      if (trkpt.distance - trkpt2.distance >= 25) {
-        d1 = trkpt2.distance;
-        e1 = trkpt2.ele;
-        t1 = trkpt2.time.toMSecsSinceEpoch() / 1000.0;
-        break;
+  // without any timestamp the validity of the points after the change is not affected
+  const bool hasTimestamps = (allValidFlags & CTrackData::trkpt_t::eValidTime) != 0;
+
+  // Starting with the change the values are derived again until the ascent/descent hysteresis
+  // has the same reference elevation as before. From there on all accumulated values just
+  // differ by a constant.
+  bool isInSync = false;
+  qreal deltaDistance = 0;
+  qreal deltaAscent = 0;
+  qreal deltaDescent = 0;
+  qreal deltaMoving = 0;
+  const qreal timestampStartOld = timeStart.toMSecsSinceEpoch() / 1000.0;
+
+  qint32 idx = idx1;
+  for (; idx < alltrk.size(); idx++) {
+    CTrackData::trkpt_t& trkpt = *alltrk[idx];
+    const bool wasVisible = trkpt.idxVisible != NOIDX;
+
+    if (trkpt.isHidden()) {
+      if (wasVisible) {
+        countValid(trkpt.valid, -1);
+        trkpt.reset();
+      }
+      if (idx <= idx2) {
+        updateDeriveState(trkpt, wasVisible);
       }
+      if (!isInSync) {
+        eleRefs[idx] = lastEle;
+      }
+      continue;
     }
 
-    qreal d2 = trkpt.distance;
-    qreal e2 = trkpt.ele;
-    qreal t2 = trkpt.time.toMSecsSinceEpoch() / 1000.0;
-    for (int n = p; n < lintrk.size(); ++n) {
-      CTrackData::trkpt_t& trkpt2 = *lintrk[n];
-      if (trkpt2.ele == NOINT) {
-        continue;
+    if (isVisibilityChanged) {
+      trkpt.idxVisible = lintrk.size();
+      lintrk << &trkpt;
+    }
+
+    if (isInSync) {
+      trkpt.distance += deltaDistance;
+      trkpt.ascent += deltaAscent;
+      trkpt.descent += deltaDescent;
+      trkpt.elapsedSecondsMoving += deltaMoving;
+      if (timestampStart != timestampStartOld) {
+        trkpt.elapsedSeconds = trkpt.time.toMSecsSinceEpoch() / 1000.0 - timestampStart;
       }
+      continue;
+    }
+
+    const qreal distanceOld = trkpt.distance;
+    const qreal ascentOld = trkpt.ascent;
+    const qreal descentOld = trkpt.descent;
+    const qreal movingOld = trkpt.elapsedSecondsMoving;
 
-      if (trkpt2.distance - trkpt.distance >= 25) {
-        d2 = trkpt2.distance;
-        e2 = trkpt2.ele;
-        t2 = trkpt2.time.toMSecsSinceEpoch() / 1000.0;
+    deriveProgress(lastTrkpt, trkpt, timestampStart, lastEle);
+    lastTrkpt = &trkpt;
+
+    if (idx <= idx2) {
+      updateDeriveState(trkpt, wasVisible);
+    } else if (lastEle == eleRefs[idx]) {
+      isInSync = true;
+      deltaDistance = trkpt.distance - distanceOld;
+      deltaAscent = trkpt.ascent - ascentOld;
+      deltaDescent = trkpt.descent - descentOld;
+      deltaMoving = trkpt.elapsedSecondsMoving - movingOld;
+
+      // nothing to do if the points after this one keep their values, too
+      if (!isVisibilityChanged && (deltaDistance == 0) && (deltaAscent == 0) && (deltaDescent == 0) &&
+          (deltaMoving == 0) && (timestampStart == timestampStartOld)) {
         break;
       }
     }
+    eleRefs[idx] = lastEle;
+  }
 
-    if (d1 < d2) {
-      qreal a = qAtan((e2 - e1) / (d2 - d1));
-      trkpt.slope1 = a * 360.0 / (2 * M_PI);
-      trkpt.slope2 = qTan(trkpt.slope1 * DEG_TO_RAD) * 100;
-    } else {
-      trkpt.slope1 = NOFLOAT;
-      trkpt.slope2 = NOFLOAT;
+  if (lintrk.isEmpty()) {
+    deriveSecondaryData();
+    return;
+  }
+
+  // The changed points are [vA, vB[ plus vB, the first visible point after the change, as
+  // its distance to the previous point might have changed, too.
+  const qint32 N = lintrk.size();
+  qint32 vA = N;
+  qint32 vB = N;
+  for (idx = idx1; idx < alltrk.size(); idx++) {
+    if (!alltrk[idx]->isHidden()) {
+      vA = alltrk[idx]->idxVisible;
+      break;
     }
+  }
+  for (idx = idx2 + 1; idx < alltrk.size(); idx++) {
+    if (!alltrk[idx]->isHidden()) {
+      vB = alltrk[idx]->idxVisible;
+      break;
+    }
+  }
 
-    if (t1 < t2) {
-      trkpt.speed = (d2 - d1) / (t2 - t1);
-    } else {
-      trkpt.speed = NOFLOAT;
+  // Slope and speed have to be derived again for all points with a window touching the
+  // change. As the windows move monotonically with the point the search stops at the first
+  // point with a window off the change.
+  qint32 n1, n2;
+  qint32 lo = vA;
+  qint32 hi = qMin(vB, N - 1);
+  for (qint32 p = lo; p <= hi; p++) {
+    deriveSlopeAndSpeed(lintrk, p, n1, n2);
+  }
+  while (lo > 0) {
+    deriveSlopeAndSpeed(lintrk, --lo, n1, n2);
+    if (n2 < vA) {
+      break;
+    }
+  }
+  while (hi < N - 1) {
+    deriveSlopeAndSpeed(lintrk, ++hi, n1, n2);
+    if (n1 > vB) {
+      break;
     }
+  }
 
-    // verify data
+  if (hasDeriveState) {
+    for (qint32 p = lo; p <= hi; p++) {
+      treeSlope.set(lintrk[p]->idxTotal, lintrk[p]->slope1);
+      treeSpeed.set(lintrk[p]->idxTotal, lintrk[p]->speed);
+    }
+  }
+
+  // verify all points derived again and the next point with a timestamp, as it is
+  // compared to the previous one
+  CTrackData::trkpt_t* lastValid = nullptr;
+  for (qint32 p = lo - 1; p >= 0; --p) {
+    if (lintrk[p]->time.isValid()) {
+      lastValid = lintrk[p];
+      break;
+    }
+  }
+
+  for (qint32 p = lo; p < (hasTimestamps ? N : hi + 1); p++) {
+    CTrackData::trkpt_t& trkpt = *lintrk[p];
+    if ((p > hi) && !trkpt.time.isValid()) {
+      continue;
+    }
+
+    countValid(trkpt.valid, -1);
     verifyTrkPt(lastValid, trkpt);
-    // add current status to allValidFlags
-    allValidFlags |= trkpt.valid;
-    if ((trkpt.valid & 0xFFFF0000) != 0) {
-      cntInvalidPoints++;
+    countValid(trkpt.valid, 1);
+
+    if ((p >= hi) && trkpt.time.isValid()) {
+      break;
     }
   }
 
-  if (nullptr != lastTrkpt) {
-    timeEnd = lastTrkpt->time;
-    totalDistance = lastTrkpt->distance;
-    totalAscent = lastTrkpt->ascent;
-    totalDescent = lastTrkpt->descent;
-    totalElapsedSeconds = lastTrkpt->elapsedSeconds;
-    totalElapsedSecondsMoving = lastTrkpt->elapsedSecondsMoving;
+  // the state for the extrema is built on the first local change only
+  if (!hasDeriveState) {
+    buildDeriveState(alltrk);
   }
 
-  activities.update();
+  allValidFlags = 0;
+  for (qint32 bit = 0; bit < 32; bit++) {
+    if (cntValidBits[bit] > 0) {
+      allValidFlags |= 1u << bit;
+    }
+  }
 
-  updateExtremaAndExtensions();
+  const CTrackData::trkpt_t* last = lintrk.last();
+  cntVisiblePoints = N;
+  timeStart = lintrk.first()->time;
+  timeEnd = last->time;
+  totalDistance = last->distance;
+  totalAscent = last->ascent;
+  totalDescent = last->descent;
+  totalElapsedSeconds = last->elapsedSeconds;
+  totalElapsedSecondsMoving = last->elapsedSecondsMoving;
+
+  const qreal west = qMin(qreal(180), treeLon.getMin());
+  const qreal east = qMax(qreal(-180), treeLon.getMax());
+  const qreal south = qMin(qreal(90), treeLat.getMin());
+  const qreal north = qMax(qreal(-90), treeLat.getMax());
+
+  constexpr qreal kMargin = 0.0001 * DEG_TO_RAD;  // ~5m
+  boundingRect = QRectF(QPointF(west * DEG_TO_RAD - kMargin, north * DEG_TO_RAD + kMargin),
+                        QPointF(east * DEG_TO_RAD + kMargin, south * DEG_TO_RAD - kMargin));
+
+  // the activities of the points did not change, just their distance, time and elevation
+  activities.updateSummary();
+
+  updateExtremaFromDeriveState(alltrk, lintrk);
+  updateSecondaryObjects();
+}
+
+void CGisItemTrk::updateSecondaryObjects() {
   // make sure we have a graph properties object by now
   if (propHandler == nullptr) {
     propHandler = new CPropertyTrk(*this);
@@ -1065,14 +1646,6 @@ void CGisItemTrk::deriveSecondaryData() {
   energyCycling.compute();
 
   updateVisuals(eVisualAll, "deriveSecondaryData()");
-
-  //    qDebug() << "--------------" << getName() << "------------------";
-  //    qDebug() << "allValidFlags" << Qt::hex << allValidFlags;
-  //    qDebug() << "totalDistance" << totalDistance;
-  //    qDebug() << "totalAscent" << totalAscent;
-  //    qDebug() << "totalDescent" << totalDescent;
-  //    qDebug() << "totalElapsedSeconds" << totalElapsedSeconds;
-  //    qDebug() << "totalElapsedSecondsMoving" << totalElapsedSecondsMoving;
 }
 
 void CGisItemTrk::findWaypointsCloseBy(CProgressDialog& progress, quint32& current) {
@@ -1205,7 +1778,7 @@ void CGisItemTrk::findWaypointsCloseBy(CProgressDialog& progress, quint32& curre
 bool CGisItemTrk::isCloseTo(const QPointF& pos) {
   QMutexLocker lock(&mutexItems);
 
-  return GPS_Math_DistPointPolyline(lineSimple, pos) < 20;
+  return GPS_Math_DistPointPolyline(getLineSimple(), pos) < 20;
 }
 
 bool CGisItemTrk::isWithin(const QRectF& area, selflags_t flags) {
@@ -1477,7 +2050,7 @@ void CGisItemTrk::hideSelectedPoints() {
       trkpt.setFlag(CTrackData::trkpt_t::eFlagHidden);
     }
   }
-  deriveSecondaryData();
+  deriveSecondaryData(idx1 + 1, idx2 - 1);
   if (idx1 + 1 == idx2 - 1) {
     changed(tr("Hide point %1.").arg(idx1 + 1), "://icons/48x48/PointHide.png");
   } else {
@@ -1541,7 +2114,7 @@ void CGisItemTrk::showSelectedPoints() {
     }
   }
 
-  deriveSecondaryData();
+  deriveSecondaryData(idx1, idx2);
   changed(tr("Show points."), "://icons/48x48/PointShow.png");
 }
 
@@ -1565,8 +2138,11 @@ void CGisItemTrk::copySelectedPoints() const {
 void CGisItemTrk::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CGisDraw* gis) {
   QMutexLocker lock(&mutexItems);
 
+  // the lines stay empty if the track is not drawn
   lineSimple.clear();
   lineFull.clear();
+  isLineSimpleValid = true;
+  isLineFullValid = true;
 
   if (!isVisible(boundingRect, viewport, gis)) {
     return;
@@ -1576,50 +2152,29 @@ void CGisItemTrk::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>
     return;
   }
 
-  QPointF pt1;
   QPointF p1 = viewport[0];
   QPointF p2 = viewport[2];
   gis->convertRad2Px(p1);
   gis->convertRad2Px(p2);
   QRectF extViewport(p1, p2);
 
-  if (mode == eModeNormal) {
-    // in normal mode the trackline without points marked as deleted is drawn
-    for (const CTrackData::trkpt_t& pt : trk) {
-      if (pt.isHidden()) {
-        continue;
-      }
+  // The projection is the expensive part. Pan and zoom just need the affine transformation.
+  updateLinesM(gis);
+  const QTransform trafo = gis->getTransformM2Px();
 
-      pt1.setX(pt.lon);
-      pt1.setY(pt.lat);
-      pt1 *= DEG_TO_RAD;
-      lineSimple << pt1;
-    }
-  } else {
-    // in full mode the complete track including points marked as deleted
-    // is drawn as gray line first. Then the track without points marked as
-    // deleted is drawn with it's configured color
-    for (const CTrackData::trkpt_t& pt : trk) {
-      pt1.setX(pt.lon);
-      pt1.setY(pt.lat);
-      pt1 *= DEG_TO_RAD;
+  // The point aligned lines are needed for hit tests, range selection and colorized tracks only.
+  // Thus they are transformed on first use.
+  trafoM2Px = trafo;
+  isLineSimpleValid = false;
+  isLineFullValid = (mode == eModeNormal);
 
-      lineFull << pt1;
-
-      if (pt.isHidden()) {
-        continue;
-      }
-
-      lineSimple << pt1;
-    }
-  }
-  gis->convertRad2Px(lineSimple);
-  gis->convertRad2Px(lineFull);
+  // the track line itself is drawn with the points visible at the current zoom level only
+  const QPolygonF lineLod = trafo.map(getLineSimpleLod(1.0 / qAbs(trafo.m11())));
 
   // draw the full line first
   if (mode == eModeRange) {
     QList<QPolygonF> lines;
-    splitLineToViewport(lineFull, extViewport, lines);
+    splitLineToViewport(getLineFull(), extViewport, lines);
 
     p.setPen(QPen(Qt::lightGray, penWidthBg, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
 
@@ -1638,7 +2193,7 @@ void CGisItemTrk::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>
 
   // draw the reduced track line
   QList<QPolygonF> lines;
-  splitLineToViewport(lineSimple, extViewport, lines);
+  splitLineToViewport(lineLod, extViewport, lines);
 
   const CMainWindow& w = CMainWindow::self();
   if (key == keyUserFocus && w.isShowTrackHighlight()) {
@@ -1667,9 +2222,9 @@ void CGisItemTrk::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>
       p.drawPolyline(l);
     }
   } else if (getColorizeSource() == "activity") {
-    drawColorizedByActivity(p);
+    drawColorizedByActivity(p, getLineSimple());
   } else {
-    drawColorized(p);
+    drawColorized(p, getLineSimple());
   }
 
   if (isNogo()) {
@@ -1730,6 +2285,74 @@ void CGisItemTrk::drawItem(QPainter& p, const QPolygonF& viewport, QList<QRectF>
   }
 }
 
+void CGisItemTrk::updateLinesM(CGisDraw* gis) {
+  QPointF pt1;
+  const qint32 projectionId = gis->getProjectionId();
+
+  if (projectionIdM != projectionId) {
+    lineSimpleM.clear();
+    lineFullM.clear();
+    lineSimpleLod.clear();
+
+    // the trackline without points marked as deleted
+    for (const CTrackData::trkpt_t& pt : trk) {
+      if (pt.isHidden()) {
+        continue;
+      }
+
+      pt1.setX(pt.lon);
+      pt1.setY(pt.lat);
+      pt1 *= DEG_TO_RAD;
+      lineSimpleM << pt1;
+    }
+    gis->convertRad2M(lineSimpleM);
+    projectionIdM = projectionId;
+  }
+
+  if ((mode != eModeNormal) && lineFullM.isEmpty()) {
+    // in full mode the complete track including points marked as deleted
+    // is drawn as gray line first.
+    for (const CTrackData::trkpt_t& pt : trk) {
+      pt1.setX(pt.lon);
+      pt1.setY(pt.lat);
+      pt1 *= DEG_TO_RAD;
+      lineFullM << pt1;
+    }
+    gis->convertRad2M(lineFullM);
+  }
+}
+
+const QPolygonF& CGisItemTrk::getLineSimpleLod(qreal pixelSize) {
+  auto lod = lineSimpleLod.find(pixelSize);
+  if (lod == lineSimpleLod.end()) {
+    // keep the number of zoom levels bound
+    if (lineSimpleLod.size() > 8) {
+      lineSimpleLod.clear();
+    }
+
+    QPolygonF line;
+    GPS_Math_SimplifyPolyline(lineSimpleM, 0.5 * pixelSize, line);
+    lod = lineSimpleLod.insert(pixelSize, line);
+  }
+  return *lod;
+}
+
+const QPolygonF& CGisItemTrk::getLineSimple() {
+  if (!isLineSimpleValid) {
+    lineSimple = trafoM2Px.map(lineSimpleM);
+    isLineSimpleValid = true;
+  }
+  return lineSimple;
+}
+
+const QPolygonF& CGisItemTrk::getLineFull() {
+  if (!isLineFullValid) {
+    lineFull = trafoM2Px.map(lineFullM);
+    isLineFullValid = true;
+  }
+  return lineFull;
+}
+
 void CGisItemTrk::drawLimitLabels(limit_type_e type, const QString& label, const QPointF& pos, QPainter& p,
                                   const QFontMetricsF& fm, QList<QRectF>& blockedAreas) {
   const QString& fullLabel = (type == eLimitTypeMin ? tr("min.") : tr("max.")) + " " + label;
@@ -1770,7 +2393,7 @@ void CGisItemTrk::setPen(QPainter& p, QPen& pen, trkact_t act) const {
   p.setPen(pen);
 }
 
-void CGisItemTrk::drawColorizedByActivity(QPainter& p) const {
+void CGisItemTrk::drawColorizedByActivity(QPainter& p, const QPolygonF& line) const {
   QPen pen;
   pen.setWidth(penWidthFg);
   pen.setCapStyle(Qt::RoundCap);
@@ -1788,7 +2411,7 @@ void CGisItemTrk::drawColorizedByActivity(QPainter& p) const {
         continue;
       }
 
-      p.drawLine(lineSimple[ptPrev->idxVisible], lineSimple[pt.idxVisible]);
+      p.drawLine(line[ptPrev->idxVisible], line[pt.idxVisible]);
 
       if (ptPrev->getAct() != pt.getAct()) {
         setPen(p, pen, pt.getAct());
@@ -1799,7 +2422,7 @@ void CGisItemTrk::drawColorizedByActivity(QPainter& p) const {
   }
 }
 
-void CGisItemTrk::drawColorized(QPainter& p) const {
+void CGisItemTrk::drawColorized(QPainter& p, const QPolygonF& line) const {
   auto valueFunc = CKnownExtension::get(getColorizeSource()).valueFunc;
 
   QImage colors(1, 256, QImage::Format_RGB888);
@@ -1836,7 +2459,7 @@ void CGisItemTrk::drawColorized(QPainter& p) const {
         colorStart = colorEnd;
       }
 
-      QLinearGradient grad(lineSimple[ptPrev->idxVisible], lineSimple[pt.idxVisible]);
+      QLinearGradient grad(line[ptPrev->idxVisible], line[pt.idxVisible]);
       grad.setColorAt(0.f, colorStart);
       grad.setColorAt(1.f, colorEnd);
 
@@ -1846,7 +2469,7 @@ void CGisItemTrk::drawColorized(QPainter& p) const {
       pen.setCapStyle(Qt::RoundCap);
 
       p.setPen(pen);
-      p.drawLine(lineSimple[ptPrev->idxVisible], lineSimple[pt.idxVisible]);
+      p.drawLine(line[ptPrev->idxVisible], line[pt.idxVisible]);
 
       ptPrev = &pt;
       colorStart = colorEnd;
@@ -2083,13 +2706,13 @@ void CGisItemTrk::drawLabel(QPainter& p, const QPolygonF&, QList<QRectF>& blocke
 void CGisItemTrk::drawHighlight(QPainter& p) {
   QMutexLocker lock(&mutexItems);
 
-  if (lineSimple.isEmpty() || hasUserFocus()) {
+  if (hasUserFocus() || getLineSimple().isEmpty()) {
     return;
   }
 
   // draw the reduced track line
   QList<QPolygonF> lines;
-  splitLineToViewport(lineSimple, p.viewport(), lines);
+  splitLineToViewport(getLineSimple(), p.viewport(), lines);
 
   p.setPen(QPen(QColor(255, 0, 0, 100), penWidthHi, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
 
@@ -2108,7 +2731,7 @@ void CGisItemTrk::drawRange(QPainter& p, CGisDraw* gis) {
     return;
   }
 
-  const QPolygonF& line = (mode == eModeRange) ? lineFull : lineSimple;
+  const QPolygonF& line = (mode == eModeRange) ? getLineFull() : getLineSimple();
 
   QPolygonF seg = line.mid(idx1, idx2 - idx1 + 1);
 
@@ -2189,7 +2812,7 @@ void CGisItemTrk::setElevation(qint32 idx, qint32 ele) {
   CTrackData::trkpt_t* trkpt = trk.getTrkPtByTotalIndex(idx);
   if ((trkpt != nullptr) && (trkpt->ele != ele)) {
     trkpt->ele = ele;
-    deriveSecondaryData();
+    deriveSecondaryData(idx, idx);
     changed(tr("Changed elevation of point %1 to %2 %3")
                 .arg(idx)
                 .arg(ele * IUnit::self().elevationFactor)
@@ -2255,6 +2878,13 @@ void CGisItemTrk::setColor(const QColor& c) {
   }
 
   color = colorMap[colorIdx].color;
+
+  if (IGisProject::isLoadedByWorker()) {
+    // pixmaps are created by IGisProject::finishLoading() on the GUI thread
+    trk.color = color2str(color);
+    return;
+  }
+
   bullet = QPixmap(colorMap[colorIdx].bullet);
 
   setIcon(color2str(color));
@@ -2328,7 +2958,7 @@ QPointF CGisItemTrk::setMouseFocusByPoint(const QPoint& pt, focusmode_e fmode, c
   const CTrackData::trkpt_t* newPointOfFocus = nullptr;
   quint32 idx = 0;
 
-  const QPolygonF& line = (mode == eModeRange) ? lineFull : lineSimple;
+  const QPolygonF& line = (mode == eModeRange) ? getLineFull() : getLineSimple();
 
   if (pt != NOPOINT && GPS_Math_DistPointPolyline(line, pt) < MIN_DIST_FOCUS) {
     /*
@@ -2594,6 +3224,10 @@ void CGisItemTrk::updateVisuals(quint32 visuals, const QString& who) {
     }
   }
 
+  if (IGisProject::isLoadedByWorker()) {
+    return;
+  }
+
   const CMainWindow& main = CMainWindow::self();
   const QList<CCanvas*>& allCanvas = main.getCanvas();
   for (CCanvas* canvas : allCanvas) {
@@ -2715,8 +3349,9 @@ const searchValue_t CGisItemTrk::getValueByKeyword(searchProperty_e keyword) {
 }
 
 bool CGisItemTrk::findPolylineCloseBy(const QPointF& pt1, const QPointF& pt2, qint32& threshold, QPolygonF& polyline) {
-  qreal dist1 = GPS_Math_DistPointPolyline(lineSimple, pt1, threshold);
-  qreal dist2 = GPS_Math_DistPointPolyline(lineSimple, pt2, threshold);
+  const QPolygonF& line = getLineSimple();
+  qreal dist1 = GPS_Math_DistPointPolyline(line, pt1, threshold);
+  qreal dist2 = GPS_Math_DistPointPolyline(line, pt2, threshold);
 
   if (dist1 < threshold && dist2 < threshold) {
     trk.getPolyline(polyline);
@@ -2728,7 +3363,7 @@ bool CGisItemTrk::findPolylineCloseBy(const QPointF& pt1, const QPointF& pt2, qi
 
 void CGisItemTrk::checkForInvalidPoints() {
   IGisProject* project = getParentProject();
-  if (project && project->getInvalidDataOk()) {
+  if ((project && project->getInvalidDataOk()) || IGisProject::isLoadedByWorker()) {
     return;
   }
 
@@ -2738,6 +3373,14 @@ void CGisItemTrk::checkForInvalidPoints() {
   }
 }
 
+void CGisItemTrk::moveToThread(QThread* thread) {
+  limitsGraph1.moveToThread(thread);
+  limitsGraph2.moveToThread(thread);
+  limitsGraph3.moveToThread(thread);
+  limitsGraphRange.moveToThread(thread);
+  colorSourceLimit.moveToThread(thread);
+}
+
 QMap<searchProperty_e, CGisItemTrk::fSearch> CGisItemTrk::keywordLambdaMap = CGisItemTrk::initKeywordLambdaMap();
 QMap<searchProperty_e, CGisItemTrk::fSearch> CGisItemTrk::initKeywordLambdaMap() {
   QMap<searchProperty_e, CGisItemTrk::fSearch> map;
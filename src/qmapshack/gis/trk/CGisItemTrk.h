@@ -25,6 +25,7 @@
 #include <QDebug>
 #include <QPen>
 #include <QPointer>
+#include <QTransform>
 #include <functional>
 
 #include "gis/IGisItem.h"
@@ -35,6 +36,7 @@
 #include "gis/trk/filter/CFilterSpeedCycle.h"
 #include "gis/trk/filter/CFilterSpeedHike.h"
 #include "helpers/CLimit.h"
+#include "helpers/CMinMaxTree.h"
 #include "helpers/CValue.h"
 
 using std::numeric_limits;
@@ -51,6 +53,9 @@ class CProgressDialog;
 class CPropertyTrk;
 class CFitStream;
 class CCanvas;
+class QThread;
+class QXmlStreamReader;
+class QXmlStreamWriter;
 
 #define ASCENT_THRESHOLD 5
 #define MIN_WIDTH_INFO_BOX 300
@@ -96,6 +101,9 @@ class CGisItemTrk : public IGisItem, public IGisLine {
   /** @brief Used to create track from GPX file */
   CGisItemTrk(const QDomNode& xml, IGisProject* project);
 
+  /** @brief Used to create track from a streamed GPX file */
+  CGisItemTrk(QXmlStreamReader& xml, IGisProject* project);
+
   /** @brief Used to restore track from history structure */
   CGisItemTrk(const history_t& hist, const QString& dbHash, IGisProject* project);
 
@@ -136,6 +144,22 @@ class CGisItemTrk : public IGisItem, public IGisLine {
    */
   void updateVisuals(quint32 visuals, const QString& who);
 
+  /**
+     @brief Show the dialog about invalid track points if there are any
+
+     This is a no-op for tracks loaded by a worker thread. IGisProject::finishLoading() will call it again.
+   */
+  void checkForInvalidPoints();
+
+  /**
+     @brief Change the thread affinity of all QObjects owned by the track
+
+     Must be called by the thread that created the track.
+
+     @param thread    the new thread
+   */
+  void moveToThread(QThread* thread);
+
   /**
      @brief Create a cloned copy of this track
      @return The cloned item a pointer
@@ -148,6 +172,12 @@ class CGisItemTrk : public IGisItem, public IGisLine {
    */
   void save(QDomNode& gpx, bool strictGpx11) override;
 
+  /**
+     @brief Stream track as <trk> element to a GPX file
+     @param xml   The stream writer, positioned inside the <gpx> element
+   */
+  void save(QXmlStreamWriter& xml, bool strictGpx11);
+
   /**
      @brief Save track to TwoNav track file
      @param dir   the path to store the file
@@ -294,9 +324,24 @@ class CGisItemTrk : public IGisItem, public IGisLine {
   qreal getMax(const QString& source) const;
 
  private:
-  void drawColorized(QPainter& p) const;
-  void drawColorizedByActivity(QPainter& p) const;
+  void drawColorized(QPainter& p, const QPolygonF& line) const;
+  void drawColorizedByActivity(QPainter& p, const QPolygonF& line) const;
   void setPen(QPainter& p, QPen& pen, trkact_t act) const;
+  /**
+     @brief Update the track line in projected coordinates if the data or the projection changed
+     @param gis   the draw context
+   */
+  void updateLinesM(CGisDraw* gis);
+  /**
+     @brief Get the track line simplified for the current zoom level
+     @param pixelSize     the size of a pixel in projected coordinates
+     @return A reference to the simplified line in projected coordinates
+   */
+  const QPolygonF& getLineSimpleLod(qreal pixelSize);
+  /// the track line of the last draw in screen pixel coordinates, transformed on first use
+  const QPolygonF& getLineSimple();
+  /// all points of the last draw in screen pixel coordinates, transformed on first use. Empty in normal mode.
+  const QPolygonF& getLineFull();
   /**@}*/
 
  public:
@@ -614,6 +659,8 @@ class CGisItemTrk : public IGisItem, public IGisLine {
   void updateHistory() override { updateHistory(eVisualAll); }
 
   void setSymbol() override;
+  quint8 writeItemData(QByteArray& buffer) const override;
+  void readItemData(const QByteArray& buffer, quint8 version) override;
   /**
      @brief Read track data from section in GPX file
      @param xml   The XML <trk> section
@@ -621,6 +668,19 @@ class CGisItemTrk : public IGisItem, public IGisLine {
    */
   void readTrk(const QDomNode& xml, CTrackData& trk);
 
+  /**
+     @brief Read track data from a streamed GPX file
+     @param xml   The stream reader positioned on the <trk> start element
+     @param trk   The track structure to fill
+   */
+  void readTrk(QXmlStreamReader& xml, CTrackData& trk);
+
+  /// read all track data but the segments from a <trk> element
+  void readTrkHeader(const QDomNode& xml, CTrackData& trk);
+
+  /// write all track data but the segments to a <trk> element
+  void saveHeader(QDomElement& xmlTrk, bool strictGpx11);
+
   /**
      @brief Restore track from TwoNav *trk file
      @param filename
@@ -643,6 +703,23 @@ class CGisItemTrk : public IGisItem, public IGisLine {
      This has to be called each time the track data is changed.
    */
   void deriveSecondaryData();
+  /**
+     @brief Update the secondary data after a local change of the track data
+
+     Only the points within the range may have changed their position,
+     elevation, time or visibility. The number of points must be the same.
+     The values of the changed points are derived again. Accumulated values
+     after the change are shifted, slope and speed are derived again close
+     to the change only. Extrema are taken from the trees of the derive
+     state. If the track does not match the state of the last derivation a
+     full derivation is done.
+
+     @param idx1  the total index of the first changed point
+     @param idx2  the total index of the last changed point
+   */
+  void deriveSecondaryData(qint32 idx1, qint32 idx2);
+  /// update all objects depending on the secondary data
+  void updateSecondaryObjects();
 
   /**
    * @brief Reset internal data like range selection and details dialog
@@ -683,6 +760,45 @@ class CGisItemTrk : public IGisItem, public IGisLine {
   QSet<QString> existingExtensions;
   QHash<QString, limits_t> extrema;
   void updateExtremaAndExtensions();
+  void updateExtremaFromDeriveState(const QVector<CTrackData::trkpt_t*>& alltrk,
+                                    const QVector<CTrackData::trkpt_t*>& lintrk);
+  void addInternalExtrema(const limits_t& extremaEle, const limits_t& extremaSlope, const limits_t& extremaSpeed,
+                          const limits_t& extremaProgress);
+
+  /**
+     \defgroup DeriveState State kept to update the secondary data after local changes
+
+     The trees and counters are indexed by the point's total index. Hidden
+     points are empty entries. They are built by the first local change
+     and dropped by a full derivation.
+   */
+  /**@{*/
+  /// the reference elevation of the ascent/descent hysteresis after each point
+  QVector<qint32> eleRefs;
+  bool hasDeriveState = false;
+  /// the number of visible points for each bit of trkpt_t::valid
+  QVector<qint32> cntValidBits;
+  CMinMaxTree treeLon;
+  CMinMaxTree treeLat;
+  CMinMaxTree treeEle;
+  CMinMaxTree treeSlope;
+  CMinMaxTree treeSpeed;
+  /// the real values of each extension
+  QHash<QString, CMinMaxTree> treeExtensions;
+  /// the number of visible points with a real or non real value for each extension
+  QHash<QString, qint32> cntRealExtensions;
+  QHash<QString, qint32> cntNonRealExtensions;
+  /// all points by total index and the visible points by visible index
+  QVector<CTrackData::trkpt_t*> derivePtsAll;
+  QVector<CTrackData::trkpt_t*> derivePtsVisible;
+
+  void buildDeriveState(const QVector<CTrackData::trkpt_t*>& alltrk);
+  void resetDeriveState();
+  /// true if derivePtsAll still points into the track's point arrays
+  bool isDerivePtsValid();
+  void updateDeriveState(const CTrackData::trkpt_t& trkpt, bool wasVisible);
+  void countValid(quint32 valid, qint32 sign);
+  /**@}*/
 
   enum limit_type_e { eLimitTypeMin, eLimitTypeMax };
   void drawLimitLabels(limit_type_e type, const QString& label, const QPointF& pos, QPainter& p,
@@ -707,6 +823,17 @@ class CGisItemTrk : public IGisItem, public IGisLine {
      @param l     A polyline with coordinates [rad]
    */
   void readTrackDataFromGisLine(const SGisLine& l);
+  /**
+     @brief Move the trackpoints changed in the polyline in place
+
+     This is possible if the track is a plain line already, e.g. by a previous
+     edit, and the polyline has the same points. Only the moved points are
+     derived again then.
+
+     @param l     A polyline with coordinates [rad]
+     @return True if the track has been updated.
+   */
+  bool moveTrackDataFromGisLine(const SGisLine& l);
   /**
      @brief Override IGisItem::changed() method
 
@@ -793,8 +920,6 @@ class CGisItemTrk : public IGisItem, public IGisLine {
   qreal totalElapsedSecondsMoving = 0;
   quint32 numberOfAttachedWpt = 0;
   CEnergyCycling energyCycling{*this};
-
-  void checkForInvalidPoints();
   /**@}*/
 
   /**
@@ -806,8 +931,21 @@ class CGisItemTrk : public IGisItem, public IGisLine {
   QColor color;           //< the track line color
 
   QPixmap bullet;        //< the trackpoint bullet icon
-  QPolygonF lineSimple;  //< the current track line as screen pixel coordinates
-  QPolygonF lineFull;    //< visible and invisible points
+  QPolygonF lineSimple;  //< the current track line as screen pixel coordinates, use getLineSimple()
+  QPolygonF lineFull;    //< visible and invisible points, use getLineFull()
+  /// the transformation of the last draw from projected to screen pixel coordinates
+  QTransform trafoM2Px;
+  bool isLineSimpleValid = true;  //< false if lineSimple has to be transformed from lineSimpleM
+  bool isLineFullValid = true;    //< false if lineFull has to be transformed from lineFullM
+
+  /// lineSimple in projected coordinates, valid as long as data and projection do not change
+  QPolygonF lineSimpleM;
+  /// lineFull in projected coordinates, only used in range mode
+  QPolygonF lineFullM;
+  /// the projection lineSimpleM and lineFullM are valid for, -1 if they have to be updated
+  qint32 projectionIdM = -1;
+  /// lineSimpleM simplified by Douglas Peucker for each zoom level, keyed by pixel size
+  QMap<qreal, QPolygonF> lineSimpleLod;
 
   qint32 penWidthFg = 1;   //< inner trackline width
   qint32 penWidthBg = 3;   //< outer trackline width
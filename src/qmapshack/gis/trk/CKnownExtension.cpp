@@ -18,6 +18,7 @@
 
 #include "gis/trk/CKnownExtension.h"
 
+#include <QReadWriteLock>
 #include <QStringBuilder>
 
 #include "units/IUnit.h"
@@ -34,6 +35,9 @@ QSet<QString> CKnownExtension::registeredNS;
 
 static const int NOORDER = std::numeric_limits<int>::max();
 
+// GPX files register their namespaces while they are loaded by worker threads
+static QReadWriteLock lockExtensions(QReadWriteLock::Recursive);
+
 static fTrkPtGetVal getExtensionValueFunc(const QString ext) {
   return [ext](const CTrackData::trkpt_t& p) {
     bool ok;
@@ -52,6 +56,7 @@ bool CKnownExtension::registerNS(const QString& ns) {
 }
 
 void CKnownExtension::initGarminTPXv1(const IUnit& units, const QString& ns) {
+  QWriteLocker lock(&lockExtensions);
   if (!registerNS(ns)) {
     return;
   }
@@ -90,6 +95,7 @@ void CKnownExtension::initGarminTPXv1(const IUnit& units, const QString& ns) {
 }
 
 void CKnownExtension::initMioTPX(const IUnit& units) {
+  QWriteLocker lock(&lockExtensions);
   // support for extensions used by MIO Cyclo ver. 4.2 (who needs xml namespaces?!)
   knownExtensions.insert("heartrate",
                          {tr("Heart R.", "extShortName"), tr("Heart Rate", "extLongName"), NOORDER, 0., 300., 1., "bpm",
@@ -114,6 +120,7 @@ void CKnownExtension::initMioTPX(const IUnit& units) {
 }
 
 void CKnownExtension::initClueTrustTPXv1(const IUnit& units, const QString& ns) {
+  QWriteLocker lock(&lockExtensions);
   knownExtensions.insert(ns % ":cadence",
                          {tr("Cadence", "extShortName"), tr("Cadence", "extLongName"), 0, 0., 500., 1., "rpm",
                           "://icons/32x32/CSrcCAD.png", true, false, getExtensionValueFunc(ns % ":cadence")});
@@ -152,6 +159,7 @@ void CKnownExtension::initClueTrustTPXv1(const IUnit& units, const QString& ns)
 }
 
 void CKnownExtension::init(const IUnit& units) {
+  QWriteLocker lock(&lockExtensions);
   knownExtensions = {
       {internalSlope,
        {tr("Slope", "extShortName"), tr("Slope*"), -1, -90., 90., 1.,
@@ -194,10 +202,14 @@ void CKnownExtension::init(const IUnit& units) {
 const CKnownExtension CKnownExtension::get(const QString& key) {
   CKnownExtension def("", "", NOORDER, -100000., 100000., 1., "", "://icons/32x32/CSrcUnknown.png", false, true,
                       getExtensionValueFunc(key));
+  QReadLocker lock(&lockExtensions);
   return knownExtensions.value(key, def);
 }
 
-bool CKnownExtension::isKnown(const QString& key) { return knownExtensions.contains(key); }
+bool CKnownExtension::isKnown(const QString& key) {
+  QReadLocker lock(&lockExtensions);
+  return knownExtensions.contains(key);
+}
 
 QString CKnownExtension::getName(const QString& altName) const {
   bool hasNoName = nameShortText.isEmpty();
@@ -0,0 +1,230 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "gis/trk/CTrackColumns.h"
+
+const qint64 CTrackColumns::NOTIME64;
+
+// The extension ids are shared by all tracks. Tracks are loaded by worker
+// threads, too. Thus access has to be guarded.
+static QReadWriteLock lockExtensionIds;
+static QHash<QString, qint32> extensionIds;
+static QStringList extensionKeys;
+
+qint32 CTrackColumns::extensionId(const QString& key) {
+  {
+    QReadLocker lock(&lockExtensionIds);
+    auto it = extensionIds.constFind(key);
+    if (it != extensionIds.constEnd()) {
+      return it.value();
+    }
+  }
+
+  QWriteLocker lock(&lockExtensionIds);
+  auto it = extensionIds.constFind(key);
+  if (it != extensionIds.constEnd()) {
+    return it.value();
+  }
+
+  const qint32 id = extensionKeys.size();
+  extensionKeys << key;
+  extensionIds[key] = id;
+  return id;
+}
+
+QString CTrackColumns::extensionKey(qint32 id) {
+  QReadLocker lock(&lockExtensionIds);
+  return extensionKeys.value(id);
+}
+
+// Extensions are not checked. They are stored in the extension columns.
+static bool hasAttributes(const IGisItem::wpt_t& wpt) {
+  return !wpt.name.isEmpty() || !wpt.cmt.isEmpty() || !wpt.desc.isEmpty() || !wpt.src.isEmpty() ||
+         !wpt.links.isEmpty() || !wpt.sym.isEmpty() || !wpt.type.isEmpty() || !wpt.fix.isEmpty() ||
+         (wpt.magvar != NOINT) || (wpt.geoidheight != NOINT) || (wpt.sat != NOINT) || (wpt.hdop != NOINT) ||
+         (wpt.vdop != NOINT) || (wpt.pdop != NOINT) || (wpt.ageofdgpsdata != NOINT) || (wpt.dgpsid != NOINT);
+}
+
+CTrackColumns::CTrackColumns(const CTrackData& trk) {
+  qint32 N = 0;
+  for (const CTrackData::trkseg_t& seg : trk.segs) {
+    N += seg.pts.size();
+  }
+
+  lon.reserve(N);
+  lat.reserve(N);
+  ele.reserve(N);
+  time.reserve(N);
+  flags.reserve(N);
+  activity.reserve(N);
+
+  for (const CTrackData::trkseg_t& seg : trk.segs) {
+    newSegment();
+    for (const trkpt_t& pt : seg.pts) {
+      append(pt);
+    }
+  }
+}
+
+void CTrackColumns::clear() {
+  segStart.clear();
+  lon.clear();
+  lat.clear();
+  ele.clear();
+  time.clear();
+  flags.clear();
+  activity.clear();
+  extensions.clear();
+  attributes.clear();
+  distance.clear();
+}
+
+void CTrackColumns::newSegment() {
+  // an empty segment is reused
+  if (segStart.isEmpty() || (segStart.last() != size())) {
+    segStart << size();
+  }
+}
+
+CTrackColumns::column_t& CTrackColumns::getColumn(qint32 id) {
+  for (column_t& column : extensions) {
+    if (column.id == id) {
+      return column;
+    }
+  }
+
+  extensions.append(column_t());
+  column_t& column = extensions.last();
+  column.id = id;
+  column.values.fill(NAN, size());
+  return column;
+}
+
+void CTrackColumns::append(const trkpt_t& pt) {
+  if (segStart.isEmpty()) {
+    segStart << 0;
+  }
+
+  const qint32 row = size();
+  lon << pt.lon;
+  lat << pt.lat;
+  ele << pt.ele;
+  time << (pt.time.isValid() ? pt.time.toMSecsSinceEpoch() : NOTIME64);
+  flags << pt.flags;
+  activity << qint16(pt.activity);
+
+  for (column_t& column : extensions) {
+    column.values << NAN;
+  }
+
+  for (auto it = pt.extensions.cbegin(); it != pt.extensions.cend(); ++it) {
+    column_t& column = getColumn(extensionId(it.key()));
+
+    bool ok = false;
+    const qreal value = it.value().toDouble(&ok);
+    if (ok) {
+      column.values[row] = value;
+    } else {
+      column.text[row] = it.value().toString();
+    }
+  }
+
+  if (hasAttributes(pt)) {
+    IGisItem::wpt_t& wpt = attributes[row];
+    wpt = pt;
+    wpt.extensions.clear();
+  }
+}
+
+CTrackData::trkpt_t CTrackColumns::at(qint32 row) const {
+  trkpt_t pt;
+
+  auto it = attributes.constFind(row);
+  if (it != attributes.constEnd()) {
+    static_cast<IGisItem::wpt_t&>(pt) = it.value();
+  }
+
+  pt.lon = lon[row];
+  pt.lat = lat[row];
+  pt.ele = ele[row];
+  if (time[row] != NOTIME64) {
+    pt.time = QDateTime::fromMSecsSinceEpoch(time[row], Qt::UTC);
+  }
+  pt.flags = flags[row];
+  pt.activity = trkact_t(activity[row]);
+
+  for (const column_t& column : extensions) {
+    const qreal value = column.values[row];
+    if (!qIsNaN(value)) {
+      pt.extensions[extensionKey(column.id)] = value;
+    } else if (column.text.contains(row)) {
+      pt.extensions[extensionKey(column.id)] = column.text[row];
+    }
+  }
+
+  return pt;
+}
+
+void CTrackColumns::toTrackData(CTrackData& trk) const {
+  const int N = segStart.size();
+  for (int n = 0; n < N; n++) {
+    const qint32 rowEnd = (n + 1 < N) ? segStart[n + 1] : size();
+
+    CTrackData::trkseg_t seg;
+    seg.pts.reserve(rowEnd - segStart[n]);
+    for (qint32 row = segStart[n]; row < rowEnd; row++) {
+      seg.pts << at(row);
+    }
+    trk.segs << seg;
+  }
+}
+
+qreal CTrackColumns::extension(qint32 id, qint32 row) const {
+  for (const column_t& column : extensions) {
+    if (column.id == id) {
+      return column.values[row];
+    }
+  }
+  return NAN;
+}
+
+const QVector<qreal>& CTrackColumns::getDistance() const {
+  // Rows are only appended. Thus the distance has to be calculated for new rows only.
+  qint32 row = distance.size();
+  qreal sum = distance.isEmpty() ? 0 : distance.last();
+  qint32 last = row - 1;
+  while ((last >= 0) && (flags[last] & trkpt_t::eFlagHidden)) {
+    --last;
+  }
+
+  // same as CGisItemTrk: hidden points keep the distance of the last visible point
+  const qint32 N = size();
+  distance.resize(N);
+  for (; row < N; row++) {
+    if (!(flags[row] & trkpt_t::eFlagHidden)) {
+      if (last >= 0) {
+        sum += GPS_Math_Distance(lon[last] * DEG_TO_RAD, lat[last] * DEG_TO_RAD, lon[row] * DEG_TO_RAD,
+                                 lat[row] * DEG_TO_RAD);
+      }
+      last = row;
+    }
+    distance[row] = sum;
+  }
+
+  return distance;
+}
@@ -0,0 +1,132 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CTRACKCOLUMNS_H
+#define CTRACKCOLUMNS_H
+
+#include "gis/trk/CTrackData.h"
+
+/**
+   @brief Compact column store for the tracks of realtime records
+
+   A CTrackData::trkpt_t carries the complete waypoint structure, all derived values and a hash
+   of extensions. That is several hundred bytes per point. This class keeps the raw data of a
+   track in one array per value instead. Row n is the n-th point of the track.
+
+   Extensions are stored as numeric columns keyed by an interned extension id. Values missing in
+   a row are NAN. The few extension values that are no numbers and the rarely used GPX fields
+   like name or description are stored sparse, for the rows that actually have them.
+
+   Derived values are not stored. Use CGisItemTrk for that. Only the distance is calculated
+   on demand, as it is needed by about any consumer.
+
+   The iterator rebuilds a full CTrackData::trkpt_t for each row. This is a read only view for
+   code taking track points. Time critical code should access the columns directly. Rows are only
+   appended, never changed.
+
+   This store is used by the realtime records (IRtRecord) only, as their tracks grow without
+   limit. It does not replace the storage of CTrackData. Loaded tracks (CGisItemTrk) still keep
+   a CTrackData::trkpt_t per point, because filters, the editor and the derivation of secondary
+   data change those points in place by reference. That would need a writable accessor per
+   point first.
+ */
+class CTrackColumns final {
+ public:
+  using trkpt_t = CTrackData::trkpt_t;
+
+  CTrackColumns() = default;
+  explicit CTrackColumns(const CTrackData& trk);
+
+  qint32 size() const { return lon.size(); }
+  bool isEmpty() const { return lon.isEmpty(); }
+
+  void clear();
+  /// start a new segment. The next point appended will be the first of the segment
+  void newSegment();
+  /// append a point to the last segment
+  void append(const trkpt_t& pt);
+
+  /// rebuild the track point of a row, all derived values are reset
+  trkpt_t at(qint32 row) const;
+  /// append all segments to a track
+  void toTrackData(CTrackData& trk) const;
+
+  /// the value of an extension at row or NAN if not set or no number
+  qreal extension(qint32 id, qint32 row) const;
+
+  /// the distance [m] from the start of the track for each row, calculated on demand
+  const QVector<qreal>& getDistance() const;
+
+  /// get a unique id for an extension key like "gpxtpx:TrackPointExtension|gpxtpx:hr"
+  static qint32 extensionId(const QString& key);
+  /// the key of an extension id
+  static QString extensionKey(qint32 id);
+
+  class iterator : public std::iterator<std::forward_iterator_tag, const trkpt_t> {
+    const CTrackColumns& columns;
+    qint32 row = 0;
+    trkpt_t pt;
+
+   public:
+    explicit iterator(const CTrackColumns& columns, qint32 row) : columns(columns), row(row) {}
+
+    iterator& operator++() {
+      ++row;
+      return *this;
+    }
+
+    bool operator==(const iterator& other) const { return (&columns == &other.columns) && (row == other.row); }
+
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    const trkpt_t& operator*() {
+      pt = columns.at(row);
+      return pt;
+    }
+  };
+
+  iterator begin() const { return iterator(*this, 0); }
+  iterator end() const { return iterator(*this, size()); }
+
+  QVector<qint32> segStart;  //< the first row of each segment
+  QVector<qreal> lon;        //< [°]
+  QVector<qreal> lat;        //< [°]
+  QVector<qint32> ele;       //< [m] or NOINT
+  QVector<qint64> time;      //< [ms] since epoch UTC or NOTIME64 if invalid
+  QVector<quint32> flags;
+  QVector<qint16> activity;
+
+  static const qint64 NOTIME64 = 0x7FFFFFFFFFFFFFFF;
+
+ private:
+  struct column_t {
+    qint32 id;
+    QVector<qreal> values;
+    QHash<qint32, QString> text;  //< values that are no numbers by row
+  };
+
+  column_t& getColumn(qint32 id);
+
+  QVector<column_t> extensions;
+  /// rows with any other GPX field set, like name, description or links. Without the extensions.
+  QHash<qint32, IGisItem::wpt_t> attributes;
+
+  mutable QVector<qreal> distance;
+};
+
+#endif  // CTRACKCOLUMNS_H
@@ -406,6 +406,11 @@ QPointF CGisItemWpt::getPointCloseBy(const QPoint& point) {
 }
 
 void CGisItemWpt::setIcon() {
+  if (IGisProject::isLoadedByWorker()) {
+    // the icon is loaded by IGisProject::finishLoading() on the GUI thread
+    return;
+  }
+
   if (geocache.hasData) {
     if (geocache.available) {
       IGisItem::setIcon(CWptIconManager::self().getWptIconByName(geocache.type, focus));
@@ -303,6 +303,8 @@ class CGisItemWpt : public IGisItem {
  private:
   void setIcon();
   void setSymbol() override;
+  quint8 writeItemData(QByteArray& buffer) const override;
+  void readItemData(const QByteArray& buffer, quint8 version) override;
   void readGpx(const QDomNode& xml);
   void readTwoNav(const CTwoNavProject::wpt_t& tnvWpt);
   void readWptFromFit(CFitStream& stream);
@@ -0,0 +1,120 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "helpers/CBinaryDelta.h"
+
+#include <QDataStream>
+
+/// runs of equal bytes shorter than this are merged into the surrounding edits as an edit costs 12 bytes
+#define MIN_GAP 16
+
+QByteArray CBinaryDelta::create(const QByteArray& from, const QByteArray& to) {
+  const qint32 sizeFrom = from.size();
+  const qint32 sizeTo = to.size();
+  const qint32 sizeMin = qMin(sizeFrom, sizeTo);
+  const char* a = from.constData();
+  const char* b = to.constData();
+
+  qint32 prefix = 0;
+  while ((prefix < sizeMin) && (a[prefix] == b[prefix])) {
+    prefix++;
+  }
+  qint32 suffix = 0;
+  while ((prefix + suffix < sizeMin) && (a[sizeFrom - suffix - 1] == b[sizeTo - suffix - 1])) {
+    suffix++;
+  }
+
+  QByteArray delta;
+  QDataStream out(&delta, QIODevice::WriteOnly);
+  out.setByteOrder(QDataStream::LittleEndian);
+  out << quint32(sizeTo);
+
+  // replace sizeOld bytes at offset by sizeNew bytes at the same offset of the new version
+  auto addEdit = [&](qint32 offset, qint32 sizeOld, qint32 sizeNew) {
+    out << quint32(offset) << quint32(sizeOld) << quint32(sizeNew);
+    out.writeRawData(b + offset, sizeNew);
+  };
+
+  const qint32 endFrom = sizeFrom - suffix;
+  const qint32 endTo = sizeTo - suffix;
+  if (endFrom - prefix != endTo - prefix) {
+    // data has been inserted or removed
+    addEdit(prefix, endFrom - prefix, endTo - prefix);
+    return delta;
+  }
+
+  // data has been overwritten, store the runs of differing bytes only
+  qint32 i = prefix;
+  while (i < endFrom) {
+    const qint32 start = i;
+    qint32 end = i + 1;
+    qint32 gap = 0;
+    for (i = end; (i < endFrom) && (gap < MIN_GAP); i++) {
+      if (a[i] == b[i]) {
+        gap++;
+      } else {
+        gap = 0;
+        end = i + 1;
+      }
+    }
+    addEdit(start, end - start, end - start);
+
+    // skip to the next difference
+    i = end;
+    while ((i < endFrom) && (a[i] == b[i])) {
+      i++;
+    }
+  }
+
+  return delta;
+}
+
+bool CBinaryDelta::apply(const QByteArray& from, const QByteArray& delta, QByteArray& to) {
+  QDataStream in(delta);
+  in.setByteOrder(QDataStream::LittleEndian);
+
+  quint32 sizeTo;
+  in >> sizeTo;
+  if (in.status() != QDataStream::Ok) {
+    return false;
+  }
+
+  to.clear();
+  to.reserve(sizeTo);
+
+  quint32 pos = 0;
+  while (!in.atEnd()) {
+    quint32 offset, sizeOld, sizeNew;
+    in >> offset >> sizeOld >> sizeNew;
+    if ((in.status() != QDataStream::Ok) || (offset < pos) || (quint64(offset) + sizeOld > quint64(from.size())) ||
+        (quint64(to.size()) + (offset - pos) + sizeNew > sizeTo)) {
+      return false;
+    }
+
+    to.append(from.constData() + pos, offset - pos);
+    const qint32 size = to.size();
+    to.resize(size + sizeNew);
+    if (in.readRawData(to.data() + size, sizeNew) != qint32(sizeNew)) {
+      return false;
+    }
+    pos = offset + sizeOld;
+  }
+
+  to.append(from.constData() + pos, from.size() - pos);
+  return quint32(to.size()) == sizeTo;
+}
@@ -0,0 +1,58 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CBINARYDELTA_H
+#define CBINARYDELTA_H
+
+#include <QByteArray>
+
+/**
+   @brief Compact binary difference between two versions of a byte array
+
+   The delta is a list of edits, each replacing a range of the old data by
+   new bytes. It is found by stripping the common prefix and suffix. If the
+   remaining ranges have the same size, e.g. because some values have been
+   overwritten, only the differing runs are stored. Otherwise the remaining
+   range is replaced as a whole.
+
+   This is designed for serialized data with local changes, like the history
+   of an item after moving a point. It does not detect moved blocks.
+ */
+class CBinaryDelta {
+ public:
+  /**
+     @brief Create the delta to get from one version to another
+
+     @param from  the old version
+     @param to    the new version
+     @return The delta, never empty.
+   */
+  static QByteArray create(const QByteArray& from, const QByteArray& to);
+
+  /**
+     @brief Apply a delta created by create()
+
+     @param from  the old version used to create the delta
+     @param delta the delta
+     @param to    the new version
+     @return False if the delta is corrupt or does not match the old version.
+   */
+  static bool apply(const QByteArray& from, const QByteArray& delta, QByteArray& to);
+};
+
+#endif  // CBINARYDELTA_H
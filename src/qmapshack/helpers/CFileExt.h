@@ -52,7 +52,7 @@ class CFileExt : public QFile {
 #endif
 
  private:
-  static int cnt;
+  static QAtomicInt cnt;
 
   uchar* mapped;
   QSet<uchar*> mappedSections;
@@ -21,6 +21,7 @@
 #include "helpers/CSettings.h"
 
 QSet<CLimit*> CLimit::allLimits;
+QRecursiveMutex CLimit::mutexAllLimits;
 
 CLimit::CLimit(const QString& cfgPath, fGetLimit getMin, fGetLimit getMax, fGetLimit getMinAuto, fGetLimit getMaxAuto,
                fGetUnit getUnit, fMarkChanged markChanged)
@@ -31,10 +32,14 @@ CLimit::CLimit(const QString& cfgPath, fGetLimit getMin, fGetLimit getMax, fGetL
       funcGetMaxAuto(getMaxAuto),
       funcGetUnit(getUnit),
       funcMarkChanged(markChanged) {
+  QMutexLocker lock(&mutexAllLimits);
   allLimits << this;
 }
 
-CLimit::~CLimit() { allLimits.remove(this); }
+CLimit::~CLimit() {
+  QMutexLocker lock(&mutexAllLimits);
+  allLimits.remove(this);
+}
 
 void CLimit::setMode(mode_e m) {
   bool markAsChanged = mode != m;
@@ -161,6 +166,7 @@ void CLimit::setMax(const qreal& val) {
 QString CLimit::getUnit() const { return funcGetUnit(source); }
 
 void CLimit::updateSys() {
+  QMutexLocker lock(&mutexAllLimits);
   for (CLimit* limit : qAsConst(allLimits)) {
     if (limit != this) {
       limit->updateSys(source);
@@ -19,6 +19,7 @@
 #ifndef CLIMIT_H
 #define CLIMIT_H
 
+#include <QMutex>
 #include <QObject>
 #include <QSet>
 #include <QString>
@@ -80,6 +81,8 @@ class CLimit : public QObject {
   QString source;
 
   static QSet<CLimit*> allLimits;
+  /// tracks and their limits are created by worker threads, too
+  static QRecursiveMutex mutexAllLimits;
 };
 
 #endif  // CLIMIT_H
@@ -0,0 +1,222 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CLRUCACHE_H
+#define CLRUCACHE_H
+
+#include <QHash>
+#include <functional>
+#include <list>
+
+/**
+   @brief A size limited least recently used cache
+
+   Each entry is accounted with a size in bytes, given by the size function
+   or by the caller on insert. If the sum exceeds the limit the least
+   recently used entries are evicted. The most recent entry is always kept,
+   even if it exceeds the limit on its own.
+
+   The owner can keep entries from being evicted by a keep function and is
+   told about evicted entries by an evicted function. Memory used on behalf
+   of the entries, but not owned by a single one, can be added to the total
+   by addBytes().
+
+   The class is not thread safe. The owner has to serialize access.
+ */
+template <typename Key, typename Value>
+class CLruCache {
+ public:
+  struct stats_t {
+    quint64 hits = 0;       //< number of successful lookups
+    quint64 misses = 0;     //< number of failed lookups
+    quint64 evictions = 0;  //< number of entries removed to stay within the size limit
+    qint64 bytes = 0;       //< current size of all entries
+    qint32 entries = 0;     //< current number of entries
+
+    qreal hitRate() const { return (hits + misses) ? qreal(hits) / (hits + misses) : 0.0; }
+  };
+
+  using fSize = std::function<qint64(const Value&)>;
+  using fKeep = std::function<bool(const Key&, const Value&)>;
+  using fEvicted = std::function<void(const Key&, Value&)>;
+
+  CLruCache(qint64 maxBytes, const fSize& size) : maxBytes(maxBytes), size(size) {}
+  virtual ~CLruCache() = default;
+
+  /**
+     @brief Lookup an entry and mark it as most recently used
+
+     @param key     the entry's key
+     @param value   the entry's value is assigned to this on success
+     @return True if the entry has been found
+   */
+  bool find(const Key& key, Value& value) {
+    Value* entry = find(key);
+    if (entry == nullptr) {
+      return false;
+    }
+    value = *entry;
+    return true;
+  }
+
+  /**
+     @brief Lookup an entry and mark it as most recently used
+
+     @param key     the entry's key
+     @return A pointer to the entry's value or nullptr
+   */
+  Value* find(const Key& key) {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+      stats.misses++;
+      return nullptr;
+    }
+
+    // move key to the front of the LRU list
+    lru.splice(lru.begin(), lru, it->lru);
+
+    stats.hits++;
+    return &it->value;
+  }
+
+  /// lookup an entry without changing the LRU order or statistics
+  Value* value(const Key& key) {
+    auto it = entries.find(key);
+    return it != entries.end() ? &it->value : nullptr;
+  }
+
+  const Value* value(const Key& key) const {
+    auto it = entries.constFind(key);
+    return it != entries.constEnd() ? &it->value : nullptr;
+  }
+
+  bool contains(const Key& key) const { return entries.contains(key); }
+
+  /**
+     @brief Insert or replace an entry
+
+     The entry becomes the most recently used one. If the cache exceeds
+     it's limit least recently used entries are evicted.
+
+     @param key     the entry's key
+     @param value   the value to cache
+     @return A reference to the cached value
+   */
+  Value& insert(const Key& key, const Value& value) { return insert(key, value, size(value)); }
+
+  /**
+     @brief Insert or replace an entry with a known size
+
+     @param key     the entry's key
+     @param value   the value to cache
+     @param bytes   the size of the value
+     @return A reference to the cached value
+   */
+  Value& insert(const Key& key, const Value& value, qint64 bytes) {
+    remove(key);
+
+    entry_t entry;
+    entry.value = value;
+    entry.bytes = bytes;
+    entry.lru = lru.insert(lru.begin(), key);
+    entries.insert(key, entry);
+
+    stats.bytes += bytes;
+    stats.entries++;
+
+    evict();
+    return entries[key].value;
+  }
+
+  void remove(const Key& key) {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+      return;
+    }
+
+    stats.bytes -= it->bytes;
+    stats.entries--;
+    lru.erase(it->lru);
+    entries.erase(it);
+  }
+
+  void clear() {
+    entries.clear();
+    lru.clear();
+    stats.bytes = 0;
+    stats.entries = 0;
+  }
+
+  /// add memory used on behalf of the entries to the total, negative values to remove it
+  void addBytes(qint64 bytes) { stats.bytes += bytes; }
+
+  void setMaxBytes(qint64 bytes) {
+    maxBytes = bytes;
+    evict();
+  }
+  qint64 getMaxBytes() const { return maxBytes; }
+
+  /// entries the function returns true for are not evicted
+  void setKeep(const fKeep& f) { keep = f; }
+  /// the function is called for each entry right before it's evicted
+  void setEvicted(const fEvicted& f) { evicted = f; }
+
+  /**
+     @brief Evict least recently used entries until the cache is within it's limit
+
+     Eviction stops at the first entry to keep. All more recent entries are
+     assumed to be needed, too.
+   */
+  void evict() {
+    while ((stats.bytes > maxBytes) && (lru.size() > 1)) {
+      const Key key = lru.back();
+      auto it = entries.find(key);
+      if (keep && keep(key, it->value)) {
+        break;
+      }
+      if (evicted) {
+        evicted(key, it->value);
+      }
+      remove(key);
+      stats.evictions++;
+    }
+  }
+
+  const stats_t& getStats() const { return stats; }
+
+ private:
+  struct entry_t {
+    Value value;
+    qint64 bytes = 0;
+    typename std::list<Key>::iterator lru;
+  };
+
+  qint64 maxBytes;
+  fSize size;
+  fKeep keep;
+  fEvicted evicted;
+
+  /// values by key
+  QHash<Key, entry_t> entries;
+  /// keys ordered by last access, most recent first
+  std::list<Key> lru;
+
+  stats_t stats;
+};
+
+#endif  // CLRUCACHE_H
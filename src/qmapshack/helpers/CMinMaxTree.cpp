@@ -0,0 +1,95 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "helpers/CMinMaxTree.h"
+
+void CMinMaxTree::build(const QVector<qreal>& values) {
+  clear();
+  if (values.isEmpty()) {
+    return;
+  }
+
+  this->values = values;
+
+  numLeaves = 1;
+  while (numLeaves < values.size()) {
+    numLeaves <<= 1;
+  }
+
+  idxMin.fill(NOIDX, 2 * numLeaves);
+  idxMax.fill(NOIDX, 2 * numLeaves);
+
+  for (qint32 i = 0; i < values.size(); i++) {
+    if (values[i] != NOFLOAT) {
+      idxMin[numLeaves + i] = i;
+      idxMax[numLeaves + i] = i;
+    }
+  }
+
+  for (qint32 node = numLeaves - 1; node > 0; --node) {
+    update(node);
+  }
+}
+
+void CMinMaxTree::clear() {
+  numLeaves = 0;
+  values.clear();
+  idxMin.clear();
+  idxMax.clear();
+}
+
+void CMinMaxTree::set(qint32 idx, qreal value) {
+  if ((idx < 0) || (idx >= values.size()) || (values[idx] == value)) {
+    return;
+  }
+
+  values[idx] = value;
+
+  qint32 node = numLeaves + idx;
+  idxMin[node] = idxMax[node] = (value != NOFLOAT) ? idx : NOIDX;
+
+  for (node >>= 1; node > 0; node >>= 1) {
+    update(node);
+  }
+}
+
+qint32 CMinMaxTree::pickMin(qint32 idx1, qint32 idx2) const {
+  if (idx1 == NOIDX) {
+    return idx2;
+  }
+  if (idx2 == NOIDX) {
+    return idx1;
+  }
+  // idx1 is always left of idx2, so it wins on equal values
+  return values[idx2] < values[idx1] ? idx2 : idx1;
+}
+
+qint32 CMinMaxTree::pickMax(qint32 idx1, qint32 idx2) const {
+  if (idx1 == NOIDX) {
+    return idx2;
+  }
+  if (idx2 == NOIDX) {
+    return idx1;
+  }
+  return values[idx2] > values[idx1] ? idx2 : idx1;
+}
+
+void CMinMaxTree::update(qint32 node) {
+  idxMin[node] = pickMin(idxMin[2 * node], idxMin[2 * node + 1]);
+  idxMax[node] = pickMax(idxMax[2 * node], idxMax[2 * node + 1]);
+}
@@ -0,0 +1,87 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CMINMAXTREE_H
+#define CMINMAXTREE_H
+
+#include <QVector>
+
+#include "units/IUnit.h"
+
+/**
+   @brief A segment tree keeping track of the minimum and maximum of a value list
+
+   Each node stores the index of the smallest and the largest value in its
+   subtree. Changing a single value updates its path to the root in
+   O(log n). The global extrema are read from the root in O(1).
+
+   NOFLOAT marks an empty entry that takes no part in the comparison. On
+   equal values the entry with the lower index wins. This is the same as
+   scanning the list from front to back and replacing the extremum only
+   on a strictly smaller or larger value.
+ */
+class CMinMaxTree {
+ public:
+  CMinMaxTree() = default;
+  virtual ~CMinMaxTree() = default;
+
+  /**
+     @brief Build the tree, replacing the previous content
+
+     @param values  all values, NOFLOAT for empty entries
+   */
+  void build(const QVector<qreal>& values);
+
+  void clear();
+
+  qint32 size() const { return values.size(); }
+
+  /**
+     @brief Change a single value
+
+     @param idx     the value's index as passed to build()
+     @param value   the new value, NOFLOAT to clear the entry
+   */
+  void set(qint32 idx, qreal value);
+
+  qreal value(qint32 idx) const { return values[idx]; }
+
+  /// the index of the smallest value or NOIDX if all entries are empty
+  qint32 getIdxMin() const { return idxMin.isEmpty() ? NOIDX : idxMin[1]; }
+  /// the index of the largest value or NOIDX if all entries are empty
+  qint32 getIdxMax() const { return idxMax.isEmpty() ? NOIDX : idxMax[1]; }
+
+  /// the smallest value or NOFLOAT if all entries are empty
+  qreal getMin() const { return getIdxMin() == NOIDX ? NOFLOAT : values[getIdxMin()]; }
+  /// the largest value or NOFLOAT if all entries are empty
+  qreal getMax() const { return getIdxMax() == NOIDX ? NOFLOAT : values[getIdxMax()]; }
+
+ private:
+  qint32 pickMin(qint32 idx1, qint32 idx2) const;
+  qint32 pickMax(qint32 idx1, qint32 idx2) const;
+  void update(qint32 node);
+
+  /// the number of leaves, a power of two
+  qint32 numLeaves = 0;
+  QVector<qreal> values;
+  /// the root at position 1, the leaves starting at numLeaves
+  QVector<qint32> idxMin;
+  QVector<qint32> idxMax;
+};
+
+#endif  // CMINMAXTREE_H
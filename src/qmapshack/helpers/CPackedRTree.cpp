@@ -0,0 +1,201 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "helpers/CPackedRTree.h"
+
+#include <QPair>
+#include <algorithm>
+#include <limits>
+
+const qint32 CPackedRTree::nodeSize;
+
+// Hilbert value of a point on a 2^16 x 2^16 grid,
+// see "Fast Hilbert curve generation, sorting and range queries" by rawrunprotected
+static quint32 hilbert(quint32 x, quint32 y) {
+  quint32 a = x ^ y;
+  quint32 b = 0xFFFF ^ a;
+  quint32 c = 0xFFFF ^ (x | y);
+  quint32 d = x & (y ^ 0xFFFF);
+
+  quint32 A = a | (b >> 1);
+  quint32 B = (a >> 1) ^ a;
+  quint32 C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+  quint32 D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  A = ((a & (a >> 2)) ^ (b & (b >> 2)));
+  B = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+  C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+  D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  A = ((a & (a >> 4)) ^ (b & (b >> 4)));
+  B = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+  C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+  D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+  D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+  a = C ^ (C >> 1);
+  b = D ^ (D >> 1);
+
+  quint32 i0 = x ^ y;
+  quint32 i1 = b | (0xFFFF ^ (i0 | a));
+
+  i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+  i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+  i0 = (i0 | (i0 << 2)) & 0x33333333;
+  i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+  i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+  i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+  i1 = (i1 | (i1 << 2)) & 0x33333333;
+  i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+  return (i1 << 1) | i0;
+}
+
+void CPackedRTree::build(const QVector<QRectF>& rects) {
+  clear();
+
+  numItems = rects.size();
+  if (numItems == 0) {
+    return;
+  }
+
+  // the number of nodes on each level, up to the root
+  qint32 n = numItems;
+  qint32 numNodes = n;
+  levelEnds << numNodes;
+  do {
+    n = (n + nodeSize - 1) / nodeSize;
+    numNodes += n;
+    levelEnds << numNodes;
+  } while (n != 1);
+
+  boxes.resize(numNodes);
+  indices.resize(numNodes);
+
+  // normalize all boxes and get the extent of all of them
+  const qreal max = std::numeric_limits<qreal>::max();
+  box_t extent = {max, max, -max, -max};
+  QVector<box_t> leaves(numItems);
+  for (qint32 i = 0; i < numItems; i++) {
+    const QRectF& rect = rects[i].normalized();
+    box_t& leaf = leaves[i];
+    leaf.x1 = rect.left();
+    leaf.y1 = rect.top();
+    leaf.x2 = rect.right();
+    leaf.y2 = rect.bottom();
+
+    extent.x1 = qMin(extent.x1, leaf.x1);
+    extent.y1 = qMin(extent.y1, leaf.y1);
+    extent.x2 = qMax(extent.x2, leaf.x2);
+    extent.y2 = qMax(extent.y2, leaf.y2);
+  }
+
+  // sort the leaves along the Hilbert curve, the index makes the order unique
+  const qreal w = extent.x2 - extent.x1;
+  const qreal h = extent.y2 - extent.y1;
+  QVector<QPair<quint32, qint32>> order(numItems);
+  for (qint32 i = 0; i < numItems; i++) {
+    const box_t& leaf = leaves[i];
+    const quint32 x = w > 0 ? quint32(0xFFFF * ((leaf.x1 + leaf.x2) / 2 - extent.x1) / w) : 0;
+    const quint32 y = h > 0 ? quint32(0xFFFF * ((leaf.y1 + leaf.y2) / 2 - extent.y1) / h) : 0;
+    order[i] = qMakePair(hilbert(x, y), i);
+  }
+  std::sort(order.begin(), order.end());
+
+  for (qint32 i = 0; i < numItems; i++) {
+    boxes[i] = leaves[order[i].second];
+    indices[i] = order[i].second;
+  }
+
+  // pack each level into the nodes of the next one
+  qint32 pos = 0;
+  for (qint32 level = 0; level < levelEnds.size() - 1; level++) {
+    const qint32 end = levelEnds[level];
+    qint32 parent = end;
+    while (pos < end) {
+      const qint32 first = pos;
+      box_t node = boxes[pos];
+      for (qint32 i = 0; (i < nodeSize) && (pos < end); i++, pos++) {
+        const box_t& child = boxes[pos];
+        node.x1 = qMin(node.x1, child.x1);
+        node.y1 = qMin(node.y1, child.y1);
+        node.x2 = qMax(node.x2, child.x2);
+        node.y2 = qMax(node.y2, child.y2);
+      }
+      boxes[parent] = node;
+      indices[parent] = first;
+      parent++;
+    }
+  }
+}
+
+void CPackedRTree::clear() {
+  numItems = 0;
+  boxes.clear();
+  indices.clear();
+  levelEnds.clear();
+}
+
+void CPackedRTree::query(const QRectF& area, QVector<qint32>& items) const {
+  items.clear();
+  if (numItems == 0) {
+    return;
+  }
+
+  const QRectF& rect = area.normalized();
+  const box_t q = {rect.left(), rect.top(), rect.right(), rect.bottom()};
+
+  // nodes to visit as pair of position and level
+  QVector<QPair<qint32, qint32>> stack;
+  stack << qMakePair(boxes.size() - 1, levelEnds.size() - 1);
+  while (!stack.isEmpty()) {
+    const QPair<qint32, qint32> node = stack.takeLast();
+    if (!overlaps(boxes[node.first], q)) {
+      continue;
+    }
+
+    const qint32 level = node.second;
+    if (level == 0) {
+      items << indices[node.first];
+      continue;
+    }
+
+    const qint32 first = indices[node.first];
+    const qint32 last = qMin(first + nodeSize, levelEnds[level - 1]);
+    for (qint32 i = first; i < last; i++) {
+      stack << qMakePair(i, level - 1);
+    }
+  }
+
+  std::sort(items.begin(), items.end());
+}
@@ -0,0 +1,85 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CPACKEDRTREE_H
+#define CPACKEDRTREE_H
+
+#include <QRectF>
+#include <QVector>
+
+/**
+   @brief A static R-tree, bulk loaded along a Hilbert curve
+
+   The tree is built once from a list of bounding boxes and can't be
+   changed afterwards. Items are addressed by their index in that list.
+   All leaves are sorted by the Hilbert value of their center and packed
+   into nodes of nodeSize entries. A query is O(log n + k).
+
+   The bounding boxes do not have to be normalized. Boxes touching the
+   queried area are reported as overlapping, too. This allows points as
+   items and as queries.
+ */
+class CPackedRTree {
+ public:
+  CPackedRTree() = default;
+  virtual ~CPackedRTree() = default;
+
+  /**
+     @brief Build the tree, replacing the previous content
+
+     @param rects   the bounding boxes of all items
+   */
+  void build(const QVector<QRectF>& rects);
+
+  void clear();
+
+  bool isEmpty() const { return numItems == 0; }
+  qint32 size() const { return numItems; }
+
+  /**
+     @brief Find all items overlapping an area
+
+     @param area    the area to query
+     @param items   the indices of all items found, in ascending order
+   */
+  void query(const QRectF& area, QVector<qint32>& items) const;
+
+ private:
+  struct box_t {
+    qreal x1;
+    qreal y1;
+    qreal x2;
+    qreal y2;
+  };
+
+  static bool overlaps(const box_t& a, const box_t& b) {
+    return (a.x1 <= b.x2) && (b.x1 <= a.x2) && (a.y1 <= b.y2) && (b.y1 <= a.y2);
+  }
+
+  static const qint32 nodeSize = 16;
+
+  qint32 numItems = 0;
+  /// all boxes, leaves first, root last
+  QVector<box_t> boxes;
+  /// the item's index for leaves, the position of the first child for nodes
+  QVector<qint32> indices;
+  /// the end position of each level in boxes, leaves first
+  QVector<qint32> levelEnds;
+};
+
+#endif  // CPACKEDRTREE_H
@@ -227,13 +227,10 @@ QPixmap CWptIconManager::getWptIconByName(const QString& name, QPointF& focus, Q
   QPixmap icon;
   QString path;
 
-  if (wptIcons.contains(name)) {
-    focus = wptIcons[name].focus;
-    path = wptIcons[name].path;
-  } else {
-    focus = wptIcons["Default"].focus;
-    path = wptIcons["Default"].path;
-  }
+  // read only access as projects are loaded by worker threads, too
+  const icon_t& wptIcon = wptIcons.contains(name) ? wptIcons.value(name) : wptIcons.value("Default");
+  focus = wptIcon.focus;
+  path = wptIcon.path;
 
   if (path.isEmpty()) {
     path = wptDefault;
@@ -0,0 +1,80 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "helpers/CXmlDomStream.h"
+
+QDomElement CXmlDomStream::read(QXmlStreamReader& xml, QDomDocument& doc) {
+  QDomElement elem = doc.createElement(xml.qualifiedName().toString());
+  const QXmlStreamAttributes& attributes = xml.attributes();
+  for (const QXmlStreamAttribute& attribute : attributes) {
+    elem.setAttribute(attribute.qualifiedName().toString(), attribute.value().toString());
+  }
+
+  while (!xml.atEnd()) {
+    switch (xml.readNext()) {
+      case QXmlStreamReader::StartElement:
+        elem.appendChild(read(xml, doc));
+        break;
+
+      case QXmlStreamReader::Characters:
+        // QDomDocument drops whitespace between elements, too
+        if (xml.isCDATA()) {
+          elem.appendChild(doc.createCDATASection(xml.text().toString()));
+        } else if (!xml.isWhitespace()) {
+          elem.appendChild(doc.createTextNode(xml.text().toString()));
+        }
+        break;
+
+      case QXmlStreamReader::EndElement:
+        return elem;
+
+      default:;
+    }
+  }
+
+  return elem;
+}
+
+void CXmlDomStream::write(QXmlStreamWriter& xml, const QDomNode& node) {
+  if (node.isElement()) {
+    const QDomElement& elem = node.toElement();
+    xml.writeStartElement(elem.tagName());
+    writeAttributes(xml, elem);
+    writeChildren(xml, elem);
+    xml.writeEndElement();
+  } else if (node.isCDATASection()) {
+    xml.writeCDATA(node.nodeValue());
+  } else if (node.isText()) {
+    xml.writeCharacters(node.nodeValue());
+  }
+}
+
+void CXmlDomStream::writeChildren(QXmlStreamWriter& xml, const QDomNode& node) {
+  for (QDomNode child = node.firstChild(); !child.isNull(); child = child.nextSibling()) {
+    write(xml, child);
+  }
+}
+
+void CXmlDomStream::writeAttributes(QXmlStreamWriter& xml, const QDomElement& elem) {
+  const QDomNamedNodeMap& attributes = elem.attributes();
+  const int N = attributes.count();
+  for (int n = 0; n < N; n++) {
+    const QDomAttr& attribute = attributes.item(n).toAttr();
+    xml.writeAttribute(attribute.name(), attribute.value());
+  }
+}
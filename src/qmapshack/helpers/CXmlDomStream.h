@@ -0,0 +1,78 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CXMLDOMSTREAM_H
+#define CXMLDOMSTREAM_H
+
+#include <QDomDocument>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+/**
+   @brief Bridge between streamed XML and small DOM trees
+
+   GPX and TCX files are read and written as a stream to keep track points
+   out of a DOM tree. Elements of bounded size like the metadata, waypoints
+   or routes are still handled by the DOM code. These functions move single
+   elements between the stream and a DOM document.
+
+   Namespace processing is expected to be off for the reader. Thus element
+   and attribute names are the qualified names, just as QDomDocument reports
+   them with namespace processing off.
+ */
+class CXmlDomStream {
+ public:
+  /**
+     @brief Read the current element of the stream into a DOM element
+
+     The reader has to be positioned on the start element. On return it is
+     positioned on the matching end element. The new element is not attached
+     to any node of the document.
+
+     @param xml   the stream reader
+     @param doc   the document to create the element with
+     @return The element including all attributes and child nodes.
+   */
+  static QDomElement read(QXmlStreamReader& xml, QDomDocument& doc);
+
+  /**
+     @brief Write a DOM node including all child nodes to a stream
+
+     @param xml   the stream writer
+     @param node  an element, text or CDATA node
+   */
+  static void write(QXmlStreamWriter& xml, const QDomNode& node);
+
+  /**
+     @brief Write all child nodes of a DOM node to a stream
+
+     @param xml   the stream writer
+     @param node  the parent node, not written itself
+   */
+  static void writeChildren(QXmlStreamWriter& xml, const QDomNode& node);
+
+  /**
+     @brief Write the attributes of a DOM element to a stream
+
+     @param xml   the stream writer, positioned right after a start element
+     @param elem  the element
+   */
+  static void writeAttributes(QXmlStreamWriter& xml, const QDomElement& elem);
+};
+
+#endif  // CXMLDOMSTREAM_H
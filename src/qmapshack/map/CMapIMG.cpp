@@ -44,8 +44,10 @@
 #undef DEBUG_SHOW_SUBDIV_BORDERS
 
 #define STREETNAME_THRESHOLD 5.0
+#define SUBDIV_CACHE_SIZE (64 * 1024 * 1024)
+#define SUBDIVS_PER_JOB 8
 
-int CFileExt::cnt = 0;
+QAtomicInt CFileExt::cnt = 0;
 
 static inline bool isCompletelyOutside(const QPolygonF& poly, const QRectF& viewport) {
   qreal north = -90.0 * DEG_TO_RAD;
@@ -117,6 +119,7 @@ static inline bool isCluttered(QVector<QRectF>& rectPois, const QRectF& rect) {
 CMapIMG::CMapIMG(const QString& filename, CMapDraw* parent)
     : IMap(eFeatVisibility | eFeatVectorItems | eFeatTypFile, parent),
       filename(filename),
+      subdivCache(SUBDIV_CACHE_SIZE),
       fm(CMainWindow::self().getMapFont()),
       selectedLanguage(NOIDX) {
   qDebug() << "------------------------------";
@@ -125,15 +128,29 @@ CMapIMG::CMapIMG(const QString& filename, CMapDraw* parent)
   try {
     readBasics();
     processPrimaryMapData();
+    buildSubdivIndex();
     setupTyp();
   } catch (const exce_t& e) {
     QMessageBox::critical(CMainWindow::getBestWidgetForParent(), tr("Failed ..."), e.msg, QMessageBox::Abort);
     return;
   }
 
+  connect(map, &CMapDraw::sigNeedsRedraw, this, &CMapIMG::slotNeedsRedraw);
+
   isActivated = true;
 }
 
+CMapIMG::~CMapIMG() {
+  threadPool.clear();
+  threadPool.waitForDone();
+
+  const CGarminSubdivCache::stats_t stats = subdivCache.getStats();
+  qDebug() << "IMG subdivision cache:" << filename << "hit rate" << stats.hitRate() << "hits" << stats.hits << "misses"
+           << stats.misses << "evictions" << stats.evictions << "subdivs" << stats.entries << "bytes" << stats.bytes;
+}
+
+void CMapIMG::slotNeedsRedraw() { threadPool.clear(); }
+
 void CMapIMG::loadConfig(QSettings& cfg) {
   IMap::loadConfig(cfg);
 
@@ -149,6 +166,9 @@ void CMapIMG::slotSetTypeFile(const QString& filename) {
 }
 
 void CMapIMG::setupTyp() {
+  // drop all objects decoded with the previous setup
+  subdivCache.clear();
+
   languages.clear();
   languages[0x00] = tr("Unspecified");
   languages[0x01] = tr("French");
@@ -438,6 +458,29 @@ void CMapIMG::setupTyp() {
       break;
     }
   }
+
+  setupTypeTables();
+}
+
+void CMapIMG::setupTypeTables() {
+  // polygons are drawn in reverse order of polygonDrawOrder
+  polygonTable.clear();
+  for (int n = polygonDrawOrder.size() - 1; n >= 0; --n) {
+    const quint32 type = polygonDrawOrder[n];
+    // types without properties get the default one
+    polygonTable.add(type, polygonProperties[type]);
+  }
+
+  // polylines are drawn in order of their type
+  polylineTable.clear();
+  for (auto it = polylineProperties.constBegin(); it != polylineProperties.constEnd(); ++it) {
+    polylineTable.add(it.key(), it.value());
+  }
+
+  pointTable.clear();
+  for (auto it = pointProperties.constBegin(); it != pointProperties.constEnd(); ++it) {
+    pointTable.add(it.key(), it.value());
+  }
 }
 
 void CMapIMG::readFile(CFileExt& file, quint32 offset, quint32 size, QByteArray& data) {
@@ -1051,6 +1094,54 @@ void CMapIMG::processPrimaryMapData() {
 #endif
 }
 
+void CMapIMG::buildSubdivIndex() {
+  subdivIndex.clear();
+
+  quint32 idxSubfile = 0;
+  for (const subfile_desc_t& subfile : qAsConst(subfiles)) {
+    for (const subdiv_desc_t& subdiv : subfile.subdivs) {
+      const subdiv_ref_t ref = {&subfile, idxSubfile, &subdiv};
+      subdivIndex[subdiv.level].refs << ref;
+    }
+    idxSubfile++;
+  }
+
+  for (subdiv_index_t& index : subdivIndex) {
+    QVector<QRectF> areas;
+    areas.reserve(index.refs.size());
+    for (const subdiv_ref_t& ref : qAsConst(index.refs)) {
+      areas << ref.subdiv->area;
+    }
+    index.tree.build(areas);
+  }
+}
+
+void CMapIMG::buildObjectIndex() {
+  QVector<QRectF> rects;
+  for (const CGarminPolygon& line : qAsConst(polygons)) {
+    rects << line.pixel.boundingRect();
+  }
+  indexPolygons.build(rects);
+
+  rects.clear();
+  for (const CGarminPolygon& line : qAsConst(polylines)) {
+    rects << line.pixel.boundingRect();
+  }
+  indexPolylines.build(rects);
+
+  rects.clear();
+  for (const CGarminPoint& pt : qAsConst(points)) {
+    rects << QRectF(pt.pos, pt.pos);
+  }
+  indexPoints.build(rects);
+
+  rects.clear();
+  for (const CGarminPoint& pt : qAsConst(pois)) {
+    rects << QRectF(pt.pos, pt.pos);
+  }
+  indexPois.build(rects);
+}
+
 quint8 CMapIMG::scale2bits(const QPointF& scale) {
   qint32 bits = 24;
   if (scale.x() >= 70000.0) {
@@ -1148,6 +1239,10 @@ void CMapIMG::draw(IDrawContext::buffer_t& buf) /* override */
   pois.clear();
   points.clear();
   labels.clear();
+  indexPolygons.clear();
+  indexPolylines.clear();
+  indexPoints.clear();
+  indexPois.clear();
 
   /**
      convertRad2Px() converts positions into screen coordinates. However the painter
@@ -1209,75 +1304,68 @@ void CMapIMG::draw(IDrawContext::buffer_t& buf) /* override */
   }
   drawLabels(p, labels);
 
+  // all objects are in [pixel] now
+  buildObjectIndex();
+
   p.restore();
 }
 
 void CMapIMG::loadVisibleData(bool fast, polytype_t& polygons, polytype_t& polylines, pointtype_t& points,
                               pointtype_t& pois, unsigned level, const QRectF& viewport, QPainter& p) {
-#ifndef Q_OS_WIN32
-  CFileExt file(filename);
-  if (!file.open(QIODevice::ReadOnly)) {
+  auto index = subdivIndex.constFind(level);
+  if (index == subdivIndex.constEnd()) {
     return;
   }
-#endif
-
-  for (const subfile_desc_t& subfile : qAsConst(subfiles)) {
-    //        qDebug() << "-------";
-    //        qDebug() << (viewport.topLeft() * RAD_TO_DEG) << (viewport.bottomRight() * RAD_TO_DEG);
-    //        qDebug() << (subfile.area.topLeft() * RAD_TO_DEG) << (subfile.area.bottomRight() * RAD_TO_DEG);
-    //        qDebug() << subfile.area.intersects(viewport);
 
-    if (!subfile.area.intersects(viewport)) {
-      continue;
-    }
-
-    if (map->needsRedraw()) {
-      break;
-    }
+  // the labels of cached subdivisions still show elevations in the old units
+  if (IUnit::self().type != subdivCacheUnitType) {
+    subdivCache.clear();
+    subdivCacheUnitType = IUnit::self().type;
+  }
 
-#ifdef Q_OS_WIN32
-    CFileExt file(filename);
-    if (!file.open(QIODevice::ReadOnly)) {
-      return;
-    }
-#endif
+  // all visible subdivisions and their objects, in the order of subfiles and subdivisions
+  QVector<subdiv_ref_t> visible;
+  QVector<garmin_subdiv_t> objects;
+  // the positions in visible of subdivisions missing in the cache
+  QVector<qint32> missing;
 
-    QByteArray rgndata;
-    readFile(file, subfile.parts["RGN"].offset, subfile.parts["RGN"].size, rgndata);
+  QVector<qint32> hits;
+  index->tree.query(viewport, hits);
 
-    // qDebug() << "rgn range" << Qt::hex << subfile.parts["RGN"].offset << (subfile.parts["RGN"].offset +
-    // subfile.parts["RGN"].size);
+  for (qint32 hit : qAsConst(hits)) {
+    const subdiv_ref_t& ref = index->refs[hit];
+    const subdiv_desc_t& subdiv = *ref.subdiv;
 
-    const QVector<subdiv_desc_t>& subdivs = subfile.subdivs;
-    // collect polylines
-    for (const subdiv_desc_t& subdiv : subdivs) {
-      // if(subdiv.level == level) qDebug() << "subdiv:" << subdiv.level << level <<  subdiv.area << viewport <<
-      // subdiv.area.intersects(viewport);
-      if (subdiv.level != level || !subdiv.area.intersects(viewport)) {
-        continue;
-      }
-      if (map->needsRedraw()) {
-        break;
-      }
-      loadSubDiv(file, subdiv, subfile.strtbl, rgndata, fast, viewport, polylines, polygons, points, pois);
+    const garmin_subdiv_key_t key = {ref.idxSubfile, subdiv.n};
+    garmin_subdiv_t cached;
+    if (!subdivCache.find(key, cached)) {
+      missing << visible.size();
+    }
+    visible << ref;
+    objects << cached;
 
 #ifdef DEBUG_SHOW_SECTION_BORDERS
-      const QRectF& a = subdiv.area;
-      qreal u[2] = {a.left(), a.right()};
-      qreal v[2] = {a.top(), a.bottom()};
+    const QRectF& a = subdiv.area;
+    qreal u[2] = {a.left(), a.right()};
+    qreal v[2] = {a.top(), a.bottom()};
 
-      QPolygonF poly;
-      poly << a.bottomLeft() << a.bottomRight() << a.topRight() << a.topLeft();
+    QPolygonF poly;
+    poly << a.bottomLeft() << a.bottomRight() << a.topRight() << a.topLeft();
 
-      map->convertRad2Px(poly);
+    map->convertRad2Px(poly);
 
-      p.setPen(QPen(Qt::magenta, 2));
-      p.setBrush(Qt::NoBrush);
-      p.drawPolygon(poly);
+    p.setPen(QPen(Qt::magenta, 2));
+    p.setBrush(Qt::NoBrush);
+    p.drawPolygon(poly);
 #endif  // DEBUG_SHOW_SECTION_BORDERS
-    }
+  }
 
 #ifdef DEBUG_SHOW_SUBDIV_BORDERS
+  for (const subfile_desc_t& subfile : qAsConst(subfiles)) {
+    if (!subfile.area.intersects(viewport)) {
+      continue;
+    }
+
     QPointF p1 = subfile.area.bottomLeft();
     QPointF p2 = subfile.area.bottomRight();
     QPointF p3 = subfile.area.topRight();
@@ -1292,23 +1380,105 @@ void CMapIMG::loadVisibleData(bool fast, polytype_t& polygons, polytype_t& polyl
     poly << p1 << p2 << p3 << p4;
     p.setPen(Qt::black);
     p.drawPolygon(poly);
+  }
 #endif  // DEBUG_SHOW_SUBDIV_BORDERS
 
-#ifdef Q_OS_WIN32
-    file.close();
-#else
-    file.free();
-#endif
+  /*
+      Split the missing subdivisions of each subfile into consecutive batches.
+      Each batch has to map and unmask the RGN part on it's own. Thus a small
+      subfile is decoded by a single worker, a large one by all of them.
+   */
+  QVector<decode_job_t> jobs;
+  for (qint32 first = 0; first < missing.size();) {
+    const subdiv_ref_t& ref = visible[missing[first]];
+    qint32 last = first;
+    while ((last < missing.size()) && (visible[missing[last]].subfile == ref.subfile)) {
+      last++;
+    }
+
+    const qint32 nMissing = last - first;
+    const qint32 nJobs = qMin(threadPool.maxThreadCount(), (nMissing + SUBDIVS_PER_JOB - 1) / SUBDIVS_PER_JOB);
+    for (qint32 n = 0; n < nJobs; n++) {
+      const qint32 start = first + n * nMissing / nJobs;
+      const qint32 stop = first + (n + 1) * nMissing / nJobs;
+
+      decode_job_t job;
+      job.subfile = ref.subfile;
+      job.idxSubfile = ref.idxSubfile;
+      job.indices = missing.mid(start, stop - start);
+      jobs << job;
+    }
+    first = last;
+  }
+
+  // the workers write into their own slots of objects, only
+  const subdiv_ref_t* pSubdivs = visible.constData();
+  garmin_subdiv_t* pObjects = objects.data();
+  QAtomicInt outOfMemory(0);
+
+  for (const decode_job_t& job : qAsConst(jobs)) {
+    if (map->needsRedraw()) {
+      break;
+    }
+    threadPool.start([this, &job, pSubdivs, pObjects, &outOfMemory]() {
+      decodeSubDivs(job, pSubdivs, pObjects, outOfMemory);
+    });
+  }
+  threadPool.waitForDone();
+
+  if (outOfMemory.loadRelaxed()) {
+    throw std::bad_alloc();
+  }
+
+  if (map->needsRedraw()) {
+    return;
+  }
+
+  // merge in the order of subfiles and subdivisions to get the same result as a single thread
+  for (const garmin_subdiv_t& subdiv : qAsConst(objects)) {
+    filterSubDiv(subdiv, fast, viewport, polylines, polygons, points, pois);
+  }
+}
+
+void CMapIMG::decodeSubDivs(const decode_job_t& job, const subdiv_ref_t* subdivs, garmin_subdiv_t* objects,
+                            QAtomicInt& outOfMemory) {
+  // each worker uses it's own mapping of the file and it's own unmasked copy of the RGN part
+  CFileExt file(filename);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  try {
+    QByteArray rgndata;
+    readFile(file, job.subfile->parts["RGN"].offset, job.subfile->parts["RGN"].size, rgndata);
+
+    for (qint32 idx : job.indices) {
+      // drop stale work as early as possible
+      if (map->needsRedraw()) {
+        break;
+      }
+
+      const subdiv_desc_t& subdiv = *subdivs[idx].subdiv;
+      garmin_subdiv_t& decoded = objects[idx];
+      loadSubDiv(file, subdiv, job.subfile->strtbl, rgndata, decoded);
+
+      const garmin_subdiv_key_t key = {job.idxSubfile, subdiv.n};
+      subdivCache.insert(key, decoded);
+    }
+  } catch (const std::bad_alloc&) {
+    outOfMemory.storeRelaxed(1);
+  } catch (const exce_t& e) {
+    qWarning() << "GarminIMG:" << e.msg;
   }
 
 #ifndef Q_OS_WIN32
-  file.close();
+  file.free();
 #endif
+  file.close();
 }
 
 void CMapIMG::loadSubDiv(CFileExt& file, const subdiv_desc_t& subdiv, IGarminStrTbl* strtbl, const QByteArray& rgndata,
-                         bool fast, const QRectF& viewport, polytype_t& polylines, polytype_t& polygons,
-                         pointtype_t& points, pointtype_t& pois) {
+                         garmin_subdiv_t& objects) {
   if (subdiv.rgn_start == subdiv.rgn_end && !subdiv.lengthPolygons2 && !subdiv.lengthPolylines2 &&
       !subdiv.lengthPoints2) {
     return;
@@ -1370,74 +1540,59 @@ void CMapIMG::loadSubDiv(CFileExt& file, const subdiv_desc_t& subdiv, IGarminStr
   CGarminPolygon p;
 
   // decode points
-  if (subdiv.hasPoints && !fast && getShowPOIs()) {
+  if (subdiv.hasPoints) {
     const quint8* pData = pRawData + opnt;
     const quint8* pEnd = pRawData + (oidx ? oidx : opline ? opline : opgon ? opgon : subdiv.rgn_end);
     while (pData < pEnd) {
       CGarminPoint p;
       pData += p.decode(subdiv.iCenterLng, subdiv.iCenterLat, subdiv.shift, pData);
 
-      // skip points outside our current viewport
-      if (!viewport.contains(p.pos)) {
-        continue;
-      }
-
       if (strtbl) {
         p.isLbl6 ? strtbl->get(file, p.lbl_ptr, IGarminStrTbl::poi, p.labels)
                  : strtbl->get(file, p.lbl_ptr, IGarminStrTbl::norm, p.labels);
       }
 
-      points.push_back(p);
+      objects.points.push_back(p);
     }
   }
 
   // decode indexed points
-  if (subdiv.hasIdxPoints && !fast && getShowPOIs()) {
+  if (subdiv.hasIdxPoints) {
     const quint8* pData = pRawData + oidx;
     const quint8* pEnd = pRawData + (opline ? opline : opgon ? opgon : subdiv.rgn_end);
     while (pData < pEnd) {
       CGarminPoint p;
       pData += p.decode(subdiv.iCenterLng, subdiv.iCenterLat, subdiv.shift, pData);
 
-      // skip points outside our current viewport
-      if (!viewport.contains(p.pos)) {
-        continue;
-      }
-
       if (strtbl) {
         p.isLbl6 ? strtbl->get(file, p.lbl_ptr, IGarminStrTbl::poi, p.labels)
                  : strtbl->get(file, p.lbl_ptr, IGarminStrTbl::norm, p.labels);
       }
 
-      pois.push_back(p);
+      objects.pois.push_back(p);
     }
   }
 
   // decode polylines
-  if (subdiv.hasPolylines && !fast && getShowPolylines()) {
+  if (subdiv.hasPolylines) {
     CGarminPolygon::cnt = 0;
     const quint8* pData = pRawData + opline;
     const quint8* pEnd = pRawData + (opgon ? opgon : subdiv.rgn_end);
     while (pData < pEnd) {
       pData += p.decode(subdiv.iCenterLng, subdiv.iCenterLat, subdiv.shift, true, pData, pEnd);
 
-      // skip points outside our current viewport
-      if (isCompletelyOutside(p.pixel, viewport)) {
-        continue;
-      }
-
       if (strtbl && !p.lbl_in_NET && p.lbl_info) {
         strtbl->get(file, p.lbl_info, IGarminStrTbl::norm, p.labels);
       } else if (strtbl && p.lbl_in_NET && p.lbl_info) {
         strtbl->get(file, p.lbl_info, IGarminStrTbl::net, p.labels);
       }
 
-      polylines.push_back(p);
+      objects.polylines.push_back(p);
     }
   }
 
   // decode polygons
-  if (subdiv.hasPolygons && getShowPolygons()) {
+  if (subdiv.hasPolygons) {
     CGarminPolygon::cnt = 0;
     const quint8* pData = pRawData + opgon;
     const quint8* pEnd = pRawData + subdiv.rgn_end;
@@ -1445,17 +1600,12 @@ void CMapIMG::loadSubDiv(CFileExt& file, const subdiv_desc_t& subdiv, IGarminStr
     while (pData < pEnd) {
       pData += p.decode(subdiv.iCenterLng, subdiv.iCenterLat, subdiv.shift, false, pData, pEnd);
 
-      // skip points outside our current viewport
-      if (isCompletelyOutside(p.pixel, viewport)) {
-        continue;
-      }
-
-      if (strtbl && !p.lbl_in_NET && p.lbl_info && !fast) {
+      if (strtbl && !p.lbl_in_NET && p.lbl_info) {
         strtbl->get(file, p.lbl_info, IGarminStrTbl::norm, p.labels);
-      } else if (strtbl && p.lbl_in_NET && p.lbl_info && !fast) {
+      } else if (strtbl && p.lbl_in_NET && p.lbl_info) {
         strtbl->get(file, p.lbl_info, IGarminStrTbl::net, p.labels);
       }
-      polygons.push_back(p);
+      objects.polygons.push_back(p);
     }
   }
 
@@ -1471,47 +1621,37 @@ void CMapIMG::loadSubDiv(CFileExt& file, const subdiv_desc_t& subdiv, IGarminStr
   //         qDebug() << "point len: " << Qt::hex << subdiv.lengthPoints2 << dec << subdiv.lengthPoints2;
   //         qDebug() << "point end: " << Qt::hex << subdiv.lengthPoints2 + subdiv.offsetPoints2;
 
-  if (subdiv.lengthPolygons2 && getShowPolygons()) {
+  if (subdiv.lengthPolygons2) {
     const quint8* pData = pRawData + subdiv.offsetPolygons2;
     const quint8* pEnd = pData + subdiv.lengthPolygons2;
     while (pData < pEnd) {
       //             qDebug() << "rgn offset:" << Qt::hex << (rgnoff + (pData - pRawData));
       pData += p.decode2(subdiv.iCenterLng, subdiv.iCenterLat, subdiv.shift, false, pData, pEnd);
 
-      // skip points outside our current viewport
-      if (isCompletelyOutside(p.pixel, viewport)) {
-        continue;
-      }
-
-      if (strtbl && !p.lbl_in_NET && p.lbl_info && !fast) {
+      if (strtbl && !p.lbl_in_NET && p.lbl_info) {
         strtbl->get(file, p.lbl_info, IGarminStrTbl::norm, p.labels);
       }
 
-      polygons.push_back(p);
+      objects.polygons.push_back(p);
     }
   }
 
-  if (subdiv.lengthPolylines2 && !fast && getShowPolylines()) {
+  if (subdiv.lengthPolylines2) {
     const quint8* pData = pRawData + subdiv.offsetPolylines2;
     const quint8* pEnd = pData + subdiv.lengthPolylines2;
     while (pData < pEnd) {
       //             qDebug() << "rgn offset:" << Qt::hex << (rgnoff + (pData - pRawData));
       pData += p.decode2(subdiv.iCenterLng, subdiv.iCenterLat, subdiv.shift, true, pData, pEnd);
 
-      // skip points outside our current viewport
-      if (isCompletelyOutside(p.pixel, viewport)) {
-        continue;
-      }
-
       if (strtbl && !p.lbl_in_NET && p.lbl_info) {
         strtbl->get(file, p.lbl_info, IGarminStrTbl::norm, p.labels);
       }
 
-      polylines.push_back(p);
+      objects.polylines.push_back(p);
     }
   }
 
-  if (subdiv.lengthPoints2 && !fast && getShowPOIs()) {
+  if (subdiv.lengthPoints2) {
     const quint8* pData = pRawData + subdiv.offsetPoints2;
     const quint8* pEnd = pData + subdiv.lengthPoints2;
     while (pData < pEnd) {
@@ -1519,33 +1659,65 @@ void CMapIMG::loadSubDiv(CFileExt& file, const subdiv_desc_t& subdiv, IGarminStr
       //             qDebug() << "rgn offset:" << Qt::hex << (rgnoff + (pData - pRawData));
       pData += p.decode2(subdiv.iCenterLng, subdiv.iCenterLat, subdiv.shift, pData, pEnd);
 
-      // skip points outside our current viewport
-      if (!viewport.contains(p.pos)) {
-        continue;
-      }
-
       if (strtbl) {
         p.isLbl6 ? strtbl->get(file, p.lbl_ptr, IGarminStrTbl::poi, p.labels)
                  : strtbl->get(file, p.lbl_ptr, IGarminStrTbl::norm, p.labels);
       }
-      pois.push_back(p);
+      objects.pois.push_back(p);
     }
   }
 }
 
-void CMapIMG::drawPolygons(QPainter& p, polytype_t& lines) {
-  const int N = polygonDrawOrder.size();
-  for (int n = 0; n < N; ++n) {
-    quint32 type = polygonDrawOrder[(N - 1) - n];
+void CMapIMG::filterSubDiv(const garmin_subdiv_t& objects, bool fast, const QRectF& viewport, polytype_t& polylines,
+                           polytype_t& polygons, pointtype_t& points, pointtype_t& pois) {
+  if (!fast && getShowPOIs()) {
+    for (const CGarminPoint& pt : objects.points) {
+      if (viewport.contains(pt.pos)) {
+        points.push_back(pt);
+      }
+    }
+    for (const CGarminPoint& pt : objects.pois) {
+      if (viewport.contains(pt.pos)) {
+        pois.push_back(pt);
+      }
+    }
+  }
 
-    p.setPen(polygonProperties[type].pen);
-    p.setBrush(CMainWindow::self().isNight() ? polygonProperties[type].brushNight : polygonProperties[type].brushDay);
+  if (!fast && getShowPolylines()) {
+    for (const CGarminPolygon& line : objects.polylines) {
+      if (!isCompletelyOutside(line.pixel, viewport)) {
+        polylines.push_back(line);
+      }
+    }
+  }
 
-    for (CGarminPolygon& line : lines) {
-      if (line.type != type) {
-        continue;
+  if (getShowPolygons()) {
+    for (const CGarminPolygon& line : objects.polygons) {
+      if (!isCompletelyOutside(line.pixel, viewport)) {
+        polygons.push_back(line);
       }
+    }
+  }
+}
+
+void CMapIMG::drawPolygons(QPainter& p, polytype_t& lines) {
+  QVector<qint32> order;
+  QVector<qint32> first;
+  polygonTable.bucket(lines, order, first);
 
+  const bool isNight = CMainWindow::self().isNight();
+  const int N = polygonTable.properties.size();
+  for (int n = 0; n < N; ++n) {
+    if (first[n] == first[n + 1]) {
+      continue;
+    }
+
+    const CGarminTyp::polygon_property& property = *polygonTable.properties[n];
+    p.setPen(property.pen);
+    p.setBrush(isNight ? property.brushNight : property.brushDay);
+
+    for (qint32 i = first[n]; i < first[n + 1]; ++i) {
+      CGarminPolygon& line = lines[order[i]];
       QPolygonF& poly = line.pixel;
 
       map->convertRad2Px(poly);
@@ -1554,8 +1726,8 @@ void CMapIMG::drawPolygons(QPainter& p, polytype_t& lines) {
 
       p.drawPolygon(poly);
 
-      if (!polygonProperties[type].known) {
-        qDebug() << "unknown polygon" << Qt::hex << type;
+      if (!property.known) {
+        qDebug() << "unknown polygon" << Qt::hex << line.type;
       }
     }
   }
@@ -1579,28 +1751,24 @@ void CMapIMG::drawPolylines(QPainter& p, polytype_t& lines, const QPointF& scale
       int deletedCount = 0;
    */
 
-  QHash<quint32, QList<quint32> > dict;
-  for (int i = 0; i < lines.count(); ++i) {
-    dict[lines[i].type].push_back(i);
-  }
-
-  QMap<quint32, CGarminTyp::polyline_property>::iterator props = polylineProperties.begin();
-  QMap<quint32, CGarminTyp::polyline_property>::iterator end = polylineProperties.end();
-  for (; props != end; ++props) {
-    const quint32& type = props.key();
-    const CGarminTyp::polyline_property& property = props.value();
+  QVector<qint32> order;
+  QVector<qint32> first;
+  polylineTable.bucket(lines, order, first);
 
-    if (dict[type].isEmpty()) {
+  const int N = polylineTable.properties.size();
+  for (int n = 0; n < N; ++n) {
+    if (first[n] == first[n + 1]) {
       continue;
     }
 
+    const CGarminTyp::polyline_property& property = *polylineTable.properties[n];
+
     if (property.hasPixmap) {
       const QImage& pixmap = CMainWindow::self().isNight() ? property.imgNight : property.imgDay;
       const qreal h = pixmap.height();
 
-      QList<quint32>::const_iterator it = dict[type].constBegin();
-      for (; it != dict[type].constEnd(); ++it) {
-        CGarminPolygon& item = lines[*it];
+      for (qint32 idx = first[n]; idx < first[n + 1]; ++idx) {
+        CGarminPolygon& item = lines[order[idx]];
         {
           // pixmapCount++;
 
@@ -1678,41 +1846,36 @@ void CMapIMG::drawPolylines(QPainter& p, polytype_t& lines, const QPointF& scale
         // draw background line 1st
         p.setPen(CMainWindow::self().isNight() ? property.penBorderNight : property.penBorderDay);
 
-        QList<quint32>::const_iterator it = dict[type].constBegin();
-        for (; it != dict[type].constEnd(); ++it) {
+        for (qint32 idx = first[n]; idx < first[n + 1]; ++idx) {
           // borderCount++;
-          drawLine(p, lines[*it], property, metrics, font, scale);
+          drawLine(p, lines[order[idx]], property, metrics, font, scale);
         }
         // draw foreground line in a second run for nicer borders
       } else {
         p.setPen(CMainWindow::self().isNight() ? property.penLineNight : property.penLineDay);
 
-        QList<quint32>::const_iterator it = dict[type].constBegin();
-        for (; it != dict[type].constEnd(); ++it) {
+        for (qint32 idx = first[n]; idx < first[n + 1]; ++idx) {
           // normalCount++;
-          drawLine(p, lines[*it], property, metrics, font, scale);
+          drawLine(p, lines[order[idx]], property, metrics, font, scale);
         }
       }
     }
   }
 
   // 2nd run to draw foreground lines.
-  props = polylineProperties.begin();
-  for (; props != end; ++props) {
-    const quint32& type = props.key();
-    const CGarminTyp::polyline_property& property = props.value();
-
-    if (dict[type].isEmpty()) {
+  for (int n = 0; n < N; ++n) {
+    if (first[n] == first[n + 1]) {
       continue;
     }
 
+    const CGarminTyp::polyline_property& property = *polylineTable.properties[n];
+
     if (property.hasBorder && !property.hasPixmap) {
       // draw foreground line 2nd
       p.setPen(CMainWindow::self().isNight() ? property.penLineNight : property.penLineDay);
 
-      QList<quint32>::const_iterator it = dict[type].constBegin();
-      for (; it != dict[type].constEnd(); ++it) {
-        drawLine(p, lines[*it]);
+      for (qint32 idx = first[n]; idx < first[n + 1]; ++idx) {
+        drawLine(p, lines[order[idx]]);
       }
     }
   }
@@ -1812,6 +1975,9 @@ void CMapIMG::addLabel(const CGarminPoint& pt, const QRect& rect, CGarminTyp::la
 }
 
 void CMapIMG::drawPoints(QPainter& p, pointtype_t& pts, QVector<QRectF>& rectPois) {
+  const bool isNight = CMainWindow::self().isNight();
+  const QImage noIcon;
+
   pointtype_t::iterator pt = pts.begin();
   while (pt != pts.end()) {
     //        if((pt->type > 0x1600) && (zoomFactor > CResources::self().getZoomLevelThresholdPois()))
@@ -1822,8 +1988,8 @@ void CMapIMG::drawPoints(QPainter& p, pointtype_t& pts, QVector<QRectF>& rectPoi
 
     map->convertRad2Px(pt->pos);
 
-    const QImage& icon =
-        CMainWindow::self().isNight() ? pointProperties[pt->type].imgNight : pointProperties[pt->type].imgDay;
+    const CGarminTyp::point_property* property = pointTable.find(pt->type);
+    const QImage& icon = property == nullptr ? noIcon : isNight ? property->imgNight : property->imgDay;
     const QSizeF& size = icon.size();
 
     if (isCluttered(rectPois, QRectF(pt->pos, size))) {
@@ -1838,9 +2004,9 @@ void CMapIMG::drawPoints(QPainter& p, pointtype_t& pts, QVector<QRectF>& rectPoi
 
     bool showLabel = true;
 
-    if (pointProperties.contains(pt->type)) {
+    if (property != nullptr) {
       p.drawImage(pt->pos.x() - (size.width() / 2), pt->pos.y() - (size.height() / 2), icon);
-      showLabel = pointProperties[pt->type].labelType != CGarminTyp::eNone;
+      showLabel = property->labelType != CGarminTyp::eNone;
     } else {
       p.drawPixmap(pt->pos.x() - 4, pt->pos.y() - 4, QPixmap(":/icons/8x8/bullet_blue.png"));
     }
@@ -1862,12 +2028,14 @@ void CMapIMG::drawPoints(QPainter& p, pointtype_t& pts, QVector<QRectF>& rectPoi
 
 void CMapIMG::drawPois(QPainter& p, pointtype_t& pts, QVector<QRectF>& rectPois) {
   CGarminTyp::label_type_e labelType = CGarminTyp::eStandard;
+  const bool isNight = CMainWindow::self().isNight();
+  const QImage noIcon;
 
   for (CGarminPoint& pt : pts) {
     map->convertRad2Px(pt.pos);
 
-    const QImage& icon =
-        CMainWindow::self().isNight() ? pointProperties[pt.type].imgNight : pointProperties[pt.type].imgDay;
+    const CGarminTyp::point_property* property = pointTable.find(pt.type);
+    const QImage& icon = property == nullptr ? noIcon : isNight ? property->imgNight : property->imgDay;
     const QSizeF& size = icon.size();
 
     if (isCluttered(rectPois, QRectF(pt.pos, size))) {
@@ -1880,9 +2048,9 @@ void CMapIMG::drawPois(QPainter& p, pointtype_t& pts, QVector<QRectF>& rectPois)
     }
 
     labelType = CGarminTyp::eStandard;
-    if (pointProperties.contains(pt.type)) {
+    if (property != nullptr) {
       p.drawImage(pt.pos.x() - (size.width() / 2), pt.pos.y() - (size.height() / 2), icon);
-      labelType = pointProperties[pt.type].labelType;
+      labelType = property->labelType;
     } else {
       p.drawPixmap(pt.pos.x() - 4, pt.pos.y() - 4, QPixmap(":/icons/8x8/bullet_red.png"));
     }
@@ -2030,8 +2198,8 @@ void CMapIMG::getToolTip(const QPoint& px, QString& infotext) const /* override
   QString str;
 
   QMultiMap<QString, QString> dict;
-  getInfoPoints(points, px, dict);
-  getInfoPoints(pois, px, dict);
+  getInfoPoints(points, indexPoints, px, dict);
+  getInfoPoints(pois, indexPois, px, dict);
   getInfoPolylines(px, dict);
 
   const QStringList& values = dict.values();
@@ -2071,8 +2239,14 @@ void CMapIMG::getToolTip(const QPoint& px, QString& infotext) const /* override
 
 void CMapIMG::findPOICloseBy(const QPoint& pt, IPoiItem& poi) const /*override;*/
 {
-  for (auto& list : {points, pois}) {
-    for (const CGarminPoint& point : list) {
+  // the positions are truncated to integers before the manhattan length is tested
+  const QRectF area(pt - QPointF(11, 11), pt + QPointF(11, 11));
+
+  QVector<qint32> items;
+  for (const pointtype_t* list : {&points, &pois}) {
+    (list == &points ? indexPoints : indexPois).query(area, items);
+    for (qint32 item : qAsConst(items)) {
+      const CGarminPoint& point = (*list)[item];
       QPoint x = pt - QPoint(point.pos.x(), point.pos.y());
       if (x.manhattanLength() < 10) {
         QPointF radPos = point.pos;
@@ -2094,8 +2268,14 @@ void CMapIMG::findPOICloseBy(const QPoint& pt, IPoiItem& poi) const /*override;*
   }
 }
 
-void CMapIMG::getInfoPoints(const pointtype_t& points, const QPoint& pt, QMultiMap<QString, QString>& dict) const {
-  for (const CGarminPoint& point : points) {
+void CMapIMG::getInfoPoints(const pointtype_t& points, const CPackedRTree& index, const QPoint& pt,
+                            QMultiMap<QString, QString>& dict) const {
+  QVector<qint32> items;
+  // the positions are truncated to integers before the manhattan length is tested
+  index.query(QRectF(pt - QPointF(11, 11), pt + QPointF(11, 11)), items);
+
+  for (qint32 item : qAsConst(items)) {
+    const CGarminPoint& point = points[item];
     QPoint x = pt - QPoint(point.pos.x(), point.pos.y());
     if (x.manhattanLength() < 10) {
       if (point.hasLabel()) {
@@ -2124,7 +2304,12 @@ void CMapIMG::getInfoPolylines(const QPoint& pt, QMultiMap<QString, QString>& di
 
   bool found = false;
 
-  for (const CGarminPolygon& line : polylines) {
+  // only lines with a bounding box closer than the shortest distance can match
+  QVector<qint32> items;
+  indexPolylines.query(QRectF(pt - QPointF(shortest, shortest), pt + QPointF(shortest, shortest)), items);
+
+  for (qint32 item : qAsConst(items)) {
+    const CGarminPolygon& line = polylines[item];
     int len = line.pixel.size();
     // need at least 2 points
     if (len < 2) {
@@ -2201,7 +2386,11 @@ void CMapIMG::getInfoPolygons(const QPoint& pt, QMultiMap<QString, QString>& dic
   const qreal x = pt.x();
   const qreal y = pt.y();
 
-  for (const CGarminPolygon& line : polygons) {
+  QVector<qint32> items;
+  indexPolygons.query(QRectF(pt, pt), items);
+
+  for (qint32 item : qAsConst(items)) {
+    const CGarminPolygon& line = polygons[item];
     int npol = line.pixel.size();
     if (npol > 2) {
       bool c = false;
@@ -2240,7 +2429,12 @@ void CMapIMG::getInfoPolygons(const QPoint& pt, QMultiMap<QString, QString>& dic
 bool CMapIMG::findPolylineCloseBy(const QPointF& pt1, const QPointF& pt2, qint32 threshold,
                                   QPolygonF& polyline) /* override */
 {
-  for (const CGarminPolygon& line : qAsConst(polylines)) {
+  // a line has to be close to both points
+  QVector<qint32> items;
+  indexPolylines.query(QRectF(pt1 - QPointF(threshold, threshold), pt1 + QPointF(threshold, threshold)), items);
+
+  for (qint32 item : qAsConst(items)) {
+    const CGarminPolygon& line = polylines[item];
     if (line.pixel.size() < 2) {
       continue;
     }
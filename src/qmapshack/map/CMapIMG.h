@@ -20,12 +20,16 @@
 #define CMAPIMG_H
 
 #include <QMap>
+#include <QThreadPool>
 
+#include "helpers/CPackedRTree.h"
 #include "map/IMap.h"
 #include "map/garmin/CGarminPoint.h"
 #include "map/garmin/CGarminPolygon.h"
+#include "map/garmin/CGarminSubdivCache.h"
 #include "map/garmin/CGarminTyp.h"
 #include "map/garmin/Garmin.h"
+#include "units/IUnit.h"
 
 class CMapDraw;
 class CFileExt;
@@ -112,7 +116,7 @@ class CMapIMG : public IMap {
   };
 
   CMapIMG(const QString& filename, CMapDraw* parent);
-  virtual ~CMapIMG() = default;
+  virtual ~CMapIMG();
 
   void loadConfig(QSettings& cfg) override;
 
@@ -139,6 +143,9 @@ class CMapIMG : public IMap {
  public slots:
   void slotSetTypeFile(const QString& filename) override;
 
+ private slots:
+  void slotNeedsRedraw();
+
  private:
   enum exce_e { eErrOpen, eErrAccess, errFormat, errLock, errAbort };
   struct exce_t {
@@ -152,18 +159,116 @@ class CMapIMG : public IMap {
     QString str;
     CGarminTyp::label_type_e type = CGarminTyp::eStandard;
   };
+  /**
+     @brief Flat lookup table from an object type to it's properties
+
+     Only a few of the possible types are used. The table maps each of them
+     to a dense slot. Slots are numbered in the order the types are drawn.
+   */
+  template <typename T>
+  struct type_table_t {
+    /// the slot of each type, -1 for types without properties
+    QVector<qint32> slotOfType;
+    /// the properties of each slot
+    QVector<const T*> properties;
+
+    void clear() {
+      slotOfType.clear();
+      properties.clear();
+    }
+
+    void add(quint32 type, const T& property) {
+      if (type >= quint32(slotOfType.size())) {
+        slotOfType.insert(slotOfType.end(), type + 1 - slotOfType.size(), -1);
+      }
+      slotOfType[type] = properties.size();
+      properties << &property;
+    }
+
+    qint32 slot(quint32 type) const { return type < quint32(slotOfType.size()) ? slotOfType[type] : -1; }
+
+    const T* find(quint32 type) const {
+      const qint32 s = slot(type);
+      return s < 0 ? nullptr : properties[s];
+    }
+
+    /**
+       @brief Sort objects into buckets by the slot of their type
+
+       Objects with unknown types are dropped.
+
+       @param items   the objects
+       @param order   the indices of the objects, sorted by slot
+       @param first   the start of each slot's bucket in order, with an additional entry for the end
+     */
+    template <typename V>
+    void bucket(const V& items, QVector<qint32>& order, QVector<qint32>& first) const {
+      const qint32 N = properties.size();
+      first.fill(0, N + 1);
+
+      QVector<qint32> slotOfItem(items.size());
+      for (qint32 i = 0; i < items.size(); ++i) {
+        const qint32 s = slot(items[i].type);
+        slotOfItem[i] = s;
+        if (s >= 0) {
+          first[s + 1]++;
+        }
+      }
+      for (qint32 n = 0; n < N; ++n) {
+        first[n + 1] += first[n];
+      }
+
+      QVector<qint32> next = first;
+      order.resize(first[N]);
+      for (qint32 i = 0; i < items.size(); ++i) {
+        const qint32 s = slotOfItem[i];
+        if (s >= 0) {
+          order[next[s]++] = i;
+        }
+      }
+    }
+  };
+
+  /// reference to a subdivision and it's subfile
+  struct subdiv_ref_t {
+    const subfile_desc_t* subfile;
+    /// index of the subfile in subfiles
+    quint32 idxSubfile;
+    const subdiv_desc_t* subdiv;
+  };
+  /// all subdivisions of a map level with a spatial index over their area
+  struct subdiv_index_t {
+    /// the subdivisions in the order of subfiles and subdivisions
+    QVector<subdiv_ref_t> refs;
+    /// index over the area of the subdivisions in refs
+    CPackedRTree tree;
+  };
+  /// a batch of subdivisions of a subfile missing in the cache, decoded by a worker thread
+  struct decode_job_t {
+    const subfile_desc_t* subfile = nullptr;
+    /// index of the subfile in subfiles
+    quint32 idxSubfile = 0;
+    /// indices into the list of visible subdivisions
+    QVector<qint32> indices;
+  };
 
   quint8 scale2bits(const QPointF& scale);
   void setupTyp();
+  void setupTypeTables();
   void readBasics();
   void readSubfileBasics(subfile_desc_t& subfile, CFileExt& file);
   void processPrimaryMapData();
+  void buildSubdivIndex();
+  void buildObjectIndex();
   void readFile(CFileExt& file, quint32 offset, quint32 size, QByteArray& data);
   void loadVisibleData(bool fast, polytype_t& polygons, polytype_t& polylines, pointtype_t& points, pointtype_t& pois,
                        unsigned level, const QRectF& viewport, QPainter& p);
+  void decodeSubDivs(const decode_job_t& job, const subdiv_ref_t* subdivs, garmin_subdiv_t* objects,
+                     QAtomicInt& outOfMemory);
   void loadSubDiv(CFileExt& file, const subdiv_desc_t& subdiv, IGarminStrTbl* strtbl, const QByteArray& rgndata,
-                  bool fast, const QRectF& viewport, polytype_t& polylines, polytype_t& polygons, pointtype_t& points,
-                  pointtype_t& pois);
+                  garmin_subdiv_t& objects);
+  void filterSubDiv(const garmin_subdiv_t& objects, bool fast, const QRectF& viewport, polytype_t& polylines,
+                    polytype_t& polygons, pointtype_t& points, pointtype_t& pois);
   bool intersectsWithExistingLabel(const QRect& rect) const;
   void addLabel(const CGarminPoint& pt, const QRect& rect, CGarminTyp::label_type_e type);
   void drawPolygons(QPainter& p, polytype_t& lines);
@@ -180,7 +285,8 @@ class CMapIMG : public IMap {
   void collectText(const CGarminPolygon& item, const QPolygonF& line, const QFont& font, const QFontMetricsF& metrics,
                    qint32 lineWidth);
 
-  void getInfoPoints(const pointtype_t& points, const QPoint& pt, QMultiMap<QString, QString>& dict) const;
+  void getInfoPoints(const pointtype_t& points, const CPackedRTree& index, const QPoint& pt,
+                     QMultiMap<QString, QString>& dict) const;
   void getInfoPolylines(const QPoint& pt, QMultiMap<QString, QString>& dict) const;
   void getInfoPolygons(const QPoint& pt, QMultiMap<QString, QString>& dict) const;
 
@@ -449,6 +555,14 @@ class CMapIMG : public IMap {
       own subfile parts.
    */
   QMap<QString, subfile_desc_t> subfiles;
+  /// decoded subdivisions, addressed by the subfile's position in subfiles
+  CGarminSubdivCache subdivCache;
+  /// elevations in labels are converted while decoding, thus the cache is valid for this unit type only
+  IUnit::type_e subdivCacheUnitType = IUnit::eTypeMetric;
+  /// workers to decode subdivisions missing in the cache
+  QThreadPool threadPool;
+  /// spatial index of the subdivisions by map level
+  QMap<quint32, subdiv_index_t> subdivIndex;
   /// relay the transparent flags from the subfiles
   bool transparent = false;
 
@@ -465,11 +579,22 @@ class CMapIMG : public IMap {
   QMap<quint32, CGarminTyp::point_property> pointProperties;
   QMap<quint8, QString> languages;
 
+  /// the properties above resolved by setupTypeTables()
+  type_table_t<CGarminTyp::polygon_property> polygonTable;
+  type_table_t<CGarminTyp::polyline_property> polylineTable;
+  type_table_t<CGarminTyp::point_property> pointTable;
+
   polytype_t polygons;
   polytype_t polylines;
   pointtype_t points;
   pointtype_t pois;
 
+  /// indices over the objects of the last draw() in [pixel], empty if draw() has been aborted
+  CPackedRTree indexPolygons;
+  CPackedRTree indexPolylines;
+  CPackedRTree indexPoints;
+  CPackedRTree indexPois;
+
   QVector<strlbl_t> labels;
 
   struct textpath_t {
@@ -53,6 +53,14 @@ CMapPropSetup::CMapPropSetup(IMap* mapfile, CMapDraw* map) : IMapProp(mapfile, m
           &IMap::slotSetCacheSize);
   connect(spinCacheExpiration, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), mapfile,
           &IMap::slotSetCacheExpiration);
+  connect(spinCacheMemSize, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), mapfile,
+          &IMap::slotSetCacheMemSize);
+  connect(spinCachePrefetch, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), mapfile,
+          &IMap::slotSetCachePrefetch);
+  connect(spinCacheMemSize, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
+          &CMapPropSetup::slotUpdateCacheInfo);
+  // the cache changes with each draw
+  connect(map, &CMapDraw::sigStopThread, this, &CMapPropSetup::slotUpdateCacheInfo);
 
   connect(toolOpenTypFile, &QToolButton::pressed, this, &CMapPropSetup::slotLoadTypeFile);
   connect(toolClearTypFile, &QToolButton::pressed, this, &CMapPropSetup::slotClearTypeFile);
@@ -98,6 +106,9 @@ void CMapPropSetup::slotPropertiesChanged() /* override */
   labelCachePath->setToolTip(lbl);
   spinCacheSize->setValue(mapfile->getCacheSize());
   spinCacheExpiration->setValue(mapfile->getCacheExpiration());
+  spinCacheMemSize->setValue(mapfile->getCacheMemSize());
+  spinCachePrefetch->setValue(mapfile->getCachePrefetch());
+  slotUpdateCacheInfo();
   if (mapfile->hasFeatureLayers()) {
     mapfile->getLayers(*listLayers);
   }
@@ -146,3 +157,9 @@ void CMapPropSetup::slotClearTypeFile() {
   mapfile->slotSetTypeFile("");
   slotPropertiesChanged();
 }
+
+void CMapPropSetup::slotUpdateCacheInfo() {
+  const QString& info = mapfile->getCacheInfo();
+  labelCacheInfo->setText(info);
+  labelCacheInfo->setVisible(!info.isEmpty());
+}
@@ -37,6 +37,7 @@ class CMapPropSetup : public IMapProp, private Ui::IMapPropSetup {
   void slotSetMaxScale(bool checked);
   void slotLoadTypeFile();
   void slotClearTypeFile();
+  void slotUpdateCacheInfo();
 
  private:
   static QPointF scale;
@@ -105,6 +105,7 @@ CMapTMS::CMapTMS(const QString& filename, CMapDraw* parent) : IMapOnline(parent)
 
     layers[idx].strUrl = xmlLayer.namedItem("ServerUrl").toElement().text();
     layers[idx].script = xmlLayer.namedItem("Script").toElement().text();
+    layers[idx].cacheId = CDiskCache::layerId(layers[idx].strUrl + layers[idx].script);
     layers[idx].minZoomLevel = minZoomLevel;
     layers[idx].maxZoomLevel = maxZoomLevel;
 
@@ -277,6 +278,8 @@ void CMapTMS::draw(IDrawContext::buffer_t& buf) /* override */
 
   timeLastUpdate.start();
   urlQueue.clear();
+  // drop all prefetch jobs not started yet
+  threadPool.clear();
 
   if (map->needsRedraw()) {
     return;
@@ -346,30 +349,75 @@ void CMapTMS::draw(IDrawContext::buffer_t& buf) /* override */
     //        qDebug() << col1 << col2 << row1 << row2 << (col2 - col1) << (row2 - row1) << ((col2 - col1) * (row2 -
     //        row1));
 
-    // start to request tiles. draw tiles in cache, queue urls of tile yet to be requested
+    QVector<tile_key_t> tiles;
     for (qint32 row = row1; row <= row2; row++) {
       for (qint32 col = col1; col <= col2; col++) {
-        QString url = createUrl(layer, col, row, z);
-        //                qDebug() << url;
+        tiles << tile_key_t{layer.cacheId, z, col, row};
+      }
+    }
 
-        if (diskCache->contains(url)) {
-          QImage img;
-          diskCache->restore(url, img);
+    // start to request tiles. draw tiles in cache, queue urls of tile yet to be requested
+    QVector<QImage> imgs;
+    loadTiles(tiles, imgs);
+    for (qint32 n = 0; n < tiles.size(); n++) {
+      const tile_key_t& key = tiles[n];
+
+      if (!imgs[n].isNull()) {
+        QPolygonF l;
+
+        qreal xx1 = tile2lon(key.x, z) * DEG_TO_RAD;
+        qreal yy1 = tile2lat(key.y, z) * DEG_TO_RAD;
+        qreal xx2 = tile2lon(key.x + 1, z) * DEG_TO_RAD;
+        qreal yy2 = tile2lat(key.y + 1, z) * DEG_TO_RAD;
+
+        l << QPointF(xx1, yy1) << QPointF(xx2, yy1) << QPointF(xx2, yy2) << QPointF(xx1, yy2);
+        drawTile(imgs[n], l, p);
+      } else {
+        // the URL is only needed for missing tiles. Creating it might involve a script.
+        urlQueue << request_t{createUrl(layer, key.x, key.y, z), key};
+      }
+    }
 
-          QPolygonF l;
+    // prefetch a ring of tiles around the viewport
+    const qint32 ring = getCachePrefetch();
+    const QRect range(QPoint(col1, row1), QPoint(col2, row2));
+    const QRect& ringRange = range.adjusted(-ring, -ring, ring, ring) & QRect(0, 0, 1 << z, 1 << z);
+    QVector<tile_key_t> prefetch;
+    for (qint32 row = ringRange.top(); row <= ringRange.bottom(); row++) {
+      for (qint32 col = ringRange.left(); col <= ringRange.right(); col++) {
+        if (!range.contains(col, row)) {
+          prefetch << tile_key_t{layer.cacheId, z, col, row};
+        }
+      }
+    }
 
-          qreal xx1 = tile2lon(col, z) * DEG_TO_RAD;
-          qreal yy1 = tile2lat(row, z) * DEG_TO_RAD;
-          qreal xx2 = tile2lon(col + 1, z) * DEG_TO_RAD;
-          qreal yy2 = tile2lat(row + 1, z) * DEG_TO_RAD;
+    // prefetch the next and previous zoom level. Note: z is the tile zoom level
+    // while the layer's limits are given in the inverse 21 - z notation
+    auto isValidZoomLevel = [&layer](qint32 level) {
+      const qint32 i = 21 - level;
+      return (i >= layer.minZoomLevel) && (i <= layer.maxZoomLevel) && (i < 21);
+    };
+
+    if ((ring > 0) && isValidZoomLevel(z - 1)) {
+      // the previous level has a quarter of the tiles, take them all
+      for (qint32 row = row1 >> 1; row <= (row2 >> 1); row++) {
+        for (qint32 col = col1 >> 1; col <= (col2 >> 1); col++) {
+          prefetch << tile_key_t{layer.cacheId, z - 1, col, row};
+        }
+      }
+    }
 
-          l << QPointF(xx1, yy1) << QPointF(xx2, yy1) << QPointF(xx2, yy2) << QPointF(xx1, yy2);
-          drawTile(img, l, p);
-        } else {
-          urlQueue << url;
+    if ((ring > 0) && isValidZoomLevel(z + 1)) {
+      // the next level has four times the tiles, restrict it to the center of the viewport
+      const qint32 w = (col2 - col1 + 1) / 2;
+      const qint32 h = (row2 - row1 + 1) / 2;
+      for (qint32 row = 2 * row1 + h; row <= 2 * row2 + 1 - h; row++) {
+        for (qint32 col = 2 * col1 + w; col <= 2 * col2 + 1 - w; col++) {
+          prefetch << tile_key_t{layer.cacheId, z + 1, col, row};
         }
       }
     }
+    prefetchTiles(prefetch);
 
     emit sigQueueChanged();
   }
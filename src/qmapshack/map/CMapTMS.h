@@ -54,6 +54,8 @@ class CMapTMS : public IMapOnline {
     QString title;
     QString strUrl;
     QString script;
+    /// id of the layer in the tile cache
+    quint32 cacheId = 0;
   };
 
   QVector<layer_t> layers;
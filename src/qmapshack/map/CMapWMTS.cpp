@@ -158,6 +158,7 @@ CMapWMTS::CMapWMTS(const QString& filename, CMapDraw* parent) : IMapOnline(paren
 
     // enable layer by default
     layer.enabled = true;
+    layer.cacheId = CDiskCache::layerId(layer.resourceURL);
     layers << layer;
   }
 
@@ -341,6 +342,8 @@ void CMapWMTS::draw(IDrawContext::buffer_t& buf) /* override */
 
   timeLastUpdate.start();
   urlQueue.clear();
+  // drop all prefetch jobs not started yet
+  threadPool.clear();
 
   if (map->needsRedraw()) {
     return;
@@ -385,7 +388,6 @@ void CMapWMTS::draw(IDrawContext::buffer_t& buf) /* override */
     }
 
     const tileset_t& tileset = tilesets[layer.tileMatrixSet];
-    const QMap<QString, limit_t>& limits = layer.limits;
 
     // convert viewport to layer's coordinate system
     QPointF pt1(x1, y1);
@@ -414,92 +416,148 @@ void CMapWMTS::draw(IDrawContext::buffer_t& buf) /* override */
       }
     }
 
-    // get min/max col/row values for that level
-    qint32 minRow, maxRow, minCol, maxCol;
-    const tilematrix_t& tilematrix = tileset.tilematrix[tileMatrixId];
-    if (!limits.isEmpty()) {
-      if (limits.contains(tileMatrixId)) {
-        const limit_t& limit = limits[tileMatrixId];
-        minCol = limit.minTileCol;
-        maxCol = limit.maxTileCol;
-        minRow = limit.minTileRow;
-        maxRow = limit.maxTileRow;
-      } else {
-        // layer has limits but not for the selected tileMatrixId -> skip layer
-        continue;
-      }
-    } else {
-      minCol = 0;
-      maxCol = tilematrix.matrixWidth;
-      minRow = 0;
-      maxRow = tilematrix.matrixHeight;
+    // the tile matrix is addressed by it's index in the tile cache
+    const qint32 z = keys.indexOf(tileMatrixId);
+
+    // get range of col/row to request tiles
+    QRect range, limit;
+    if (!getTileRange(layer, tileset, tileMatrixId, pt1, pt2, range, limit)) {
+      // layer has limits but not for the selected tileMatrixId -> skip layer
+      continue;
     }
 
-    // derive range of col/row to request tiles
+    const tilematrix_t& tilematrix = tileset.tilematrix[tileMatrixId];
     qreal xscale = tilematrix.scale * 0.28e-3;
     qreal yscale = -tilematrix.scale * 0.28e-3;
 
-    qint32 col1 = qFloor((pt1.x() - tilematrix.topLeft.x()) / (xscale * tilematrix.tileWidth));
-    qint32 row1 = qFloor((pt1.y() - tilematrix.topLeft.y()) / (yscale * tilematrix.tileHeight));
-    qint32 col2 = qFloor((pt2.x() - tilematrix.topLeft.x()) / (xscale * tilematrix.tileWidth));
-    qint32 row2 = qFloor((pt2.y() - tilematrix.topLeft.y()) / (yscale * tilematrix.tileHeight));
-
-    if (col1 < minCol) {
-      col1 = minCol;
-    }
-    if (col1 > maxCol) {
-      col1 = maxCol;
-    }
-    if (row1 < minRow) {
-      row1 = minRow;
-    }
-    if (row1 > maxRow) {
-      row1 = maxRow;
-    }
-
-    if (col2 < minCol) {
-      col2 = minCol;
-    }
-    if (col2 > maxCol) {
-      col2 = maxCol;
-    }
-    if (row2 < minRow) {
-      row2 = minRow;
-    }
-    if (row2 > maxRow) {
-      row2 = maxRow;
+    QVector<tile_key_t> tiles;
+    for (qint32 row = range.top(); row <= range.bottom(); row++) {
+      for (qint32 col = range.left(); col <= range.right(); col++) {
+        tiles << tile_key_t{layer.cacheId, z, col, row};
+      }
     }
 
     // start to request tiles. draw tiles in cache, queue urls of tile yet to be requested
-    for (qint32 row = row1; row <= row2; row++) {
-      for (qint32 col = col1; col <= col2; col++) {
-        QString url = layer.resourceURL;
-        url = url.replace("{TileMatrix}", tileMatrixId, Qt::CaseInsensitive);
-        url = url.replace("{TileRow}", QString::number(row), Qt::CaseInsensitive);
-        url = url.replace("{TileCol}", QString::number(col), Qt::CaseInsensitive);
+    QVector<QImage> imgs;
+    loadTiles(tiles, imgs);
+    for (qint32 n = 0; n < tiles.size(); n++) {
+      const tile_key_t& key = tiles[n];
 
-        if (diskCache->contains(url)) {
-          QImage img;
-          diskCache->restore(url, img);
+      if (!imgs[n].isNull()) {
+        QPolygonF l;
 
-          QPolygonF l;
+        qreal xx1 = key.x * (xscale * tilematrix.tileWidth) + tilematrix.topLeft.x();
+        qreal yy1 = key.y * (yscale * tilematrix.tileHeight) + tilematrix.topLeft.y();
+        qreal xx2 = (key.x + 1) * (xscale * tilematrix.tileWidth) + tilematrix.topLeft.x();
+        qreal yy2 = (key.y + 1) * (yscale * tilematrix.tileHeight) + tilematrix.topLeft.y();
 
-          qreal xx1 = col * (xscale * tilematrix.tileWidth) + tilematrix.topLeft.x();
-          qreal yy1 = row * (yscale * tilematrix.tileHeight) + tilematrix.topLeft.y();
-          qreal xx2 = (col + 1) * (xscale * tilematrix.tileWidth) + tilematrix.topLeft.x();
-          qreal yy2 = (row + 1) * (yscale * tilematrix.tileHeight) + tilematrix.topLeft.y();
+        l << QPointF(xx1, yy1) << QPointF(xx2, yy1) << QPointF(xx2, yy2) << QPointF(xx1, yy2);
 
-          l << QPointF(xx1, yy1) << QPointF(xx2, yy1) << QPointF(xx2, yy2) << QPointF(xx1, yy2);
+        tileset.proj.transform(l, PJ_FWD);
 
-          tileset.proj.transform(l, PJ_FWD);
+        drawTile(imgs[n], l, p);
+      } else {
+        QString url = layer.resourceURL;
+        url = url.replace("{TileMatrix}", tileMatrixId, Qt::CaseInsensitive);
+        url = url.replace("{TileRow}", QString::number(key.y), Qt::CaseInsensitive);
+        url = url.replace("{TileCol}", QString::number(key.x), Qt::CaseInsensitive);
+        urlQueue << request_t{url, key};
+      }
+    }
+
+    // prefetch a ring of tiles around the viewport
+    const qint32 ring = getCachePrefetch();
+    QVector<tile_key_t> prefetch;
+    const QRect& ringRange = range.adjusted(-ring, -ring, ring, ring) & limit;
+    for (qint32 row = ringRange.top(); row <= ringRange.bottom(); row++) {
+      for (qint32 col = ringRange.left(); col <= ringRange.right(); col++) {
+        if (!range.contains(col, row)) {
+          prefetch << tile_key_t{layer.cacheId, z, col, row};
+        }
+      }
+    }
+
+    // prefetch the tile matrices with the next smaller and larger scale
+    if (ring > 0) {
+      QString nextSmaller;
+      QString nextLarger;
+      for (const QString& key : keys) {
+        const qreal scale = tileset.tilematrix[key].scale;
+        if ((scale < tilematrix.scale) &&
+            (nextSmaller.isEmpty() || (scale > tileset.tilematrix[nextSmaller].scale))) {
+          nextSmaller = key;
+        }
+        if ((scale > tilematrix.scale) && (nextLarger.isEmpty() || (scale < tileset.tilematrix[nextLarger].scale))) {
+          nextLarger = key;
+        }
+      }
+
+      // the next larger scale covers the whole viewport
+      if (!nextLarger.isEmpty() && getTileRange(layer, tileset, nextLarger, pt1, pt2, range, limit)) {
+        const qint32 zLarger = keys.indexOf(nextLarger);
+        for (qint32 row = range.top(); row <= range.bottom(); row++) {
+          for (qint32 col = range.left(); col <= range.right(); col++) {
+            prefetch << tile_key_t{layer.cacheId, zLarger, col, row};
+          }
+        }
+      }
 
-          drawTile(img, l, p);
-        } else {
-          urlQueue << url;
+      // the next smaller scale has more tiles, thus restrict it to the center of the viewport
+      const QPointF& quarter = (pt2 - pt1) / 4;
+      if (!nextSmaller.isEmpty() &&
+          getTileRange(layer, tileset, nextSmaller, pt1 + quarter, pt2 - quarter, range, limit)) {
+        const qint32 zSmaller = keys.indexOf(nextSmaller);
+        for (qint32 row = range.top(); row <= range.bottom(); row++) {
+          for (qint32 col = range.left(); col <= range.right(); col++) {
+            prefetch << tile_key_t{layer.cacheId, zSmaller, col, row};
+          }
         }
       }
     }
+    prefetchTiles(prefetch);
 
     emit sigQueueChanged();
   }
 }
+
+bool CMapWMTS::getTileRange(const layer_t& layer, const tileset_t& tileset, const QString& tileMatrixId,
+                            const QPointF& pt1, const QPointF& pt2, QRect& range, QRect& limit) const {
+  // get min/max col/row values for that level
+  qint32 minRow, maxRow, minCol, maxCol;
+  const tilematrix_t& tilematrix = tileset.tilematrix[tileMatrixId];
+  const QMap<QString, limit_t>& limits = layer.limits;
+  if (!limits.isEmpty()) {
+    if (limits.contains(tileMatrixId)) {
+      const limit_t& limit = limits[tileMatrixId];
+      minCol = limit.minTileCol;
+      maxCol = limit.maxTileCol;
+      minRow = limit.minTileRow;
+      maxRow = limit.maxTileRow;
+    } else {
+      return false;
+    }
+  } else {
+    minCol = 0;
+    maxCol = tilematrix.matrixWidth;
+    minRow = 0;
+    maxRow = tilematrix.matrixHeight;
+  }
+
+  // derive range of col/row to request tiles
+  qreal xscale = tilematrix.scale * 0.28e-3;
+  qreal yscale = -tilematrix.scale * 0.28e-3;
+
+  qint32 col1 = qFloor((pt1.x() - tilematrix.topLeft.x()) / (xscale * tilematrix.tileWidth));
+  qint32 row1 = qFloor((pt1.y() - tilematrix.topLeft.y()) / (yscale * tilematrix.tileHeight));
+  qint32 col2 = qFloor((pt2.x() - tilematrix.topLeft.x()) / (xscale * tilematrix.tileWidth));
+  qint32 row2 = qFloor((pt2.y() - tilematrix.topLeft.y()) / (yscale * tilematrix.tileHeight));
+
+  col1 = qBound(minCol, col1, maxCol);
+  row1 = qBound(minRow, row1, maxRow);
+  col2 = qBound(minCol, col2, maxCol);
+  row2 = qBound(minRow, row2, maxRow);
+
+  range = QRect(QPoint(col1, row1), QPoint(col2, row2));
+  limit = QRect(QPoint(minCol, minRow), QPoint(maxCol, maxRow));
+  return true;
+}
@@ -60,6 +60,8 @@ class CMapWMTS : public IMapOnline {
     QRectF boundingBox;
     QString resourceURL;
     QMap<QString, limit_t> limits;
+    /// id of the layer in the tile cache
+    quint32 cacheId = 0;
   };
 
   QList<layer_t> layers;
@@ -79,6 +81,21 @@ class CMapWMTS : public IMapOnline {
   };
 
   QMap<QString, tileset_t> tilesets;
+
+  /**
+     @brief Get the range of tiles of a tile matrix covering an area
+
+     @param layer         the layer to draw
+     @param tileset       the layer's tile matrix set
+     @param tileMatrixId  the tile matrix to use
+     @param pt1           top left corner of the area in the layer's coordinate system
+     @param pt2           bottom right corner of the area in the layer's coordinate system
+     @param range         the resulting range of columns (x) and rows (y)
+     @param limit         the range of all columns and rows available
+     @return False if the layer has no tiles for that tile matrix.
+   */
+  bool getTileRange(const layer_t& layer, const tileset_t& tileset, const QString& tileMatrixId, const QPointF& pt1,
+                    const QPointF& pt2, QRect& range, QRect& limit) const;
 };
 
 #endif  // CMAPWMTS_H
@@ -41,6 +41,8 @@ void IMap::saveConfig(QSettings& cfg) /* override */
   if (hasFeatureTileCache()) {
     cfg.setValue("cacheSizeMB", cacheSizeMB);
     cfg.setValue("cacheExpiration", cacheExpiration);
+    cfg.setValue("cacheMemSizeMB", cacheMemSizeMB);
+    cfg.setValue("cachePrefetch", cachePrefetch);
   }
 
   if (hasFeatureTypFile()) {
@@ -58,6 +60,8 @@ void IMap::loadConfig(QSettings& cfg) /* override */
   slotSetAdjustDetailLevel(cfg.value("adjustDetailLevel", getAdjustDetailLevel()).toInt());
   slotSetCacheSize(cfg.value("cacheSizeMB", getCacheSize()).toInt());
   slotSetCacheExpiration(cfg.value("cacheExpiration", getCacheExpiration()).toInt());
+  slotSetCacheMemSize(cfg.value("cacheMemSizeMB", getCacheMemSize()).toInt());
+  slotSetCachePrefetch(cfg.value("cachePrefetch", getCachePrefetch()).toInt());
   slotSetTypeFile(cfg.value("typeFile", getTypeFile()).toString());
 }
 
@@ -98,6 +98,17 @@ class IMap : public IDrawObject {
 
   qint32 getCacheExpiration() const { return cacheExpiration; }
 
+  qint32 getCacheMemSize() const { return cacheMemSizeMB; }
+
+  qint32 getCachePrefetch() const { return cachePrefetch; }
+
+  /**
+     @brief Get a short summary of the map's memory cache for the setup widget
+
+     @return The summary or an empty string if the map has no memory cache
+   */
+  virtual QString getCacheInfo() const { return QString(); }
+
   qint32 getAdjustDetailLevel() const { return adjustDetailLevel; }
 
   const QString& getTypeFile() const { return typeFile; }
@@ -133,6 +144,11 @@ class IMap : public IDrawObject {
     cacheExpiration = days;
     configureCache();
   }
+  void slotSetCacheMemSize(qint32 size) {
+    cacheMemSizeMB = size;
+    configureCache();
+  }
+  void slotSetCachePrefetch(qint32 tiles) { cachePrefetch = tiles; }
 
   void slotSetAdjustDetailLevel(qint32 level) { adjustDetailLevel = level; }
 
@@ -184,9 +200,11 @@ class IMap : public IDrawObject {
   bool showPOIs = true;          //< vector maps only: hide/show point of interest
   qint32 adjustDetailLevel = 0;  //< vector maps only: alter threshold to show details.
 
-  QString cachePath;           //< streaming map only: path to cached tiles
-  qint32 cacheSizeMB = 100;    //< streaming map only: maximum size of all tiles in cache [MByte]
-  qint32 cacheExpiration = 8;  //< streaming map only: maximum age of tiles in cache [days]
+  QString cachePath;            //< streaming map only: path to cached tiles
+  qint32 cacheSizeMB = 100;     //< streaming map only: maximum size of all tiles in cache [MByte]
+  qint32 cacheExpiration = 8;   //< streaming map only: maximum age of tiles in cache [days]
+  qint32 cacheMemSizeMB = 128;  //< streaming map only: maximum size of decoded tiles kept in memory [MByte]
+  qint32 cachePrefetch = 1;     //< streaming map only: width of the ring around the viewport to prefetch [tiles]
 
   QString copyright;  //< a copyright string to be displayed as tool tip
 
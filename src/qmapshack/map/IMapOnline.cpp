@@ -31,6 +31,15 @@ IMapOnline::IMapOnline(CMapDraw* parent) : IMap(eFeatVisibility | eFeatTileCache
   connect(accessManager, &QNetworkAccessManager::finished, this, &IMapOnline::slotRequestFinished);
 
   connect(this, &IMapOnline::sigQueueChanged, this, &IMapOnline::slotQueueChanged);
+
+  // Each thread keeps it's own connection to the tile cache's database.
+  // Thus keep the threads instead of creating new ones all the time.
+  threadPool.setExpiryTimeout(-1);
+}
+
+IMapOnline::~IMapOnline() {
+  threadPool.clear();
+  threadPool.waitForDone();
 }
 
 bool IMapOnline::httpsCheck(const QString& url) {
@@ -52,16 +61,16 @@ void IMapOnline::slotQueueChanged() {
   if (!urlQueue.isEmpty() && urlPending.size() < 6) {
     // request up to 6 pending request
     for (int i = 0; i < (6 - urlPending.size()); i++) {
-      QString url = urlQueue.dequeue();
+      const request_t& tile = urlQueue.dequeue();
       lastRequest = urlQueue.isEmpty();
 
       QNetworkRequest request;
-      request.setUrl(url);
+      request.setUrl(tile.url);
       for (const rawHeaderItem_t& item : qAsConst(rawHeaderItems)) {
         request.setRawHeader(item.name.toLatin1(), item.value.toLatin1());
       }
       accessManager->get(request);
-      urlPending << url;
+      urlPending[tile.url] = tile.key;
 
       if (lastRequest) {
         break;
@@ -93,15 +102,15 @@ void IMapOnline::slotRequestFinished(QNetworkReply* reply) {
   QString url = reply->url().toString();
   if (urlPending.contains(url)) {
     QImage img;
+    QByteArray data;
     // only take good responses
     if (!reply->error()) {
       // read image data
-      img.loadFromData(reply->readAll());
+      data = reply->readAll();
+      img.loadFromData(data);
     }
     // always store image to cache, the cache will take care of NULL images
-    diskCache->store(url, img);
-
-    urlPending.removeAll(url);
+    diskCache->store(urlPending.take(url), data, img);
   }
 
   // debug output any error
@@ -119,6 +128,66 @@ void IMapOnline::slotRequestFinished(QNetworkReply* reply) {
 void IMapOnline::configureCache() {
   QMutexLocker lock(&mutex);
 
+  // make sure no prefetch job is using the cache anymore
+  threadPool.clear();
+  threadPool.waitForDone();
+
   delete diskCache;
-  diskCache = new CDiskCache(getCachePath(), getCacheSize(), getCacheExpiration(), this);
+  diskCache = new CDiskCache(getCachePath(), getCacheSize(), getCacheExpiration(), getCacheMemSize(), this);
+}
+
+QString IMapOnline::getCacheInfo() const {
+  if (diskCache == nullptr) {
+    return QString();
+  }
+
+  const CTileMemCache::stats_t& stats = diskCache->getMemStats();
+  return tr("%1 tiles in memory, %2 MB, hit rate %3%, %4 tiles removed")
+      .arg(stats.entries)
+      .arg(stats.bytes / (1024 * 1024))
+      .arg(qRound(stats.hitRate() * 100))
+      .arg(stats.evictions);
+}
+
+void IMapOnline::loadTiles(const QVector<tile_key_t>& keys, QVector<QImage>& imgs) {
+  const qint32 N = keys.size();
+  imgs.fill(QImage(), N);
+  // each job writes to it's own slot. Use the raw pointer to avoid any detach of the vector
+  QImage* pImgs = imgs.data();
+
+  QSemaphore done;
+  qint32 pending = 0;
+  for (qint32 n = 0; n < N; n++) {
+    if (diskCache->restoreFromMemory(keys[n], pImgs[n])) {
+      continue;
+    }
+
+    const tile_key_t key = keys[n];
+    QImage* img = pImgs + n;
+    // visible tiles are decoded prior to any prefetch job
+    threadPool.start(
+        [this, key, img, &done]() {
+          diskCache->restoreFromDisk(key, *img);
+          done.release();
+        },
+        1);
+    pending++;
+  }
+
+  done.acquire(pending);
+}
+
+void IMapOnline::prefetchTiles(const QVector<tile_key_t>& keys) {
+  for (const tile_key_t& key : keys) {
+    if (diskCache->isInMemory(key)) {
+      continue;
+    }
+
+    threadPool.start(
+        [this, key]() {
+          QImage img;
+          diskCache->restoreFromDisk(key, img);
+        },
+        0);
+  }
 }
@@ -22,8 +22,10 @@
 #include <QElapsedTimer>
 #include <QMutex>
 #include <QQueue>
+#include <QThreadPool>
 
 #include "map/IMap.h"
+#include "map/cache/CTileMemCache.h"
 
 class CDiskCache;
 class QNetworkAccessManager;
@@ -43,15 +45,23 @@ class IMapOnline : public IMap {
   void sigQueueChanged();
 
  protected:
+  struct request_t {
+    QString url;
+    tile_key_t key;
+  };
+
   /// Mutex to control access to url queue
   QRecursiveMutex mutex;
-  /// a queue with all tile urls to request
-  QQueue<QString> urlQueue;
+  /// a queue with all tiles to request
+  QQueue<request_t> urlQueue;
   /// the tile cache
   CDiskCache* diskCache = nullptr;
   /// access manager to request tiles
   QNetworkAccessManager* accessManager = nullptr;
-  QList<QString> urlPending;
+  /// the cache keys of all pending requests by URL
+  QHash<QString, tile_key_t> urlPending;
+  /// thread pool to decode cached tiles and to prefetch tiles around the viewport
+  QThreadPool threadPool;
 
   bool lastRequest = false;
   QElapsedTimer timeLastUpdate;
@@ -68,12 +78,36 @@ class IMapOnline : public IMap {
 
   void configureCache() override;
 
+  /**
+     @brief Get the decoded images of a list of tiles
+
+     Tiles already decoded in memory are taken right away. All others are
+     loaded and decoded from disk in parallel by the thread pool. The call
+     returns when all tiles are processed.
+
+     @param keys  the tiles to get
+     @param imgs  the images in the same order as the keys. Tiles not in the cache get a null image.
+   */
+  void loadTiles(const QVector<tile_key_t>& keys, QVector<QImage>& imgs);
+
+  /**
+     @brief Decode tiles from disk into the memory cache in the background
+
+     Tiles not in the disk cache are ignored. Call threadPool.clear() to
+     drop jobs not started yet.
+
+     @param keys  the tiles to prefetch
+   */
+  void prefetchTiles(const QVector<tile_key_t>& keys);
+
  public:
   void slotQueueChanged();
   void slotRequestFinished(QNetworkReply* reply);
 
   IMapOnline(CMapDraw* parent);
-  virtual ~IMapOnline() {}
+  virtual ~IMapOnline();
+
+  QString getCacheInfo() const override;
 };
 
 #endif  // IMAPONLINE_H
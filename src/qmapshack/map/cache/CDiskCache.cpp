@@ -18,13 +18,22 @@
 
 #include "CDiskCache.h"
 
+#include <QtSql>
 #include <QtWidgets>
 
+#include "gis/db/macros.h"
 #include "map/CMapDraw.h"
 #include "version.h"
 
-CDiskCache::CDiskCache(const QString& path, qint32 maxSizeMB, qint32 expirationDays, QObject* parent)
-    : QObject(parent), dir(path), maxSizeMB(maxSizeMB), expirationDays(expirationDays) {
+#define DB_FILENAME "tiles.db"
+
+CDiskCache::CDiskCache(const QString& path, qint32 maxSizeMB, qint32 expirationDays, qint32 memSizeMB,
+                       QObject* parent)
+    : QObject(parent),
+      dir(path),
+      maxSizeMB(maxSizeMB),
+      expirationDays(expirationDays),
+      cache(qint64(memSizeMB) * 1024 * 1024) {
   dummy.fill(Qt::transparent);
 
   dir.mkpath(dir.path());
@@ -36,10 +45,24 @@ CDiskCache::CDiskCache(const QString& path, qint32 maxSizeMB, qint32 expirationD
     }
   }
 
-  const QFileInfoList& files = dir.entryInfoList(QStringList("*.png"), QDir::Files);
-  for (const QFileInfo& fileinfo : files) {
-    QString hash = fileinfo.baseName();
-    table[hash] = fileinfo.fileName();
+  if (!QFile::exists(dir.absoluteFilePath(DB_FILENAME))) {
+    // Older versions stored one PNG file per tile. As the tiles are addressed
+    // by a different key now, these files are of no use anymore.
+    const QStringList& files = dir.entryList(QStringList("*.png"), QDir::Files);
+    for (const QString& file : files) {
+      dir.remove(file);
+    }
+  }
+
+  connectionName = QString("DiskCache:%1").arg(dir.absolutePath());
+  if (initDB()) {
+    // initialize the running totals once. From now on they are updated incrementally.
+    QSqlQuery query(database());
+    QUERY_RUN("SELECT SUM(size), MIN(timestamp) FROM tiles", NO_CMD)
+    if (query.next()) {
+      totalSize = query.value(0).toLongLong();
+      oldestTimestamp = query.value(1).toLongLong();
+    }
   }
 
   timer = new QTimer(this);
@@ -48,93 +71,262 @@ CDiskCache::CDiskCache(const QString& path, qint32 maxSizeMB, qint32 expirationD
   connect(timer, &QTimer::timeout, this, &CDiskCache::slotCleanup);
 }
 
-void CDiskCache::store(const QString& key, QImage& img) {
-  QMutexLocker lock(&mutex);
+CDiskCache::~CDiskCache() {
+  for (const QString& name : qAsConst(connections)) {
+    QSqlDatabase::removeDatabase(name);
+  }
+}
 
-  QCryptographicHash md5(QCryptographicHash::Md5);
-  md5.addData(key.toLatin1());
+QSqlDatabase CDiskCache::database() const {
+  QThread* thread = QThread::currentThread();
+  QString name;
+  {
+    QMutexLocker lock(&mutex);
+    name = connections.value(thread);
+    if (!name.isEmpty()) {
+      return QSqlDatabase::database(name);
+    }
 
-  QString hash = md5.result().toHex();
-  QString filename = QString("%1.png").arg(hash);
+    // Thread addresses are reused. Thus the name has to be unique and the
+    // connection is removed as soon as the thread finishes.
+    name = QString("%1:%2").arg(connectionName).arg(++cntConnections);
+    connections[thread] = name;
+  }
 
-  if (!img.isNull()) {
-    img.save(dir.absoluteFilePath(filename));
-    table[hash] = filename;
-    cache[hash] = img;
-  } else {
-    cache[hash] = dummy;
+  QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", name);
+  db.setDatabaseName(dir.absoluteFilePath(DB_FILENAME));
+  db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+  if (!db.open()) {
+    qWarning() << "failed to open tile cache" << db.databaseName() << db.lastError();
   }
+
+  // the slot is called by the finishing thread itself
+  connect(
+      thread, &QThread::finished, this, [this, thread]() { removeConnection(thread); }, Qt::DirectConnection);
+  return db;
 }
 
-void CDiskCache::restore(const QString& key, QImage& img) {
-  QMutexLocker lock(&mutex);
+void CDiskCache::removeConnection(QThread* thread) const {
+  QString name;
+  {
+    QMutexLocker lock(&mutex);
+    name = connections.take(thread);
+  }
+
+  if (!name.isEmpty()) {
+    QSqlDatabase::removeDatabase(name);
+  }
+}
 
-  QCryptographicHash md5(QCryptographicHash::Md5);
-  md5.addData(key.toLatin1());
+bool CDiskCache::initDB() {
+  QSqlDatabase db = database();
+  QSqlQuery query(db);
+
+  QUERY_RUN("PRAGMA journal_mode=WAL", return false)
+  QUERY_RUN("PRAGMA synchronous=NORMAL", return false)
+  QUERY_RUN(
+      "CREATE TABLE IF NOT EXISTS tiles ("
+      "layer          INTEGER NOT NULL,"
+      "z              INTEGER NOT NULL,"
+      "x              INTEGER NOT NULL,"
+      "y              INTEGER NOT NULL,"
+      "size           INTEGER NOT NULL,"
+      "timestamp      INTEGER NOT NULL,"
+      "data           BLOB NOT NULL,"
+      "PRIMARY KEY (layer, z, x, y)"
+      ")",
+      return false)
+  QUERY_RUN("CREATE INDEX IF NOT EXISTS tiles_timestamp ON tiles (timestamp)", return false)
+
+  return true;
+}
 
-  QString hash = md5.result().toHex();
+void CDiskCache::store(const tile_key_t& key, const QByteArray& data, const QImage& img) {
+  if (img.isNull()) {
+    QMutexLocker lock(&mutex);
+    cache.insert(key, dummy);
+    return;
+  }
 
-  if (cache.contains(hash)) {
-    img = cache[hash];
-  } else if (table.contains(hash)) {
-    img.load(dir.absoluteFilePath(table[hash]));
-    if (!cache.contains(hash)) {
-      cache[hash] = img;
-    }
-  } else {
-    img = QImage();
+  {
+    QMutexLocker lock(&mutex);
+    cache.insert(key, img);
   }
-}
 
-bool CDiskCache::contains(const QString& key) const {
+  QSqlQuery query(database());
+
+  // get size of the tile to be replaced, if any
+  query.prepare("SELECT size FROM tiles WHERE layer=:layer AND z=:z AND x=:x AND y=:y");
+  query.bindValue(":layer", key.layer);
+  query.bindValue(":z", key.z);
+  query.bindValue(":x", key.x);
+  query.bindValue(":y", key.y);
+  QUERY_EXEC(return );
+  const qint64 oldSize = query.next() ? query.value(0).toLongLong() : 0;
+
+  const qint64 timestamp = QDateTime::currentSecsSinceEpoch();
+  query.prepare(
+      "INSERT OR REPLACE INTO tiles (layer, z, x, y, size, timestamp, data) "
+      "VALUES (:layer, :z, :x, :y, :size, :timestamp, :data)");
+  query.bindValue(":layer", key.layer);
+  query.bindValue(":z", key.z);
+  query.bindValue(":x", key.x);
+  query.bindValue(":y", key.y);
+  query.bindValue(":size", data.size());
+  query.bindValue(":timestamp", timestamp);
+  query.bindValue(":data", data);
+  QUERY_EXEC(return );
+
   QMutexLocker lock(&mutex);
+  totalSize += data.size() - oldSize;
+  if (oldestTimestamp == 0) {
+    oldestTimestamp = timestamp;
+  }
+}
+
+bool CDiskCache::restore(const tile_key_t& key, QImage& img) {
+  if (restoreFromMemory(key, img)) {
+    return true;
+  }
+  return restoreFromDisk(key, img);
+}
+
+bool CDiskCache::restoreFromDisk(const tile_key_t& key, QImage& img) {
+  QSqlQuery query(database());
+  query.prepare("SELECT data FROM tiles WHERE layer=:layer AND z=:z AND x=:x AND y=:y");
+  query.bindValue(":layer", key.layer);
+  query.bindValue(":z", key.z);
+  query.bindValue(":x", key.x);
+  query.bindValue(":y", key.y);
+  QUERY_EXEC(return false);
+
+  if (query.next() && img.loadFromData(query.value(0).toByteArray())) {
+    QMutexLocker lock(&mutex);
+    cache.insert(key, img);
+    return true;
+  }
 
-  QCryptographicHash md5(QCryptographicHash::Md5);
-  md5.addData(key.toLatin1());
+  img = QImage();
+  return false;
+}
 
-  QString hash = md5.result().toHex();
-  return table.contains(hash) || cache.contains(hash);
+bool CDiskCache::restoreFromMemory(const tile_key_t& key, QImage& img) {
+  QMutexLocker lock(&mutex);
+  return cache.find(key, img);
 }
 
-void CDiskCache::removeCacheFile(const QFileInfo& fileinfo) {
-  QString hash = fileinfo.baseName();
-  table.remove(hash);
-  cache.remove(hash);
-  QFile::remove(fileinfo.absoluteFilePath());
+bool CDiskCache::isInMemory(const tile_key_t& key) const {
+  QMutexLocker lock(&mutex);
+  return cache.contains(key);
 }
 
-void CDiskCache::slotCleanup() {
+CTileMemCache::stats_t CDiskCache::getMemStats() const {
   QMutexLocker lock(&mutex);
+  return cache.getStats();
+}
+
+quint32 CDiskCache::layerId(const QString& url) {
+  const QByteArray& md5 = QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Md5);
+  return qFromLittleEndian<quint32>(md5.constData());
+}
 
-  const QFileInfoList& files = dir.entryInfoList(QStringList("*.png"), QDir::Files);
-  QDateTime now = QDateTime::currentDateTime();
-  qint32 maxSizeBytes = maxSizeMB * 1024 * 1024;
-  qint32 tmpSize = 0;
-  // expire old files and calculate cache size
-  for (const QFileInfo& fileinfo : files) {
-    if (fileinfo.lastModified().daysTo(now) > expirationDays) {
-      removeCacheFile(fileinfo);
-      qDebug() << "remove tile" << fileinfo.lastModified() << fileinfo.absoluteFilePath() << "(reason: expired)";
-    } else {
-      tmpSize += fileinfo.size();
+qint64 CDiskCache::removeTiles(qint64 timestamp, const QString& reason, QList<tile_key_t>* keys) {
+  QSqlDatabase db = database();
+  QSqlQuery query(db);
+
+  db.transaction();
+  query.prepare("SELECT SUM(size), COUNT(*) FROM tiles WHERE timestamp <= :timestamp");
+  query.bindValue(":timestamp", timestamp);
+  QUERY_EXEC(db.rollback(); return 0);
+  if (!query.next()) {
+    db.rollback();
+    return 0;
+  }
+  const qint64 size = query.value(0).toLongLong();
+  const qint32 count = query.value(1).toInt();
+
+  if (keys != nullptr) {
+    query.prepare("SELECT layer, z, x, y FROM tiles WHERE timestamp <= :timestamp");
+    query.bindValue(":timestamp", timestamp);
+    QUERY_EXEC(db.rollback(); return 0);
+    while (query.next()) {
+      *keys << tile_key_t{query.value(0).toUInt(), query.value(1).toInt(), query.value(2).toInt(),
+                          query.value(3).toInt()};
     }
   }
 
-  if (tmpSize > maxSizeBytes) {
-    const QFileInfoList& files = dir.entryInfoList(QStringList("*.png"), QDir::Files, QDir::Time | QDir::Reversed);
-    // if cache is still too large remove oldest files
-    for (const QFileInfo& fileinfo : files) {
-      removeCacheFile(fileinfo);
-      qDebug() << "remove tile" << fileinfo.lastModified() << fileinfo.absoluteFilePath()
-               << "(reason: cache size limit)";
+  query.prepare("DELETE FROM tiles WHERE timestamp <= :timestamp");
+  query.bindValue(":timestamp", timestamp);
+  QUERY_EXEC(db.rollback(); return 0);
+  db.commit();
 
-      tmpSize -= fileinfo.size();
+  qDebug() << "removed" << count << "tiles," << size << "bytes from" << dir.path() << "(reason:" << reason << ")";
+  return size;
+}
 
-      if (tmpSize < maxSizeBytes) {
-        break;
-      }
+void CDiskCache::slotCleanup() {
+  const qint64 maxSizeBytes = qint64(maxSizeMB) * 1024 * 1024;
+  const qint64 expiration = QDateTime::currentSecsSinceEpoch() - qint64(expirationDays) * 24 * 3600;
+
+  bool needsExpiration;
+  bool needsLimit;
+  {
+    QMutexLocker lock(&mutex);
+
+    const CTileMemCache::stats_t& stats = cache.getStats();
+    if ((stats.hits != lastStats.hits) || (stats.misses != lastStats.misses)) {
+      qDebug() << "memory cache" << dir.path() << "tiles:" << stats.entries << "MB:" << stats.bytes / (1024 * 1024)
+               << "hits:" << stats.hits << "misses:" << stats.misses << "evictions:" << stats.evictions;
+      lastStats = stats;
+    }
+
+    needsExpiration = (oldestTimestamp != 0) && (oldestTimestamp < expiration);
+    needsLimit = totalSize > maxSizeBytes;
+  }
+
+  // nothing to do as long as the running totals are within the limits
+  if (!needsExpiration && !needsLimit) {
+    return;
+  }
+
+  QSqlQuery query(database());
+
+  qint64 removedSize = 0;
+  QList<tile_key_t> expiredKeys;
+  if (needsExpiration) {
+    removedSize += removeTiles(expiration - 1, "expired", &expiredKeys);
+  }
+
+  if (needsLimit) {
+    QMutexLocker lock(&mutex);
+    qint64 tmpSize = totalSize - removedSize;
+    lock.unlock();
+
+    // if cache is still too large remove oldest tiles. Only the
+    // tiles to be removed are read from the timestamp index.
+    QUERY_RUN("SELECT timestamp, size FROM tiles ORDER BY timestamp", return )
+    qint64 timestamp = 0;
+    while ((tmpSize > maxSizeBytes) && query.next()) {
+      timestamp = query.value(0).toLongLong();
+      tmpSize -= query.value(1).toLongLong();
+    }
+    query.finish();
+
+    if (timestamp != 0) {
+      removedSize += removeTiles(timestamp, "cache size limit");
     }
   }
+
+  QUERY_RUN("SELECT MIN(timestamp) FROM tiles", return )
+  const qint64 oldest = query.next() ? query.value(0).toLongLong() : 0;
+
+  QMutexLocker lock(&mutex);
+  totalSize -= removedSize;
+  oldestTimestamp = oldest;
+  // make sure expired tiles are requested again. All other tiles stay in memory.
+  for (const tile_key_t& key : qAsConst(expiredKeys)) {
+    cache.remove(key);
+  }
 }
 
 void CDiskCache::cleanupRemovedMaps(const QSet<QString>& maps) {
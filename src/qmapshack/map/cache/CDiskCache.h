@@ -20,21 +20,93 @@
 #define CDISKCACHE_H
 
 #include <QDir>
-#include <QHash>
 #include <QImage>
 #include <QMutex>
+#include <QSet>
+#include <QSqlDatabase>
 
+#include "map/cache/CTileMemCache.h"
+
+class QThread;
 class QTimer;
 
+/**
+   @brief Two tier cache for tiles of online maps
+
+   Decoded tiles are kept in a size limited LRU memory cache. All tiles
+   received are stored in a single SQLite database file in the cache
+   directory. The database holds the tile's encoded data together with
+   it's size and timestamp. Thus lookup, expiration and size limitation
+   are done by indexed queries and never by walking the file system.
+
+   As a QSqlDatabase connection can't be shared between threads each
+   thread accessing the cache gets it's own connection. It's removed as
+   soon as the thread finishes. The mutex only
+   guards the memory cache and the running totals. It is never held
+   while accessing the database.
+ */
 class CDiskCache : public QObject {
   Q_OBJECT
  public:
-  CDiskCache(const QString& path, qint32 size, qint32 days, QObject* parent);
-  virtual ~CDiskCache() = default;
+  CDiskCache(const QString& path, qint32 size, qint32 days, qint32 memSize, QObject* parent);
+  virtual ~CDiskCache();
+
+  /**
+     @brief Store a tile
+
+     @param key   the tile's key
+     @param data  the tile's encoded image data as received from the server
+     @param img   the decoded image. If it's a null image a transparent dummy
+                  is stored in memory only.
+   */
+  void store(const tile_key_t& key, const QByteArray& data, const QImage& img);
+
+  /**
+     @brief Lookup a tile in memory and on disk
+
+     @param key   the tile's key
+     @param img   the tile's image on success, a null image otherwise
+     @return True if the tile is in the cache. This includes the transparent
+             dummy of tiles that could not be loaded from the server.
+   */
+  bool restore(const tile_key_t& key, QImage& img);
+
+  /**
+     @brief Lookup a tile in memory only
+
+     This will never access the disk. Use it on the draw thread to pick up
+     tiles decoded in the background.
+
+     @param key   the tile's key
+     @param img   the tile's image on success
+     @return True if the tile is in memory.
+   */
+  bool restoreFromMemory(const tile_key_t& key, QImage& img);
+
+  /**
+     @brief Lookup a tile on disk only
+
+     On success the decoded tile is added to the memory cache. This is
+     thread safe and meant to be called by worker threads.
+
+     @param key   the tile's key
+     @param img   the tile's image on success, a null image otherwise
+     @return True if the tile is on disk.
+   */
+  bool restoreFromDisk(const tile_key_t& key, QImage& img);
+
+  /// true if the tile is decoded in memory. This does not alter the LRU order or statistics.
+  bool isInMemory(const tile_key_t& key) const;
+
+  CTileMemCache::stats_t getMemStats() const;
+
+  /**
+     @brief Create a stable id for a map layer
 
-  void store(const QString& key, QImage& img);
-  void restore(const QString& key, QImage& img);
-  bool contains(const QString& key) const;
+     @param url   the layer's URL template
+     @return A 32bit id to be used as layer in tile_key_t
+   */
+  static quint32 layerId(const QString& url);
 
   static void cleanupRemovedMaps(const QSet<QString>& maps);
 
@@ -42,17 +114,42 @@ class CDiskCache : public QObject {
   void slotCleanup();
 
  private:
-  void removeCacheFile(const QFileInfo& fileinfo);
+  /// get the database connection for the calling thread
+  QSqlDatabase database() const;
+  /// remove the database connection of a finished thread
+  void removeConnection(QThread* thread) const;
+  bool initDB();
+  /**
+     @brief Remove all tiles with a timestamp less or equal to the given one
+
+     @param timestamp   the timestamp in seconds since epoch
+     @param reason      a string for debug output
+     @param keys        if not null, the keys of the removed tiles are appended
+     @return The number of bytes removed
+   */
+  qint64 removeTiles(qint64 timestamp, const QString& reason, QList<tile_key_t>* keys = nullptr);
 
   QDir dir;
 
   const qint32 maxSizeMB;       //< maximum cache size in MB
   const qint32 expirationDays;  //< expiration time in days
 
-  /// hash table to cache images as files on disc
-  QHash<QString, QString> table;
-  /// hash table to cache loaded images in memory
-  QHash<QString, QImage> cache;
+  /// running sum of all tile sizes in the database [bytes]
+  qint64 totalSize = 0;
+  /// lower bound of the oldest timestamp in the database, 0 if there are no tiles
+  qint64 oldestTimestamp = 0;
+
+  /// LRU cache of loaded images in memory
+  CTileMemCache cache;
+  /// the memory cache statistics at the time of the last report
+  CTileMemCache::stats_t lastStats;
+
+  /// base name of all database connections used by this cache
+  QString connectionName;
+  /// the database connection names by thread
+  mutable QHash<QThread*, QString> connections;
+  /// the number of connections created so far, to give each a unique name
+  mutable quint32 cntConnections = 0;
 
   QTimer* timer;
 
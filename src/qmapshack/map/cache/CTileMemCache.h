@@ -0,0 +1,58 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CTILEMEMCACHE_H
+#define CTILEMEMCACHE_H
+
+#include <QHash>
+#include <QImage>
+
+#include "helpers/CLruCache.h"
+
+/// structured key to address a tile of an online map
+struct tile_key_t {
+  quint32 layer;  //< id of the map layer, see CDiskCache::layerId()
+  qint32 z;       //< the zoom level or tile matrix index
+  qint32 x;       //< the tile column
+  qint32 y;       //< the tile row
+
+  bool operator==(const tile_key_t& other) const {
+    return (layer == other.layer) && (z == other.z) && (x == other.x) && (y == other.y);
+  }
+};
+
+inline uint qHash(const tile_key_t& key, uint seed = 0) {
+  return qHash((quint64(key.layer) << 32) | quint32(key.z), seed) ^
+         qHash((quint64(quint32(key.x)) << 32) | quint32(key.y), seed);
+}
+
+/**
+   @brief A least recently used memory cache for decoded tile images
+
+   The cache accounts the size of each image in bytes. If the sum exceeds
+   the configured limit the least recently used images are evicted.
+
+   The class is not thread safe. The owner has to serialize access.
+ */
+class CTileMemCache : public CLruCache<tile_key_t, QImage> {
+ public:
+  CTileMemCache(qint64 maxBytes) : CLruCache(maxBytes, [](const QImage& img) { return qint64(img.sizeInBytes()); }) {}
+  virtual ~CTileMemCache() = default;
+};
+
+#endif  // CTILEMEMCACHE_H
@@ -42,8 +42,8 @@ struct sign_info_t {
   bool ny = false;
 };
 
-quint32 CGarminPolygon::cnt = 0;
-qint32 CGarminPolygon::maxVecSize = 0;
+thread_local quint32 CGarminPolygon::cnt = 0;
+thread_local qint32 CGarminPolygon::maxVecSize = 0;
 
 quint32 CGarminPolygon::decode(qint32 iCenterLon, qint32 iCenterLat, quint32 shift, bool line, const quint8* pData,
                                const quint8* pEnd) {
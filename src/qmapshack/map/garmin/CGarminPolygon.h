@@ -73,8 +73,9 @@ class CGarminPolygon {
 
   QStringList labels;
 
-  static quint32 cnt;
-  static qint32 maxVecSize;
+  /// per thread as subdivisions are decoded concurrently
+  static thread_local quint32 cnt;
+  static thread_local qint32 maxVecSize;
 
  private:
   void bits_per_coord(quint8 base, quint8 bfirst, quint32& bx, quint32& by, sign_info_t& signinfo, bool isVer2);
@@ -86,7 +86,7 @@ CGarminStrTbl6::CGarminStrTbl6(const quint16 codepage, const quint8 mask, QObjec
 
 CGarminStrTbl6::~CGarminStrTbl6() {}
 
-void CGarminStrTbl6::fill() {
+void CGarminStrTbl6::bitreader_t::fill() {
   quint32 tmp;
   if (bits < 6) {
     tmp = *p++;
@@ -113,24 +113,24 @@ void CGarminStrTbl6::get(CFileExt& file, quint32 offset, type_e t, QStringList&
   quint8 c1 = 0;
   quint8 c2 = 0;
   quint32 idx = 0;
-  reg = 0;
-  bits = 0;
+  char buffer[1025];
+  bitreader_t reader;
 
   QByteArray data;
   quint32 size = (sizeLBL1 - offset) < 200 ? (sizeLBL1 - offset) : 200;
 
   readFile(file, offsetLBL1 + offset, size, data);
 
-  p = (quint8*)data.data();
+  reader.p = (quint8*)data.data();
 
-  fill();
+  reader.fill();
 
   unsigned lastSeperator = 0;
   while (idx < (sizeof(buffer) - 1)) {
-    c1 = reg >> 26;
-    reg <<= 6;
-    bits -= 6;
-    fill();
+    c1 = reader.reg >> 26;
+    reader.reg <<= 6;
+    reader.bits -= 6;
+    reader.fill();
     // terminator
     if (c1 > 0x2F) {
       break;
@@ -139,16 +139,16 @@ void CGarminStrTbl6::get(CFileExt& file, quint32 offset, type_e t, QStringList&
     c2 = str6tbl1[c1];
     if (c2 == 0) {
       if (c1 == 0x1C) {
-        c1 = reg >> 26;
-        reg <<= 6;
-        bits -= 6;
-        fill();
+        c1 = reader.reg >> 26;
+        reader.reg <<= 6;
+        reader.bits -= 6;
+        reader.fill();
         buffer[idx++] = str6tbl2[c1];
       } else if (c1 == 0x1B) {
-        c1 = reg >> 26;
-        reg <<= 6;
-        bits -= 6;
-        fill();
+        c1 = reader.reg >> 26;
+        reader.reg <<= 6;
+        reader.bits -= 6;
+        reader.fill();
         buffer[idx++] = str6tbl3[c1];
       } else if (c1 > 0x1C && c1 < 0x20) {
         lastSeperator = c1;
@@ -32,12 +32,15 @@ class CGarminStrTbl6 : public IGarminStrTbl {
   static const char str6tbl2[];
   static const char str6tbl3[];
 
-  void fill();
-  /// temp shift reg buffer
-  quint32 reg = 0;
-  /// bits in buffer
-  quint32 bits = 0;
-  /// pointer to current data;
-  const quint8* p = nullptr;
+  /// state of the 6 bit decoder, local to get() to keep it reentrant
+  struct bitreader_t {
+    void fill();
+    /// temp shift reg buffer
+    quint32 reg = 0;
+    /// bits in buffer
+    quint32 bits = 0;
+    /// pointer to current data;
+    const quint8* p = nullptr;
+  };
 };
 #endif  // CGARMINSTRTBL6_H
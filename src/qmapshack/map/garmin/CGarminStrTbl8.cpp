@@ -46,6 +46,8 @@ void CGarminStrTbl8::get(CFileExt& file, quint32 offset, type_e t, QStringList&
 
   unsigned lastSeperator = 0;
 
+  // local buffer to keep get() reentrant
+  char buffer[1025];
   char* pBuffer = buffer;
   *pBuffer = 0;
   while (*lbl != 0) {
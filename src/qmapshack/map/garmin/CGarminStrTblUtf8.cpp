@@ -43,6 +43,8 @@ void CGarminStrTblUtf8::get(CFileExt& file, quint32 offset, type_e t, QStringLis
   readFile(file, offsetLBL1 + offset, size, data);
   char* lbl = data.data();
 
+  // local buffer to keep get() reentrant
+  char buffer[1025];
   char* pBuffer = buffer;
   *pBuffer = 0;
 
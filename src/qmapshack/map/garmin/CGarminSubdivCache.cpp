@@ -0,0 +1,73 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "map/garmin/CGarminSubdivCache.h"
+
+CGarminSubdivCache::CGarminSubdivCache(qint64 maxBytes) : cache(maxBytes, &CGarminSubdivCache::estimateSize) {}
+
+bool CGarminSubdivCache::find(const garmin_subdiv_key_t& key, garmin_subdiv_t& subdiv) {
+  QMutexLocker lock(&mutex);
+  return cache.find(key, subdiv);
+}
+
+void CGarminSubdivCache::insert(const garmin_subdiv_key_t& key, const garmin_subdiv_t& subdiv) {
+  // estimate outside the lock, it has to iterate over all objects
+  const qint64 bytes = estimateSize(subdiv);
+
+  QMutexLocker lock(&mutex);
+  cache.insert(key, subdiv, bytes);
+}
+
+void CGarminSubdivCache::clear() {
+  QMutexLocker lock(&mutex);
+  cache.clear();
+}
+
+void CGarminSubdivCache::setMaxBytes(qint64 bytes) {
+  QMutexLocker lock(&mutex);
+  cache.setMaxBytes(bytes);
+}
+
+CGarminSubdivCache::stats_t CGarminSubdivCache::getStats() const {
+  QMutexLocker lock(&mutex);
+  return cache.getStats();
+}
+
+qint64 CGarminSubdivCache::estimateSize(const garmin_subdiv_t& subdiv) {
+  auto labelSize = [](const QStringList& labels) {
+    qint64 bytes = 0;
+    for (const QString& label : labels) {
+      bytes += sizeof(QString) + label.size() * sizeof(QChar);
+    }
+    return bytes;
+  };
+
+  qint64 bytes = sizeof(garmin_subdiv_t);
+  for (const QVector<CGarminPolygon>* lines : {&subdiv.polygons, &subdiv.polylines}) {
+    for (const CGarminPolygon& line : *lines) {
+      // pixel and coords share their data until the line gets projected
+      bytes += sizeof(CGarminPolygon) + line.coords.size() * sizeof(QPointF) + labelSize(line.labels);
+    }
+  }
+  for (const QVector<CGarminPoint>* pts : {&subdiv.points, &subdiv.pois}) {
+    for (const CGarminPoint& pt : *pts) {
+      bytes += sizeof(CGarminPoint) + labelSize(pt.labels);
+    }
+  }
+  return bytes;
+}
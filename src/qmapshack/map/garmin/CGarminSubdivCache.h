@@ -0,0 +1,102 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#ifndef CGARMINSUBDIVCACHE_H
+#define CGARMINSUBDIVCACHE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+#include "helpers/CLruCache.h"
+#include "map/garmin/CGarminPoint.h"
+#include "map/garmin/CGarminPolygon.h"
+
+/// structured key to address a subdivision of a Garmin IMG file
+struct garmin_subdiv_key_t {
+  quint32 subfile;  //< index of the subfile within the IMG file
+  quint32 subdiv;   //< index of the subdivision within the subfile
+
+  bool operator==(const garmin_subdiv_key_t& other) const {
+    return (subfile == other.subfile) && (subdiv == other.subdiv);
+  }
+};
+
+inline uint qHash(const garmin_subdiv_key_t& key, uint seed = 0) {
+  return qHash((quint64(key.subfile) << 32) | key.subdiv, seed);
+}
+
+/// all objects of a subdivision, decoded with labels. Coordinates are [rad].
+struct garmin_subdiv_t {
+  QVector<CGarminPolygon> polygons;
+  QVector<CGarminPolygon> polylines;
+  QVector<CGarminPoint> points;
+  QVector<CGarminPoint> pois;
+};
+
+/**
+   @brief A least recently used memory cache for decoded subdivisions of a Garmin IMG file
+
+   Decoding a subdivision includes the string table lookups for all labels. That
+   is the expensive part of rendering a Garmin map. As the cached objects are in
+   [rad] a pan or zoom within the same map level only has to project the objects
+   again.
+
+   The size of a subdivision is estimated from the number of points and labels.
+   If the sum exceeds the limit the least recently used subdivisions are evicted.
+   All methods are thread safe.
+ */
+class CGarminSubdivCache {
+ public:
+  using stats_t = CLruCache<garmin_subdiv_key_t, garmin_subdiv_t>::stats_t;
+
+  CGarminSubdivCache(qint64 maxBytes);
+  virtual ~CGarminSubdivCache() = default;
+
+  /**
+     @brief Lookup a subdivision and mark it as most recently used
+
+     @param key     the subdivision's key
+     @param subdiv  the decoded objects are assigned to this on success
+     @return True if the subdivision has been found
+   */
+  bool find(const garmin_subdiv_key_t& key, garmin_subdiv_t& subdiv);
+
+  /**
+     @brief Insert or replace a subdivision
+
+     @param key     the subdivision's key
+     @param subdiv  the decoded objects
+   */
+  void insert(const garmin_subdiv_key_t& key, const garmin_subdiv_t& subdiv);
+
+  void clear();
+
+  void setMaxBytes(qint64 bytes);
+
+  stats_t getStats() const;
+
+ private:
+  static qint64 estimateSize(const garmin_subdiv_t& subdiv);
+
+  mutable QMutex mutex;
+
+  CLruCache<garmin_subdiv_key_t, garmin_subdiv_t> cache;
+};
+
+#endif  // CGARMINSUBDIVCACHE_H
@@ -71,7 +71,5 @@ class IGarminStrTbl : public QObject {
   const quint8 mask;
   quint32 mask32;
   quint64 mask64;
-
-  char buffer[1025];
 };
 #endif  // IGARMINSTRTBL_H
@@ -32,8 +32,19 @@
 #include "poi/IPoiFile.h"
 #include "poi/IPoiItem.h"
 
+// estimated size of an interned tag, including the reference counter
+static qint64 tagSize(const QString& tag) { return sizeof(QString) + sizeof(quint32) + tag.capacity() * sizeof(QChar); }
+
 CPoiFilePOI::CPoiFilePOI(const QString& filename, CPoiDraw* parent)
-    : IPoiFile(parent), filename(filename), loadTimer(new QTimer(this)) {
+    : IPoiFile(parent),
+      filename(filename),
+      loadTimer(new QTimer(this)),
+      loadedCells(qint64(cacheSizeMB) * 1024 * 1024,
+                  [](const cell_t&) { return qint64(sizeof(cell_key_t) + sizeof(cell_t)); }) {
+  // cells used by the last request are needed for the current view
+  loadedCells.setKeep([this](const cell_key_t&, const cell_t& cell) { return cell.lastUsed == cacheStamp; });
+  loadedCells.setEvicted([this](const cell_key_t&, cell_t& cell) { releaseCell(cell); });
+
   // Set true if the file could be open and loaded successfully
   // If not set true the system will take care to destroy this object
   isActivated = true;
@@ -71,6 +82,23 @@ CPoiFilePOI::CPoiFilePOI(const QString& filename, CPoiDraw* parent)
   QSqlDatabase::removeDatabase(filename + "_bbox");
 }
 
+CPoiFilePOI::~CPoiFilePOI() {
+  QMutexLocker lock(&mutex);
+  const cache_stats_t& cacheStats = getCacheStats();
+  qDebug() << "POI cache:" << filename << "cells" << cacheStats.cells << "pois" << cacheStats.pois << "tags"
+           << cacheStats.tags << "evictions" << cacheStats.evictions << "bytes" << cacheStats.bytes;
+
+  QStringList names;
+  for (const connection_t& connection : qAsConst(connections)) {
+    names << connection.name;
+  }
+  // the prepared queries must be gone before the connections can be removed
+  connections.clear();
+  for (const QString& name : qAsConst(names)) {
+    QSqlDatabase::removeDatabase(name);
+  }
+}
+
 void CPoiFilePOI::draw(IDrawContext::buffer_t& buf) {
   // !!!! NOTE !!!!
   // This is running in it's own thread, not the main thread.
@@ -110,51 +138,38 @@ void CPoiFilePOI::draw(IDrawContext::buffer_t& buf) {
 
   // draw POI
   QMutexLocker lock(&mutex);
-  displayedPois.clear();
-  QRectF freeSpaceRect(QPointF(), IPoiFile::iconSize() * 2);
   // Find POIs in view
+  const QRect cellsM10(QPoint(qFloor(xMin * RAD_TO_DEG * 10), qFloor(yMin * RAD_TO_DEG * 10)),
+                       QPoint(qCeil(xMax * RAD_TO_DEG * 10) - 1, qCeil(yMax * RAD_TO_DEG * 10) - 1));
+  QList<quint64> categoryIDs;
   const QList<quint64>& keys = categoryActivated.keys();
   for (quint64 categoryID : keys) {
-    if (categoryActivated[categoryID] != Qt::Checked) {
-      continue;
+    if (categoryActivated[categoryID] == Qt::Checked) {
+      categoryIDs << categoryID;
     }
-    for (int minLonM10 = qFloor(xMin * RAD_TO_DEG * 10); minLonM10 < qCeil(xMax * RAD_TO_DEG * 10); minLonM10++) {
-      for (int minLatM10 = qFloor(yMin * RAD_TO_DEG * 10); minLatM10 < qCeil(yMax * RAD_TO_DEG * 10); minLatM10++) {
-        if (!loadedPoisByArea.contains(categoryID) || !loadedPoisByArea[categoryID].contains(minLonM10) ||
-            !loadedPoisByArea[categoryID][minLonM10].contains(minLatM10)) {
-          loadPOIsFromFile(categoryID, minLonM10, minLatM10);
-        }
-        if (poi->needsRedraw()) {
-          return;
-        }
-        for (quint64 poiToDrawID : qAsConst(loadedPoisByArea)[categoryID][minLonM10][minLatM10]) {
-          const CPoiItemPOI& poiToDraw = loadedPois[poiToDrawID];
-          QPointF pt = poiToDraw.getCoordinates();
-          poi->convertRad2Px(pt);
-
-          freeSpaceRect.moveCenter(pt);
-
-          bool foundIntersection = false;
-          for (poiGroup_t& poiGroup : displayedPois) {
-            if (poiGroup.iconLocation.intersects(freeSpaceRect)) {
-              foundIntersection = true;
-              poiGroup.pois.insert(poiToDrawID);
-              break;
-            }
-          }
+  }
+  loadPOIsFromFile(categoryIDs, cellsM10, true);
+  // the POIs have been added after their cells, thus the cache can exceed it's limit
+  loadedCells.evict();
+  if (poi->needsRedraw()) {
+    displayedPois.clear();
+    displayedPoisGrid.clear(IPoiFile::iconSize());
+    cluster.isValid = false;
+    return;
+  }
 
-          if (!foundIntersection) {
-            poiGroup_t poiGroup;
-            QRectF iconRect(QPointF(), IPoiFile::iconSize());
-            iconRect.moveCenter(pt);
-            poiGroup.iconLocation = iconRect;
-            poiGroup.iconCenter = poiToDraw.getCoordinates();
-            poiGroup.pois.insert(poiToDrawID);
-            displayedPois.append(poiGroup);
-          }
-        }
-      }
+  // If the map has just been moved the groups are the same. Only their location changes.
+  QPointF offset;
+  if (isClusterMoved(categoryIDs, cellsM10, offset)) {
+    for (poiGroup_t& poiGroup : displayedPois) {
+      poiGroup.iconLocation.translate(offset);
     }
+    cluster.refPx.translate(offset);
+    buildPoiGrid();
+  } else {
+    QPolygonF refRad;
+    refRad << buf.ref1 << buf.ref2 << buf.ref3 << buf.ref4;
+    clusterPois(categoryIDs, cellsM10, refRad);
   }
 
   // Draw Icons
@@ -179,7 +194,7 @@ void CPoiFilePOI::draw(IDrawContext::buffer_t& buf) {
       CDraw::text(text, p, labelRect.toRect(), Qt::darkBlue);
     } else if (CMainWindow::self().isPoiText()) {
       // Draw Name
-      const QString& name = loadedPois[*poiGroup.pois.begin()].getName();
+      const QString& name = getPoi(*poiGroup.pois.begin()).getName();
       QRectF rect = fm.boundingRect(name);
       rect.adjust(-2, -2, 2, 2);
 
@@ -221,7 +236,7 @@ bool CPoiFilePOI::findPoiCloseBy(const QPoint& px, QSet<IPoiItem>& poiItems, QLi
   poiGroup_t poiGroup;
   if (getPoiGroupCloseBy(px, poiGroup)) {
     for (quint64 key : qAsConst(poiGroup.pois)) {
-      poiItems.insert(loadedPois[key].toPoi());
+      poiItems.insert(getPoi(key).toPoi());
     }
     posPoiHighlight.append(poiGroup.iconCenter);
     return true;
@@ -239,26 +254,29 @@ void CPoiFilePOI::findPoisIn(const QRectF& degRect, QSet<IPoiItem>& pois, QList<
 
   // Find POIs
   QSet<quint64> copiedItems;  // Some Items may appear in multiple categories. We only want to copy those once.
+  // Imagine the user moves the screen in an l-shape while updating the selection rectangle. It is possible that
+  // some tiles are not laded then
+  const QRect cellsM10(QPoint(qFloor(degRect.left() * 10), qFloor(degRect.bottom() * 10)),
+                       QPoint(qFloor(degRect.right() * 10), qFloor(degRect.top() * 10)));
+  QList<quint64> categoryIDs;
   const QList<quint64>& keys = categoryActivated.keys();
   for (quint64 categoryID : keys) {
-    if (categoryActivated[categoryID] != Qt::Checked) {
-      continue;
+    if (categoryActivated[categoryID] == Qt::Checked) {
+      categoryIDs << categoryID;
     }
-    for (int minLonM10 = qFloor(degRect.left() * 10); minLonM10 <= qFloor(degRect.right() * 10); minLonM10++) {
-      for (int minLatM10 = qFloor(degRect.bottom() * 10); minLatM10 <= qFloor(degRect.top() * 10); minLatM10++) {
-        // Imagine the user moves the screen in an l-shape while updating the selection rectangle. It is possible that
-        // some tiles are not laded then
-        if (!loadedPoisByArea.contains(categoryID) || !loadedPoisByArea[categoryID].contains(minLonM10) ||
-            !loadedPoisByArea[categoryID][minLonM10].contains(minLatM10)) {
-          loadPOIsFromFile(categoryID, minLonM10, minLatM10);
-        }
-        for (quint64 poiFoundID : qAsConst(loadedPoisByArea)[categoryID][minLonM10][minLatM10]) {
-          const CPoiItemPOI& poiItemFound = loadedPois[poiFoundID];
-          if (!copiedItems.contains(poiItemFound.getKey())) {
+  }
+  // the cells of the current view have to stay in the cache, thus this is no new view
+  loadPOIsFromFile(categoryIDs, cellsM10, false);
+
+  for (quint64 categoryID : qAsConst(categoryIDs)) {
+    for (int minLonM10 = cellsM10.left(); minLonM10 <= cellsM10.right(); minLonM10++) {
+      for (int minLatM10 = cellsM10.top(); minLatM10 <= cellsM10.bottom(); minLatM10++) {
+        for (quint64 poiFoundID : getPoisInCell({categoryID, minLonM10, minLatM10})) {
+          if (!copiedItems.contains(poiFoundID)) {
             // Maybe look through the whole code of selecting items from a map to avoid this conversion
-            if (degRect.contains(poiItemFound.getCoordinates() * RAD_TO_DEG)) {
-              pois.insert(poiItemFound.toPoi());
-              copiedItems.insert(poiItemFound.getKey());
+            if (degRect.contains(getCoordinates(loadedPois.value(poiFoundID)) * RAD_TO_DEG)) {
+              pois.insert(getPoi(poiFoundID).toPoi());
+              copiedItems.insert(poiFoundID);
             }
           }
         }
@@ -284,7 +302,7 @@ bool CPoiFilePOI::getToolTip(const QPoint& px, QString& str) const {
   bool success = getPoiGroupCloseBy(px, poiGroup);
   if (success) {
     if (poiGroup.pois.count() == 1) {
-      const CPoiItemPOI& poiFound = loadedPois[*poiGroup.pois.begin()];
+      const CPoiItemPOI& poiFound = getPoi(*poiGroup.pois.begin());
       const QString& name = poiFound.getName(false);
       if (!name.isEmpty()) {
         str += "<b>" + name + "</b><br>\n";
@@ -310,7 +328,7 @@ bool CPoiFilePOI::getToolTip(const QPoint& px, QString& str) const {
       if (poiGroup.pois.count() <= 10) {
         str += "<br>\n" + tr("POIs at this point:");
         for (quint64 poiID : qAsConst(poiGroup.pois)) {
-          str += "<br>\n<b>" + loadedPois[poiID].getName() + "</b>";
+          str += "<br>\n<b>" + getPoi(poiID).getName() + "</b>";
         }
       }
     }
@@ -374,110 +392,425 @@ void CPoiFilePOI::getPoiIcon(QPixmap& icon, const CPoiFilePOI::poiGroup_t& poiGr
   if (poiGroup.pois.count() > 1) {
     icon = QPixmap("://icons/poi/SJJB/png/poi_point_of_interest.n.32.png");
   } else {
-    getPoiIcon(icon, loadedPois[*poiGroup.pois.begin()]);
+    getPoiIcon(icon, loadedPois.value(*poiGroup.pois.begin()).data);
   }
 }
 
-void CPoiFilePOI::getPoiIcon(QPixmap& icon, const CPoiItemPOI& poi, const QString& definingTag) {
+void CPoiFilePOI::getPoiIcon(QPixmap& icon, const QStringList& rawData, const QString& definingTag) {
   if (!definingTag.isEmpty() && tagMap.contains(definingTag)) {
-    icon = tagMap[definingTag].getIcon(poi.getRawData());
+    icon = tagMap[definingTag].getIcon(rawData);
     return;
   }
-  for (const QString& tag : poi.getRawData()) {
+  for (const QString& tag : rawData) {
     if (tagMap.contains(tag)) {
-      icon = tagMap[tag].getIcon(poi.getRawData());
+      icon = tagMap[tag].getIcon(rawData);
       return;
     }
   }
   icon = QPixmap("://icons/poi/SJJB/png/poi_point_of_interest.n.32.png");
 }
 
-bool CPoiFilePOI::overlapsWithIcon(const QRectF& rect) const {
-  for (const poiGroup_t& poiGroup : displayedPois) {
-    if (poiGroup.iconLocation.intersects(rect)) {
-      return true;
+void CPoiFilePOI::poiGrid_t::clear(const QSizeF& size) {
+  cellSize = size;
+  cells.clear();
+}
+
+static inline quint64 gridKey(qint32 x, qint32 y) { return (quint64(quint32(x)) << 32) | quint32(y); }
+
+void CPoiFilePOI::poiGrid_t::insert(const QPointF& pt, qint32 idx) {
+  cells[gridKey(qFloor(pt.x() / cellSize.width()), qFloor(pt.y() / cellSize.height()))].append(idx);
+}
+
+template <typename F>
+qint32 CPoiFilePOI::poiGrid_t::findFirst(const QRectF& area, F test) const {
+  if (cells.isEmpty() || cellSize.isEmpty()) {
+    return NOIDX;
+  }
+
+  const qint32 x1 = qFloor(area.left() / cellSize.width());
+  const qint32 x2 = qFloor(area.right() / cellSize.width());
+  const qint32 y1 = qFloor(area.top() / cellSize.height());
+  const qint32 y2 = qFloor(area.bottom() / cellSize.height());
+
+  qint32 first = NOIDX;
+  for (qint32 x = x1; x <= x2; x++) {
+    for (qint32 y = y1; y <= y2; y++) {
+      auto cell = cells.constFind(gridKey(x, y));
+      if (cell == cells.constEnd()) {
+        continue;
+      }
+      // indices are in ascending order, thus the first match in a cell is the lowest one
+      for (qint32 idx : *cell) {
+        if (first != NOIDX && idx > first) {
+          break;
+        }
+        if (test(idx)) {
+          first = idx;
+          break;
+        }
+      }
     }
   }
-  return false;
+  return first;
+}
+
+bool CPoiFilePOI::overlapsWithIcon(const QRectF& rect) const {
+  const QSizeF& halfIcon = QSizeF(IPoiFile::iconSize()) / 2;
+  const QRectF& area = rect.adjusted(-halfIcon.width(), -halfIcon.height(), halfIcon.width(), halfIcon.height());
+  return displayedPoisGrid.findFirst(
+             area, [&](qint32 idx) { return displayedPois[idx].iconLocation.intersects(rect); }) != NOIDX;
 }
 
 bool CPoiFilePOI::getPoiGroupCloseBy(const QPoint& px, CPoiFilePOI::poiGroup_t& poiItem) const {
-  for (const poiGroup_t& poiGroup : displayedPois) {
-    if (poiGroup.iconLocation.contains(px)) {
-      poiItem = poiGroup;
-      return true;
+  QRectF area(QPointF(), IPoiFile::iconSize());
+  area.moveCenter(px);
+  qint32 idx = displayedPoisGrid.findFirst(area, [&](qint32 i) { return displayedPois[i].iconLocation.contains(px); });
+  if (idx == NOIDX) {
+    return false;
+  }
+  poiItem = displayedPois[idx];
+  return true;
+}
+
+void CPoiFilePOI::clusterPois(const QList<quint64>& categoryIDs, const QRect& cellsM10, const QPolygonF& refRad) {
+  displayedPois.clear();
+  displayedPoisGrid.clear(IPoiFile::iconSize());
+
+  QRectF freeSpaceRect(QPointF(), IPoiFile::iconSize() * 2);
+  // the centers of all icons that can intersect with the free space
+  QRectF area(QPointF(), IPoiFile::iconSize() * 3);
+  for (quint64 categoryID : categoryIDs) {
+    for (int minLonM10 = cellsM10.left(); minLonM10 <= cellsM10.right(); minLonM10++) {
+      for (int minLatM10 = cellsM10.top(); minLatM10 <= cellsM10.bottom(); minLatM10++) {
+        for (quint64 poiToDrawID : getPoisInCell({categoryID, minLonM10, minLatM10})) {
+          const QPointF& coordinates = getCoordinates(loadedPois.value(poiToDrawID));
+          QPointF pt = coordinates;
+          poi->convertRad2Px(pt);
+
+          freeSpaceRect.moveCenter(pt);
+          area.moveCenter(pt);
+
+          qint32 idx = displayedPoisGrid.findFirst(
+              area, [&](qint32 i) { return displayedPois[i].iconLocation.intersects(freeSpaceRect); });
+          if (idx != NOIDX) {
+            displayedPois[idx].pois.insert(poiToDrawID);
+          } else {
+            poiGroup_t poiGroup;
+            QRectF iconRect(QPointF(), IPoiFile::iconSize());
+            iconRect.moveCenter(pt);
+            poiGroup.iconLocation = iconRect;
+            poiGroup.iconCenter = coordinates;
+            poiGroup.pois.insert(poiToDrawID);
+            displayedPoisGrid.insert(pt, displayedPois.count());
+            displayedPois.append(poiGroup);
+          }
+        }
+      }
     }
   }
-  return false;
+
+  QPolygonF refPx = refRad;
+  poi->convertRad2Px(refPx);
+
+  cluster.isValid = true;
+  cluster.cellsM10 = cellsM10;
+  cluster.categoryIDs = categoryIDs;
+  cluster.iconSize = IPoiFile::iconSize();
+  cluster.refRad = refRad;
+  cluster.refPx = refPx;
 }
 
-void CPoiFilePOI::loadPOIsFromFile(quint64 categoryID, int minLonM10, int minLatM10) {
-  QMutexLocker lock(&mutex);
+bool CPoiFilePOI::isClusterMoved(const QList<quint64>& categoryIDs, const QRect& cellsM10, QPointF& offset) const {
+  if (!cluster.isValid || cluster.cellsM10 != cellsM10 || cluster.categoryIDs != categoryIDs ||
+      cluster.iconSize != IPoiFile::iconSize()) {
+    return false;
+  }
 
-  // check if query is within bounds
-  if (!bbox.intersects({minLonM10 / 10.0, minLatM10 / 10.0, 0.1, 0.1})) {
-    return;
+  QPolygonF refPx = cluster.refRad;
+  poi->convertRad2Px(refPx);
+  offset = QPointF();
+  for (int i = 0; i < refPx.count(); i++) {
+    const QPointF& delta = refPx[i] - cluster.refPx[i];
+    if (i == 0) {
+      offset = delta;
+    } else if ((delta - offset).manhattanLength() > 0.01) {
+      return false;
+    }
   }
+  return true;
+}
+
+void CPoiFilePOI::buildPoiGrid() {
+  displayedPoisGrid.clear(IPoiFile::iconSize());
+  for (qint32 idx = 0; idx < displayedPois.count(); idx++) {
+    displayedPoisGrid.insert(displayedPois[idx].iconLocation.center(), idx);
+  }
+}
+
+CPoiFilePOI::connection_t* CPoiFilePOI::getConnection() {
+  QMutexLocker lock(&mutex);
 
-  // Open Database here so it is owned by the right thread
-  if (!QSqlDatabase::contains(filename)) {
-    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", filename);
+  QThread* thread = QThread::currentThread();
+  if (!connections.contains(thread)) {
+    // Open database here so it is owned by the right thread. As thread
+    // addresses are reused the name has to be unique.
+    const QString& name = QString("%1_%2").arg(filename).arg(++cntConnections);
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", name);
     db.setDatabaseName(filename);
     if (!db.open()) {
       qDebug() << "failed to open database" << db.lastError();
       isActivated = false;
+      return nullptr;
+    }
+    connections[thread].name = name;
+
+    // A draw context's thread finishes after each draw request and is restarted
+    // with the next one. Thus the connection is kept as long as the thread object
+    // exists and not just until the thread finishes. As the connection is
+    // registered only once per thread object this is connected only once, too.
+    connect(
+        thread, &QObject::destroyed, this, [this, thread]() { removeConnection(thread); }, Qt::DirectConnection);
+  }
+  return &connections[thread];
+}
+
+void CPoiFilePOI::removeConnection(QThread* thread) {
+  QString name;
+  {
+    QMutexLocker lock(&mutex);
+    if (!connections.contains(thread)) {
       return;
     }
+    // the prepared queries must be gone before the connection can be removed
+    name = connections.take(thread).name;
+  }
+  QSqlDatabase::removeDatabase(name);
+}
+
+QSqlQuery& CPoiFilePOI::getRangeQuery(connection_t& connection, int nCategories) {
+  if (!connection.queries.contains(nCategories)) {
+    QStringList placeholders;
+    for (int i = 0; i < nCategories; i++) {
+      placeholders << QString(":categoryID%1").arg(i);
+    }
+
+    QSqlQuery query(QSqlDatabase::database(connection.name));
+    query.setForwardOnly(true);
+    query.prepare(
+        "SELECT main.poi_index.maxLat, main.poi_index.maxLon, main.poi_index.minLat, main.poi_index.minLon, "
+        "main.poi_data.data, main.poi_data.id, main.poi_category_map.category "
+        "FROM main.poi_index "
+        "JOIN main.poi_category_map ON main.poi_category_map.id = main.poi_index.id "
+        "JOIN main.poi_data ON main.poi_data.id = main.poi_index.id "
+        "WHERE main.poi_index.maxLat<:maxLat "
+        "AND main.poi_index.minLat>=:minLat "
+        "AND main.poi_index.maxLon<:maxLon "
+        "AND main.poi_index.minLon>=:minLon "
+        "AND main.poi_category_map.category IN (" +
+        placeholders.join(", ") + ")");
+    connection.queries[nCategories] = query;
+  }
+  return connection.queries[nCategories];
+}
+
+// Get the cell a POI belongs to. This has to match the range of the query exactly.
+// Returns false if the POI spans more than one cell.
+static bool cellOf(qreal min, qreal max, int& cellM10) {
+  cellM10 = qFloor(min * 10);
+  if (min < cellM10 / 10.) {
+    cellM10--;
+  } else if (min >= (cellM10 + 1) / 10.) {
+    cellM10++;
+  }
+  return max < (cellM10 + 1) / 10.;
+}
+
+void CPoiFilePOI::loadPOIsFromFile(const QList<quint64>& categoryIDs, const QRect& cellsM10, bool isView) {
+  QMutexLocker lock(&mutex);
+  if (isView) {
+    cacheStamp++;
+  }
+
+  // collect all cells not loaded yet, that are within bounds. All others are marked as used.
+  QSet<cell_key_t> missingCells;
+  QList<quint64> missingCategories;
+  QRect rangeM10;
+  for (quint64 categoryID : categoryIDs) {
+    bool isMissing = false;
+    for (int minLonM10 = cellsM10.left(); minLonM10 <= cellsM10.right(); minLonM10++) {
+      for (int minLatM10 = cellsM10.top(); minLatM10 <= cellsM10.bottom(); minLatM10++) {
+        if (!bbox.intersects({minLonM10 / 10.0, minLatM10 / 10.0, 0.1, 0.1})) {
+          continue;
+        }
+        const cell_key_t key = {categoryID, minLonM10, minLatM10};
+        cell_t* cell = loadedCells.find(key);
+        if (cell != nullptr) {
+          cell->lastUsed = cacheStamp;
+          continue;
+        }
+        missingCells.insert(key);
+        rangeM10 |= QRect(minLonM10, minLatM10, 1, 1);
+        isMissing = true;
+      }
+    }
+    if (isMissing) {
+      missingCategories << categoryID;
+    }
+  }
+
+  if (missingCells.isEmpty()) {
+    return;
+  }
+
+  connection_t* connection = getConnection();
+  if (connection == nullptr) {
+    return;
+  }
+
+  // a single query for all missing cells and categories
+  QSqlQuery& query = getRangeQuery(*connection, missingCategories.count());
+  query.bindValue(":maxLat", QString::number((rangeM10.bottom() + 1) / 10., 'f'));
+  query.bindValue(":minLat", QString::number(rangeM10.top() / 10., 'f'));
+  query.bindValue(":maxLon", QString::number((rangeM10.right() + 1) / 10., 'f'));
+  query.bindValue(":minLon", QString::number(rangeM10.left() / 10., 'f'));
+  for (int i = 0; i < missingCategories.count(); i++) {
+    query.bindValue(QString(":categoryID%1").arg(i), missingCategories[i]);
+  }
+  if (!query.exec()) {
+    qDebug() << "failed to load POIs" << query.lastError();
+    return;
+  }
+
+  // the POI groups have to be rebuilt
+  cluster.isValid = false;
+
+  // Empty cells are loaded, too
+  for (const cell_key_t& key : qAsConst(missingCells)) {
+    cell_t cell;
+    cell.lastUsed = cacheStamp;
+    loadedCells.insert(key, cell);
   }
 
-  QSqlQuery query(QSqlDatabase::database(filename));
-  query.prepare(
-      "SELECT main.poi_index.maxLat, main.poi_index.maxLon, main.poi_index.minLat, main.poi_index.minLon, "
-      "main.poi_data.data, main.poi_data.id "
-      "FROM main.poi_data, main.poi_index "
-      "WHERE main.poi_data.id IN "
-      "("
-      "    SELECT main.poi_category_map.id "
-      "    FROM main.poi_category_map "
-      "    WHERE main.poi_category_map.id IN "
-      "    ( "
-      "        SELECT main.poi_index.id "
-      "        FROM main.poi_index "
-      "        WHERE main.poi_index.maxLat<:maxLat "
-      "        AND main.poi_index.minLat>=:minLat "
-      "        AND main.poi_index.maxLon<:maxLon "
-      "        AND main.poi_index.minLon>=:minLon "
-      "    ) "
-      "    AND main.poi_category_map.category=:categoryID "
-      ") "
-      "AND main.poi_data.id = main.poi_index.id");
-  query.bindValue(":maxLat", QString::number((minLatM10 + 1) / 10., 'f'));
-  query.bindValue(":minLat", QString::number(minLatM10 / 10., 'f'));
-  query.bindValue(":maxLon", QString::number((minLonM10 + 1) / 10., 'f'));
-  query.bindValue(":minLon", QString::number(minLonM10 / 10., 'f'));
-  query.bindValue(":categoryID", categoryID);
-  query.exec();
   while (query.next()) {
+    const qreal minLon = query.value(eSqlColumnPoiMinLon).toDouble();
+    const qreal maxLon = query.value(eSqlColumnPoiMaxLon).toDouble();
+    const qreal minLat = query.value(eSqlColumnPoiMinLat).toDouble();
+    const qreal maxLat = query.value(eSqlColumnPoiMaxLat).toDouble();
+    int minLonM10, minLatM10;
+    if (!cellOf(minLon, maxLon, minLonM10) || !cellOf(minLat, maxLat, minLatM10)) {
+      continue;
+    }
+
+    quint64 categoryID = query.value(eSqlColumnPoiCategory).toUInt();
+    const cell_key_t cellKey = {categoryID, minLonM10, minLatM10};
+    if (!missingCells.contains(cellKey)) {
+      // the cell has been loaded before
+      continue;
+    }
+
     quint64 key = query.value(eSqlColumnPoiId).toUInt();
-    const QStringList& data = query.value(eSqlColumnPoiData).toString().split("\r");
-    QString garminIcon;
-    for (const QString& tag : data) {
-      if (tagMap.contains(tag)) {
-        garminIcon = tagMap[tag].getGarminSym();
-        break;
-      }
+    poi_t& item = loadedPois[key];
+    if (item.refCount == 0) {
+      item.lon = qRound((maxLon + minLon) / 2 * 1e7);
+      item.lat = qRound((maxLat + minLat) / 2 * 1e7);
+      item.data = query.value(eSqlColumnPoiData).toString().split("\r");
+      item.bytes = sizeof(quint64) + sizeof(poi_t) + item.data.count() * sizeof(QString);
+      loadedCells.addBytes(item.bytes + internTags(item.data));
     }
-    loadedPoisByArea[categoryID][minLonM10][minLatM10].append(key);
     // TODO: this overwrites a POI if it already was loaded. The difference between those will be the category. Some
     // better handling should be done
-    loadedPois[key] = CPoiItemPOI(
-        data,
-        QPointF((query.value(eSqlColumnPoiMaxLon).toDouble() + query.value(eSqlColumnPoiMinLon).toDouble()) / 2 *
-                    DEG_TO_RAD,
-                (query.value(eSqlColumnPoiMaxLat).toDouble() + query.value(eSqlColumnPoiMinLat).toDouble()) / 2 *
-                    DEG_TO_RAD),
-        key, categoryNames[categoryID], garminIcon);
-  }
-  // Close database, as this method is called from mutiple threads.
-  QSqlDatabase::removeDatabase(filename);
+    item.categoryID = categoryID;
+    item.refCount++;
+
+    loadedCells.value(cellKey)->pois.append(key);
+    loadedCells.addBytes(sizeof(quint64));
+  }
+  query.finish();
+}
+
+void CPoiFilePOI::configureCache() {
+  QMutexLocker lock(&mutex);
+  loadedCells.setMaxBytes(qint64(getCacheSize()) * 1024 * 1024);
+}
+
+CPoiFilePOI::cache_stats_t CPoiFilePOI::getCacheStats() const {
+  QMutexLocker lock(&mutex);
+  const CLruCache<cell_key_t, cell_t>::stats_t& stats = loadedCells.getStats();
+
+  cache_stats_t cacheStats;
+  cacheStats.cells = stats.entries;
+  cacheStats.pois = loadedPois.count();
+  cacheStats.tags = internedTags.count();
+  cacheStats.evictions = stats.evictions;
+  cacheStats.bytes = stats.bytes;
+  return cacheStats;
+}
+
+QString CPoiFilePOI::getCacheInfo() const {
+  const cache_stats_t& cacheStats = getCacheStats();
+  return tr("%1 POIs in %2 cells, %3 MB, %4 cells removed")
+      .arg(cacheStats.pois)
+      .arg(cacheStats.cells)
+      .arg(cacheStats.bytes / (1024.0 * 1024.0), 0, 'f', 1)
+      .arg(cacheStats.evictions);
+}
+
+CPoiItemPOI CPoiFilePOI::getPoi(quint64 key) const {
+  const poi_t& item = loadedPois.value(key);
+  QString garminIcon;
+  for (const QString& tag : item.data) {
+    if (tagMap.contains(tag)) {
+      garminIcon = tagMap[tag].getGarminSym();
+      break;
+    }
+  }
+  return CPoiItemPOI(item.data, getCoordinates(item), key, categoryNames.value(item.categoryID), garminIcon);
+}
+
+QPointF CPoiFilePOI::getCoordinates(const poi_t& item) const {
+  return QPointF(item.lon * 1e-7 * DEG_TO_RAD, item.lat * 1e-7 * DEG_TO_RAD);
+}
+
+const QVector<quint64>& CPoiFilePOI::getPoisInCell(const cell_key_t& key) const {
+  static const QVector<quint64> noPois;
+  const cell_t* cell = loadedCells.value(key);
+  return cell != nullptr ? cell->pois : noPois;
+}
+
+void CPoiFilePOI::releaseCell(const cell_t& cell) {
+  qint64 bytes = cell.pois.count() * sizeof(quint64);
+  for (quint64 key : cell.pois) {
+    auto item = loadedPois.find(key);
+    if (--item->refCount == 0) {
+      bytes += item->bytes + releaseTags(item->data);
+      loadedPois.erase(item);
+    }
+  }
+  loadedCells.addBytes(-bytes);
+}
+
+qint64 CPoiFilePOI::internTags(QStringList& tags) {
+  qint64 bytes = 0;
+  for (QString& tag : tags) {
+    auto interned = internedTags.find(tag);
+    if (interned == internedTags.end()) {
+      interned = internedTags.insert(tag, 0);
+      bytes += tagSize(tag);
+    }
+    tag = interned.key();
+    ++interned.value();
+  }
+  return bytes;
+}
+
+qint64 CPoiFilePOI::releaseTags(const QStringList& tags) {
+  qint64 bytes = 0;
+  for (const QString& tag : tags) {
+    auto interned = internedTags.find(tag);
+    if (--interned.value() == 0) {
+      bytes += tagSize(interned.key());
+      internedTags.erase(interned);
+    }
+  }
+  return bytes;
 }
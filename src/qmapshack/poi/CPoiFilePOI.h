@@ -21,9 +21,14 @@
 #define CPOIFILEPOI_H
 
 #include <QCoreApplication>
+#include <QHash>
 #include <QMutex>
+#include <QPolygonF>
+#include <QSqlQuery>
 #include <QTimer>
+#include <QVector>
 
+#include "helpers/CLruCache.h"
 #include "poi/CPoiIconCategory.h"
 #include "poi/CPoiItemPOI.h"
 #include "poi/IPoiFile.h"
@@ -31,13 +36,33 @@
 class CPoiFilePOI : public IPoiFile {
   Q_DECLARE_TR_FUNCTIONS(CPoiFilePOI)
  public:
+  struct cache_stats_t {
+    qint32 cells = 0;       //< number of loaded cells, including empty ones
+    qint32 pois = 0;        //< number of loaded POIs
+    qint32 tags = 0;        //< number of distinct tags of the loaded POIs
+    quint64 evictions = 0;  //< number of cells removed to stay within the size limit
+    qint64 bytes = 0;       //< estimated size of all loaded cells, POIs and tags
+  };
+
   CPoiFilePOI(const QString& filename, CPoiDraw* parent);
-  virtual ~CPoiFilePOI() = default;
+  virtual ~CPoiFilePOI();
 
   void addTreeWidgetItems(QTreeWidget* widget) override;
-  // category, minLon multiplied by 10, minLat multiplied by 10. POIs are loaded in squares of degrees (should be fine
-  // enough to not hang the system)
-  void loadPOIsFromFile(quint64 categoryID, int minLonM10, int minLatM10);
+  /**
+     @brief Load all cells not loaded yet for the given categories with a single query
+
+     POIs are loaded in squares of 0.1 degrees. Cells without any POIs are
+     registered as loaded, too. Thus they are not queried again.
+
+     @param categoryIDs   the categories to load
+     @param cellsM10      the cells to load, as minLon and minLat multiplied by 10
+     @param isView        true if the cells are the ones of the view to draw. Only then the
+                          cells of the previous view are released to be removed from the cache.
+   */
+  void loadPOIsFromFile(const QList<quint64>& categoryIDs, const QRect& cellsM10, bool isView);
+
+  cache_stats_t getCacheStats() const;
+  QString getCacheInfo() const override;
 
   void draw(IDrawContext::buffer_t& buf) override;
 
@@ -54,6 +79,16 @@ class CPoiFilePOI : public IPoiFile {
  public slots:
   void slotCheckedStateChanged(QTreeWidgetItem* item) override;
 
+ protected:
+  /**
+     @brief Apply the cache size as memory limit for loaded POIs
+
+     If the estimated size of all loaded cells exceeds the limit the least
+     recently used cells are removed. Cells needed for the current view are
+     never removed.
+   */
+  void configureCache() override;
+
  private:
   struct poiGroup_t {
     /// Area covered by the icon in pixels
@@ -63,32 +98,134 @@ class CPoiFilePOI : public IPoiFile {
     QSet<quint64> pois;
   };
 
+  /// A screen space grid of the displayed POI groups to find groups without scanning all of them
+  struct poiGrid_t {
+    void clear(const QSizeF& size);
+    void insert(const QPointF& pt, qint32 idx);
+    /**
+       @brief Find the group with the lowest index passing a test
+
+       @param area  the area the centers of the groups to test can be in
+       @param test  a functor taking the group's index and returning true if it matches
+       @return The group's index or -1 if there is none.
+     */
+    template <typename F>
+    qint32 findFirst(const QRectF& area, F test) const;
+
+    /// the size of a cell in pixels
+    QSizeF cellSize;
+    /// group indices per cell, in ascending order
+    QHash<quint64, QVector<qint32> > cells;
+  };
+
+  /// The state the POI groups have been created for
+  struct cluster_t {
+    bool isValid = false;
+    QRect cellsM10;
+    QList<quint64> categoryIDs;
+    QSize iconSize;
+    /// the corners of the buffer in rad and their pixel coordinates to detect a pure move of the map
+    QPolygonF refRad;
+    QPolygonF refPx;
+  };
+
   enum SqlColumnPoi_e {
     eSqlColumnPoiMaxLat,
     eSqlColumnPoiMaxLon,
     eSqlColumnPoiMinLat,
     eSqlColumnPoiMinLon,
     eSqlColumnPoiData,
-    eSqlColumnPoiId
+    eSqlColumnPoiId,
+    eSqlColumnPoiCategory
   };
   enum SqlColumnCategory_e { eSqlColumnCategoryId, eSqlColumnCategoryName, eSqlColumnCategoryParent };
 
   void getPoiIcon(QPixmap& icon, const poiGroup_t& poiGroup);
-  void getPoiIcon(QPixmap& icon, const CPoiItemPOI& poi, const QString& definingTag = "");
+  void getPoiIcon(QPixmap& icon, const QStringList& rawData, const QString& definingTag = "");
   bool overlapsWithIcon(const QRectF& rect) const;
   bool getPoiGroupCloseBy(const QPoint& px, poiGroup_t& poiItem) const;
+  void clusterPois(const QList<quint64>& categoryIDs, const QRect& cellsM10, const QPolygonF& refRad);
+  bool isClusterMoved(const QList<quint64>& categoryIDs, const QRect& cellsM10, QPointF& offset) const;
+  void buildPoiGrid();
+
+  /// key of a loaded cell of a category
+  struct cell_key_t {
+    quint64 categoryID;
+    qint32 lonM10;  //< minLon multiplied by 10
+    qint32 latM10;  //< minLat multiplied by 10
+
+    bool operator==(const cell_key_t& other) const {
+      return (categoryID == other.categoryID) && (lonM10 == other.lonM10) && (latM10 == other.latM10);
+    }
+  };
+
+  friend inline uint qHash(const cell_key_t& key, uint seed = 0) {
+    return qHash(key.categoryID, seed) ^ qHash((quint64(quint32(key.lonM10)) << 32) | quint32(key.latM10), seed);
+  }
+
+  /// the POIs of a cell of 0.1° x 0.1°
+  struct cell_t {
+    QVector<quint64> pois;
+    /// value of cacheStamp when the cell has been used the last time
+    quint64 lastUsed = 0;
+  };
+
+  /// A loaded POI. The full CPoiItemPOI is created on demand by getPoi().
+  struct poi_t {
+    qint32 lon = 0;          //< center longitude in 1e-7 degree
+    qint32 lat = 0;          //< center latitude in 1e-7 degree
+    quint32 refCount = 0;    //< number of cells referencing the POI
+    qint32 bytes = 0;        //< estimated size of the POI
+    quint64 categoryID = 0;  //< category the POI has been loaded for last
+    QStringList data;        //< raw tags, the strings are shared with other POIs
+  };
+
+  CPoiItemPOI getPoi(quint64 key) const;
+  QPointF getCoordinates(const poi_t& item) const;
+  const QVector<quint64>& getPoisInCell(const cell_key_t& key) const;
+  /// drop the references of an evicted cell to it's POIs
+  void releaseCell(const cell_t& cell);
+  /// share equal tags with the other loaded POIs and return the size of the tags not known yet
+  qint64 internTags(QStringList& tags);
+  /// drop the references of an unloaded POI to it's tags and return the size of the tags not used anymore
+  qint64 releaseTags(const QStringList& tags);
+
+  /// A database connection owned by a single thread
+  struct connection_t {
+    QString name;
+    /// prepared range queries, the key is the number of categories
+    QMap<int, QSqlQuery> queries;
+  };
+
+  connection_t* getConnection();
+  /// remove the database connection of a destroyed thread
+  void removeConnection(QThread* thread);
+  QSqlQuery& getRangeQuery(connection_t& connection, int nCategories);
 
   mutable QRecursiveMutex mutex;
   QString filename;
+  /// A database connection can only be used by the thread that created it.
+  /// Thus each thread gets its own connection which is kept open until the
+  /// thread object is destroyed or the file is closed. The draw thread is the
+  /// parent of the file, thus its connection and prepared queries live as long as the file.
+  QMap<QThread*, connection_t> connections;
+  /// the number of connections created so far, to give each a unique name
+  quint32 cntConnections = 0;
   QTimer* loadTimer;
 
   QMap<quint64, Qt::CheckState> categoryActivated;
   QMap<quint64, QString> categoryNames;
-  // category, minLon multiplied by 10, minLat multiplied by 10. POIs are loaded in squares of degrees (should be fine
-  // enough to not hang the system)
-  QMap<quint64, QMap<int, QMap<int, QList<quint64> > > > loadedPoisByArea;
-  QMap<quint64, CPoiItemPOI> loadedPois;
+  // POIs are loaded in squares of 0.1 degrees per category (should be fine enough to not hang the system)
+  // The size of the POIs and tags is accounted in this cache, too.
+  CLruCache<cell_key_t, cell_t> loadedCells;
+  /// incremented with each request to load the cells of a view
+  quint64 cacheStamp = 0;
+  QHash<quint64, poi_t> loadedPois;
+  /// all tags of the loaded POIs to share equal strings, with the number of references
+  QHash<QString, quint32> internedTags;
   QList<poiGroup_t> displayedPois;
+  poiGrid_t displayedPoisGrid;
+  cluster_t cluster;
   QRectF bbox;
 
   static QMap<QString, CPoiIconCategory> tagMap;
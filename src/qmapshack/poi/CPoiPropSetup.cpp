@@ -28,6 +28,10 @@ CPoiPropSetup::CPoiPropSetup(IPoiFile* poifile, CPoiDraw* poi) : IPoiProp(poifil
 
   connect(sliderOpacity, &QSlider::valueChanged, poifile, &IPoiFile::slotSetOpacity);
   connect(sliderOpacity, &QSlider::valueChanged, poi, &CPoiDraw::emitSigCanvasUpdate);
+  connect(spinCacheSize, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), poifile,
+          &IPoiFile::slotSetCacheSize);
+  // the cache changes with each draw
+  connect(poi, &CPoiDraw::sigStopThread, this, &CPoiPropSetup::slotUpdateCacheInfo);
 
   poifile->addTreeWidgetItems(treeWidgetCategories);
   treeWidgetCategories->sortItems(eTreeColumnDisplayName, Qt::SortOrder::AscendingOrder);
@@ -38,7 +42,15 @@ CPoiPropSetup::CPoiPropSetup(IPoiFile* poifile, CPoiDraw* poi) : IPoiProp(poifil
 void CPoiPropSetup::slotPropertiesChanged() {
   X______________BlockAllSignals______________X(this);
   sliderOpacity->setValue(poifile->getOpacity());
+  spinCacheSize->setValue(poifile->getCacheSize());
+  slotUpdateCacheInfo();
 
   poi->emitSigCanvasUpdate();
   X_____________UnBlockAllSignals_____________X(this);
 }
+
+void CPoiPropSetup::slotUpdateCacheInfo() {
+  const QString& info = poifile->getCacheInfo();
+  labelCacheInfo->setText(info);
+  labelCacheInfo->setVisible(!info.isEmpty());
+}
@@ -35,6 +35,7 @@ class CPoiPropSetup : public IPoiProp, private Ui::IPoiPropSetup {
 
  protected slots:
   void slotPropertiesChanged() override;
+  void slotUpdateCacheInfo();
 
  private:
 };
@@ -18,6 +18,8 @@
 
 #include "poi/IPoiFile.h"
 
+#include <QSettings>
+
 #include "poi/CPoiDraw.h"
 #include "poi/CPoiPropSetup.h"
 
@@ -40,6 +42,18 @@ IPoiFile::IPoiFile(CPoiDraw* parent)
 
 {}
 
+void IPoiFile::saveConfig(QSettings& cfg) /* override */
+{
+  IDrawObject::saveConfig(cfg);
+  cfg.setValue("cacheSizeMB", cacheSizeMB);
+}
+
+void IPoiFile::loadConfig(QSettings& cfg) /* override */
+{
+  IDrawObject::loadConfig(cfg);
+  slotSetCacheSize(cfg.value("cacheSizeMB", getCacheSize()).toInt());
+}
+
 IPoiProp* IPoiFile::getSetup() {
   if (setup.isNull()) {
     setup = new CPoiPropSetup(this, poi);
@@ -35,6 +35,10 @@ class IPoiFile : public IDrawObject {
 
   virtual void draw(IDrawContext::buffer_t& buf) = 0;
 
+  void saveConfig(QSettings& cfg) override;
+
+  void loadConfig(QSettings& cfg) override;
+
   /**
      @brief Get the POI collection's setup widget.
 
@@ -57,6 +61,14 @@ class IPoiFile : public IDrawObject {
   virtual void findPoisIn(const QRectF& degRect, QSet<IPoiItem>& pois, QList<QPointF>& posPoiHighlight) = 0;
   virtual bool getToolTip(const QPoint& px, QString& str) const = 0;
 
+  qint32 getCacheSize() const { return cacheSizeMB; }
+
+  /**
+     @brief Get a short summary of the POI cache to be shown in the setup widget
+     @return The summary or an empty string if the POI collection has no cache.
+   */
+  virtual QString getCacheInfo() const { return QString(); }
+
   static void init();
   static const QSize& iconSize() { return _iconSize; }
   static const QImage& iconHighlight() { return _iconHighlight; }
@@ -64,6 +76,11 @@ class IPoiFile : public IDrawObject {
  public slots:
   virtual void slotCheckedStateChanged(QTreeWidgetItem* item) = 0;
 
+  void slotSetCacheSize(qint32 size) {
+    cacheSizeMB = size;
+    configureCache();
+  }
+
  protected:
   CPoiDraw* poi;
 
@@ -75,6 +92,8 @@ class IPoiFile : public IDrawObject {
   /// the setup dialog. Use getSetup() for access
   QPointer<IPoiProp> setup;
 
+  qint32 cacheSizeMB = 64;  //< maximum size of the POIs kept in memory [MByte]
+
  private:
   static QSize _iconSize;
   static QImage _iconHighlight;
@@ -100,7 +100,7 @@ bool IRtRecord::readEntry(QByteArray& data) {
 
   CTrackData::trkpt_t trkpt;
   stream >> trkpt;
-  track << trkpt;
+  track.append(trkpt);
   return true;
 }
 
@@ -110,9 +110,10 @@ void IRtRecord::reset() {
 }
 
 void IRtRecord::draw(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw* rt) {
-  QPolygonF tmp;
-  for (const CTrackData::trkpt_t& trkpt : qAsConst(track)) {
-    tmp << QPointF(trkpt.lon * DEG_TO_RAD, trkpt.lat * DEG_TO_RAD);
+  const int N = track.size();
+  QPolygonF tmp(N);
+  for (int n = 0; n < N; n++) {
+    tmp[n] = QPointF(track.lon[n] * DEG_TO_RAD, track.lat[n] * DEG_TO_RAD);
   }
 
   rt->convertRad2Px(tmp);
@@ -23,7 +23,7 @@
 #include <QFile>
 #include <QObject>
 
-#include "gis/trk/CTrackData.h"
+#include "gis/trk/CTrackColumns.h"
 
 class CRtDraw;
 class QPainter;
@@ -63,7 +63,7 @@ class IRtRecord : public QObject {
    */
   virtual void draw(QPainter& p, const QPolygonF& viewport, QList<QRectF>& blockedAreas, CRtDraw* rt);
 
-  virtual const QVector<CTrackData::trkpt_t>& getTrack() const { return track; }
+  virtual const CTrackColumns& getTrack() const { return track; }
 
  protected:
   /**
@@ -91,7 +91,7 @@ class IRtRecord : public QObject {
   virtual bool readEntry(QByteArray& data);
 
  protected:
-  QVector<CTrackData::trkpt_t> track;
+  CTrackColumns track;
 
  private:
   /**
@@ -531,8 +531,6 @@ void CRtAisInfo::startRecord(const QString& filename) {
 }
 
 void CRtAisInfo::fillTrackData(CTrackData& data) {
-  CTrackData::trkseg_t seg;
-  seg.pts = record->getTrack();
-  data.segs << seg;
+  record->getTrack().toTrackData(data);
   data.name = lineKey->text();
 }
@@ -36,7 +36,7 @@ bool CRtAisRecord::writeEntry(const CRtAis::ship_t& ship) {
   trkpt.time = QDateTime::fromTime_t(ship.timePosition);
 
   stream << trkpt;
-  track << trkpt;
+  track.append(trkpt);
 
   return writeEntry(data);
 }
@@ -400,8 +400,6 @@ void CRtGpsTetherInfo::startRecord(const QString& filename) {
 }
 
 void CRtGpsTetherInfo::fillTrackData(CTrackData& data) {
-  CTrackData::trkseg_t seg;
-  seg.pts = record->getTrack();
-  data.segs << seg;
+  record->getTrack().toTrackData(data);
   data.name = lineHost->text();
 }
@@ -40,7 +40,7 @@ bool CRtGpsTetherRecord::writeEntry(qreal lon, qreal lat, qreal ele, qreal speed
   }
 
   stream << trkpt;
-  track << trkpt;
+  track.append(trkpt);
 
   return writeEntry(data);
 }
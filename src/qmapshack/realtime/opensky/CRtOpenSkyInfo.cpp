@@ -88,8 +88,6 @@ void CRtOpenSkyInfo::startRecord(const QString& filename) {
 }
 
 void CRtOpenSkyInfo::fillTrackData(CTrackData& data) {
-  CTrackData::trkseg_t seg;
-  seg.pts = record->getTrack();
-  data.segs << seg;
+  record->getTrack().toTrackData(data);
   data.name = lineKey->text();
 }
@@ -36,7 +36,7 @@ bool CRtOpenSkyRecord::writeEntry(const CRtOpenSky::aircraft_t& aircraft) {
   trkpt.time = QDateTime::fromTime_t(aircraft.timePosition);
 
   stream << trkpt;
-  track << trkpt;
+  track.append(trkpt);
 
   return writeEntry(data);
 }
@@ -0,0 +1,87 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+
+#include "test_QMapShack.h"
+
+#include "helpers/CBinaryDelta.h"
+
+void test_QMapShack::applyBinaryDelta(const QByteArray& from, const QByteArray& to)
+{
+    const QByteArray& delta = CBinaryDelta::create(from, to);
+    SUBVERIFY(!delta.isEmpty(), "Delta must never be empty");
+
+    QByteArray result;
+    SUBVERIFY(CBinaryDelta::apply(from, delta, result), "Failed to apply delta");
+    SUBVERIFY(result == to, QString("Result differs from target (%1 -> %2 bytes)").arg(from.size()).arg(to.size()));
+}
+
+void test_QMapShack::_applyBinaryDelta()
+{
+    QRandomGenerator rnd(42);
+    auto random = [&rnd](qint32 size)
+    {
+        QByteArray data(size, 0);
+        for(qint32 i = 0; i < size; i++)
+        {
+            data[i] = char(rnd.bounded(256));
+        }
+        return data;
+    };
+
+    const QByteArray& base = random(10000);
+
+    applyBinaryDelta(QByteArray(), QByteArray());
+    applyBinaryDelta(QByteArray(), base);
+    applyBinaryDelta(base, QByteArray());
+    applyBinaryDelta(base, base);
+
+    for(qint32 n = 0; n < 200; n++)
+    {
+        QByteArray to = base;
+        switch(n % 3)
+        {
+        case 0:
+            // overwrite a few scattered bytes
+            for(qint32 i = 0; i < 1 + (n % 10); i++)
+            {
+                to[rnd.bounded(to.size())] = char(rnd.bounded(256));
+            }
+            break;
+
+        case 1:
+            to.insert(rnd.bounded(to.size() + 1), random(rnd.bounded(1, 100)));
+            break;
+
+        case 2:
+            to.remove(rnd.bounded(to.size()), rnd.bounded(1, 100));
+            break;
+        }
+        applyBinaryDelta(base, to);
+    }
+
+    // a local change must result in a small delta
+    QByteArray to = base;
+    to[5000] = char(~to[5000]);
+    const QByteArray& delta = CBinaryDelta::create(base, to);
+    SUBVERIFY(delta.size() < 32, QString("Delta too large for a single byte change: %1 bytes").arg(delta.size()));
+
+    // a delta must not apply to data of a different size
+    QByteArray result;
+    SUBVERIFY(!CBinaryDelta::apply(base.left(4000), delta, result), "Delta applied to wrong data");
+}
@@ -23,6 +23,8 @@
 
 #include "gis/prj/IGisProject.h"
 #include "gis/fit/CFitProject.h"
+#include "gis/fit/decoder/CFitDecoder.h"
+#include "gis/fit/defs/fit_enums.h"
 
 void test_QMapShack::_readValidFitFiles()
 {
@@ -31,3 +33,67 @@ void test_QMapShack::_readValidFitFiles()
     delete readProjFile("2016-03-12_15-16-50_4_20.fit");
 }
 
+void test_QMapShack::_decodeFitRecords()
+{
+    QFile file(fileToPath("2015-05-07-22-03-17.fit"));
+    SUBVERIFY(file.open(QIODevice::ReadOnly), "Failed to open FIT file");
+
+    CFitDecoder decoder;
+    decoder.decode(file);
+
+    // record messages are in order and refer to their row in the record columns
+    const CFitRecordColumns& records = decoder.getRecords();
+    qint32 row = 0;
+    for(const CFitMessage& mesg : decoder.getMessages())
+    {
+        if(mesg.getGlobalMesgNr() == eMesgNumRecord)
+        {
+            SUBVERIFY(mesg.getRecordIndex() == row++, "Wrong record index");
+        }
+        else
+        {
+            SUBVERIFY(mesg.getRecordIndex() == fitRecordIndexInvalid, "Record index for a message other than a record");
+        }
+    }
+    VERIFY_EQUAL(records.size(), row);
+
+    qint32 positions = 0;
+    for(row = 0; row < records.size(); row++)
+    {
+        positions += records.isPositionValid(row) ? 1 : 0;
+    }
+    VERIFY_EQUAL(2341, positions);
+    VERIFY_EQUAL(601945982, records.positionLat[0]);
+    SUBVERIFY(qAbs(records.value(CFitRecordColumns::eColumnEnhancedAltitude, 0) - 23.4) < 0.001, "Wrong altitude");
+    SUBVERIFY(!qIsNaN(records.value(CFitRecordColumns::eColumnTemperature, 0)), "Missing temperature");
+    SUBVERIFY(qIsNaN(records.value(CFitRecordColumns::eColumnHeartRate, 0)), "Unexpected heart rate");
+
+    // a single flipped bit has to be detected
+    file.seek(0);
+    QByteArray data = file.readAll();
+    data[data.size() / 2] = data[data.size() / 2] ^ 0x01;
+    bool failed = false;
+    try
+    {
+        decoder.decode((const quint8*)data.constData(), data.size(), file.fileName());
+    }
+    catch(const QString&)
+    {
+        failed = true;
+    }
+    SUBVERIFY(failed, "Corrupted file decoded without error");
+}
+
+void test_QMapShack::benchDecodeFit()
+{
+    QFile file(fileToPath("2015-05-07-22-03-17.fit"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray& data = file.readAll();
+
+    CFitDecoder decoder;
+    QBENCHMARK
+    {
+        decoder.decode((const quint8*)data.constData(), data.size(), file.fileName());
+    }
+    QCOMPARE(decoder.getRecords().size() > 0, true);
+}
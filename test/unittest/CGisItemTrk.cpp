@@ -54,3 +54,260 @@ void test_QMapShack::_filterDeleteExtension()
     }
 }
 
+
+struct derivedTrk_t
+{
+    qint32 cntVisible;
+    qint32 cntInvalid;
+    quint32 validFlags;
+    qreal distance;
+    qreal ascent;
+    qreal descent;
+    quint32 elapsed;
+    quint32 elapsedMoving;
+    QRectF boundingRect;
+    QStringList sources;
+    QList<qreal> mins;
+    QList<qreal> maxs;
+    QVector<CTrackData::trkpt_t> pts;
+};
+
+static derivedTrk_t readDerivedData(const CGisItemTrk &trk)
+{
+    derivedTrk_t data;
+    data.cntVisible = trk.getNumberOfVisiblePoints();
+    data.cntInvalid = trk.getNumberOfInvalidPoints();
+    data.validFlags = trk.getAllValidFlags();
+    data.distance = trk.getTotalDistance();
+    data.ascent = trk.getTotalAscent();
+    data.descent = trk.getTotalDescent();
+    data.elapsed = trk.getTotalElapsedSeconds();
+    data.elapsedMoving = trk.getTotalElapsedSecondsMoving();
+    data.boundingRect = trk.getBoundingRect();
+
+    data.sources = trk.getExistingDataSources();
+    data.sources.sort();
+    for(const QString &source : data.sources)
+    {
+        data.mins << trk.getMin(source);
+        data.maxs << trk.getMax(source);
+    }
+
+    for(const CTrackData::trkpt_t &pt : trk.getTrackData())
+    {
+        data.pts << pt;
+    }
+    return data;
+}
+
+static bool isAlmostEqual(qreal a, qreal b)
+{
+    return qAbs(a - b) <= 1e-6 * qMax(qreal(1), qAbs(a));
+}
+
+static void compareDerivedData(const derivedTrk_t &data, const derivedTrk_t &exp, const QString &name)
+{
+    SUBVERIFY(data.cntVisible == exp.cntVisible, name + ": visible points differ");
+    SUBVERIFY(data.cntInvalid == exp.cntInvalid, name + ": invalid points differ");
+    SUBVERIFY(data.validFlags == exp.validFlags, name + ": valid flags differ");
+    SUBVERIFY(isAlmostEqual(data.distance, exp.distance), name + ": distance differs");
+    SUBVERIFY(data.ascent == exp.ascent, name + ": ascent differs");
+    SUBVERIFY(data.descent == exp.descent, name + ": descent differs");
+    SUBVERIFY(data.elapsed == exp.elapsed, name + ": elapsed time differs");
+    SUBVERIFY(data.elapsedMoving == exp.elapsedMoving, name + ": moving time differs");
+    SUBVERIFY(data.boundingRect == exp.boundingRect, name + ": bounding rectangle differs");
+
+    SUBVERIFY(data.sources == exp.sources, name + ": data sources differ");
+    for(int i = 0; i < exp.sources.size(); i++)
+    {
+        SUBVERIFY(isAlmostEqual(data.mins[i], exp.mins[i]), name + ": minimum of " + exp.sources[i] + " differs");
+        SUBVERIFY(isAlmostEqual(data.maxs[i], exp.maxs[i]), name + ": maximum of " + exp.sources[i] + " differs");
+    }
+
+    SUBVERIFY(data.pts.size() == exp.pts.size(), name + ": number of points differs");
+    for(int i = 0; i < exp.pts.size(); i++)
+    {
+        const CTrackData::trkpt_t &pt = data.pts[i];
+        const CTrackData::trkpt_t &expPt = exp.pts[i];
+        const QString &msg = name + QString(": point %1 differs").arg(i);
+
+        SUBVERIFY(pt.idxVisible == expPt.idxVisible, msg);
+        SUBVERIFY(pt.valid == expPt.valid, msg);
+        SUBVERIFY(isAlmostEqual(pt.deltaDistance, expPt.deltaDistance), msg);
+        SUBVERIFY(isAlmostEqual(pt.distance, expPt.distance), msg);
+        SUBVERIFY(pt.ascent == expPt.ascent, msg);
+        SUBVERIFY(pt.descent == expPt.descent, msg);
+        SUBVERIFY(isAlmostEqual(pt.elapsedSeconds, expPt.elapsedSeconds), msg);
+        SUBVERIFY(isAlmostEqual(pt.elapsedSecondsMoving, expPt.elapsedSecondsMoving), msg);
+        SUBVERIFY(isAlmostEqual(pt.slope1, expPt.slope1), msg);
+        SUBVERIFY(isAlmostEqual(pt.speed, expPt.speed), msg);
+    }
+}
+
+void test_QMapShack::deriveSecondaryDataLocal(CGisItemTrk &trk, qint32 offset)
+{
+    const qint32 N = trk.getCntTotalPoints();
+
+    // the first change builds the derive state, the following ones update it
+    for(qint32 idx : {0, N / 2, N - 1, N / 2 + 1, N / 3})
+    {
+        const CTrackData::trkpt_t *pt = trk.getTrackData().getTrkPtByTotalIndex(idx);
+        trk.setElevation(idx, (pt->ele == NOINT) ? 100 : pt->ele + offset);
+    }
+
+    const derivedTrk_t &data = readDerivedData(trk);
+
+    // a full derivation on the same track data
+    trk.filterOffsetElevation(0);
+    compareDerivedData(data, readDerivedData(trk), trk.getName() + QString(" offset %1").arg(offset));
+}
+
+void test_QMapShack::_deriveSecondaryDataLocal()
+{
+    for(const QString &file : inputFiles)
+    {
+        IGisProject *proj = readProjFile(file);
+
+        for(int i = 0; i < proj->childCount(); i++)
+        {
+            CGisItemTrk *trk = dynamic_cast<CGisItemTrk*>(proj->child(i));
+            if((nullptr != trk) && (trk->getCntTotalPoints() > 0))
+            {
+                for(qint32 offset : {37, -120, 3, 500})
+                {
+                    deriveSecondaryDataLocal(*trk, offset);
+                }
+            }
+        }
+
+        delete proj;
+    }
+}
+
+void test_QMapShack::_moveTrackPoints()
+{
+    for(const QString &file : inputFiles)
+    {
+        IGisProject *proj = readProjFile(file);
+
+        for(int i = 0; i < proj->childCount(); i++)
+        {
+            CGisItemTrk *trk = dynamic_cast<CGisItemTrk*>(proj->child(i));
+            if((nullptr == trk) || (trk->getNumberOfVisiblePoints() < 3))
+            {
+                continue;
+            }
+
+            // the first edit replaces all data by a plain line, the following ones move points in place
+            SGisLine line;
+            trk->getPolylineFromData(line);
+            trk->setDataFromPolyline(line);
+
+            const qint32 N = line.size();
+            for(qint32 idx : {0, N / 2, N - 1, N / 2 + 1, N / 3})
+            {
+                line[idx].coord += QPointF(0.00001, -0.00002);
+                line[idx].ele = 100 + idx;
+                trk->setDataFromPolyline(line);
+            }
+
+            // subpoints are stored as points following their point
+            QVector<const IGisLine::subpt_t*> expPts;
+            for(const IGisLine::point_t &pt : line)
+            {
+                expPts << &pt;
+                for(const IGisLine::subpt_t &sub : pt.subpts)
+                {
+                    expPts << &sub;
+                }
+            }
+
+            const QString &name = trk->getName() + " moved points";
+            SUBVERIFY(trk->getCntTotalPoints() == expPts.size(), name + ": number of points differs");
+            qint32 idx = 0;
+            for(const CTrackData::trkpt_t &pt : trk->getTrackData())
+            {
+                const IGisLine::subpt_t &expPt = *expPts[idx];
+                const QString &msg = name + QString(": point %1 differs").arg(idx++);
+                SUBVERIFY(isAlmostEqual(pt.lon * DEG_TO_RAD, expPt.coord.x()), msg);
+                SUBVERIFY(isAlmostEqual(pt.lat * DEG_TO_RAD, expPt.coord.y()), msg);
+                SUBVERIFY(pt.ele == expPt.ele, msg);
+            }
+
+            const derivedTrk_t &data = readDerivedData(*trk);
+
+            // a full derivation on the same track data
+            trk->filterOffsetElevation(0);
+            compareDerivedData(data, readDerivedData(*trk), name);
+        }
+
+        delete proj;
+    }
+}
+
+void test_QMapShack::hideShowRange(CGisItemTrk &trk, qint32 idx1, qint32 idx2, bool hide)
+{
+    const QString &owner = "unittest";
+    SUBVERIFY(trk.setMouseRangeByTotalIndex(idx1, idx2, owner), "Failed to set range");
+    if(hide)
+    {
+        trk.hideSelectedPoints();
+    }
+    else
+    {
+        trk.showSelectedPoints();
+    }
+
+    const derivedTrk_t &data = readDerivedData(trk);
+
+    // a full derivation on a copy of the track data
+    const qint32 N = trk.getCntTotalPoints();
+    CGisItemTrk *copy = new CGisItemTrk("copy", 0, N - 1, trk.getTrackData(), trk.getParentProject());
+    const QString &name = trk.getName() + QString(hide ? " hide %1..%2" : " show %1..%2").arg(idx1).arg(idx2);
+    const derivedTrk_t &exp = readDerivedData(*copy);
+    delete copy;
+
+    compareDerivedData(data, exp, name);
+}
+
+void test_QMapShack::_hideShowPoints()
+{
+    for(const QString &file : inputFiles)
+    {
+        IGisProject *proj = readProjFile(file);
+
+        // the tracks are copied to get writable ones, thus collect the loaded ones first
+        QList<CGisItemTrk*> trks;
+        for(int i = 0; i < proj->childCount(); i++)
+        {
+            CGisItemTrk *trk = dynamic_cast<CGisItemTrk*>(proj->child(i));
+            if((nullptr != trk) && (trk->getNumberOfVisiblePoints() >= 5))
+            {
+                trks << trk;
+            }
+        }
+
+        for(CGisItemTrk *src : qAsConst(trks))
+        {
+            const qint32 N = src->getCntTotalPoints();
+            CGisItemTrk *trk = new CGisItemTrk(src->getName(), 0, N - 1, src->getTrackData(), proj);
+            SUBVERIFY(trk->setMode(CGisItemTrk::eModeRange, "unittest"), "Failed to enter range mode");
+
+            // a range in the middle, at the start, at the end, a single point and one overlapping a hidden range
+            hideShowRange(*trk, N / 4, N / 2, true);
+            hideShowRange(*trk, 0, N / 5, true);
+            hideShowRange(*trk, 2 * N / 3, N - 1, true);
+            hideShowRange(*trk, N / 2 + 2, N / 2 + 2, true);
+            hideShowRange(*trk, N / 3, 2 * N / 3 + 1, true);
+
+            // show some of the hidden points, then all of them
+            hideShowRange(*trk, N / 3, N / 2, false);
+            hideShowRange(*trk, 0, N / 4, false);
+            hideShowRange(*trk, 0, N - 1, false);
+
+            trk->setMode(CGisItemTrk::eModeNormal, "unittest");
+        }
+
+        delete proj;
+    }
+}
@@ -20,6 +20,7 @@
 #include "test_QMapShack.h"
 
 #include "gis/gpx/CGpxProject.h"
+#include "gis/trk/CGisItemTrk.h"
 
 void test_QMapShack::writeReadGpxFile(const QString &file)
 {
@@ -47,3 +48,93 @@ void test_QMapShack::_writeReadGpxFile()
     writeReadGpxFile("V1.6.0_file2.qms");
 }
 
+
+// Write a GPX file with a single track of n points. If truncated the end of the file is missing.
+static bool writeLargeGpxFile(const QString &filename, qint32 n, bool truncated)
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<gpx version=\"1.1\" creator=\"qttest\" xmlns=\"http://www.topografix.com/GPX/1/1\""
+        << " xmlns:gpxtpx=\"http://www.garmin.com/xmlschemas/TrackPointExtension/v1\">\n"
+        << "<trk><name>Large</name><trkseg>\n";
+
+    const QDateTime &start = QDateTime(QDate(2020, 1, 1), QTime(0, 0), Qt::UTC);
+    for(qint32 i = 0; i < n; i++)
+    {
+        out << QString("<trkpt lat=\"%1\" lon=\"%2\"><ele>%3</ele><time>%4</time><extensions>"
+                       "<gpxtpx:TrackPointExtension><gpxtpx:hr>%5</gpxtpx:hr></gpxtpx:TrackPointExtension>"
+                       "</extensions></trkpt>\n")
+            .arg(47 + (i % 1000) * 1e-4, 0, 'f', 8)
+            .arg(11 + (i / 1000) * 1e-4, 0, 'f', 8)
+            .arg(500 + (i % 200))
+            .arg(start.addSecs(i).toString(Qt::ISODate))
+            .arg(100 + (i % 60));
+    }
+
+    out << "</trkseg></trk>\n";
+    if(!truncated)
+    {
+        out << "</gpx>\n";
+    }
+
+    return out.status() == QTextStream::Ok;
+}
+
+void test_QMapShack::_readLargeGpxFile()
+{
+    const qint32 N = 100000;
+    QString tmpFile = TestHelper::getTempFileName("gpx");
+    SUBVERIFY(writeLargeGpxFile(tmpFile, N, true), "Failed to write " + tmpFile);
+
+    // The track is created as soon as the stream has passed it. Loading the file
+    // into a DOM first would fail on the missing end before any item is created.
+    CGpxProject *proj = new CGpxProject("a very random string to prevent loading via constructor", (CGisListWks*) nullptr);
+    proj->blockUpdateItems(true);
+    bool failed = false;
+    try
+    {
+        CGpxProject::loadGpx(tmpFile, proj);
+    }
+    catch(const QString &)
+    {
+        failed = true;
+    }
+    proj->blockUpdateItems(false);
+    QFile(tmpFile).remove();
+
+    SUBVERIFY(failed, "Truncated file loaded without error");
+    SUBVERIFY(proj->childCount() == 1, "Track has not been created while reading the file");
+
+    const CGisItemTrk *trk = dynamic_cast<CGisItemTrk*>(proj->child(0));
+    SUBVERIFY((nullptr != trk) && (trk->getCntTotalPoints() == N), "Track points are missing");
+
+    delete proj;
+}
+
+void test_QMapShack::benchLoadGpx()
+{
+    QString tmpFile = TestHelper::getTempFileName("gpx");
+    QVERIFY(writeLargeGpxFile(tmpFile, 100000, false));
+
+    qint32 cntPoints = 0;
+    QBENCHMARK
+    {
+        CGpxProject *proj = new CGpxProject("a very random string to prevent loading via constructor", (CGisListWks*) nullptr);
+        proj->blockUpdateItems(true);
+        CGpxProject::loadGpx(tmpFile, proj);
+        proj->blockUpdateItems(false);
+
+        const CGisItemTrk *trk = dynamic_cast<CGisItemTrk*>(proj->child(0));
+        cntPoints = (nullptr != trk) ? trk->getCntTotalPoints() : 0;
+        delete proj;
+    }
+    QFile(tmpFile).remove();
+
+    QCOMPARE(cntPoints, 100000);
+}
@@ -0,0 +1,78 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "test_QMapShack.h"
+
+#include "helpers/CMinMaxTree.h"
+
+void test_QMapShack::updateMinMaxTree(qint32 n)
+{
+    QRandomGenerator rnd(n);
+    // few distinct values to get many ties, a quarter of the entries empty
+    auto random = [&rnd](){ return rnd.bounded(4) == 0 ? NOFLOAT : qreal(rnd.bounded(20)); };
+
+    QVector<qreal> values;
+    for(qint32 i = 0; i < n; i++)
+    {
+        values << random();
+    }
+
+    CMinMaxTree tree;
+    tree.build(values);
+    SUBVERIFY(tree.size() == n, "Wrong number of values");
+
+    for(qint32 q = 0; q < 500; q++)
+    {
+        if(n > 0)
+        {
+            const qint32 idx = rnd.bounded(n);
+            values[idx] = random();
+            tree.set(idx, values[idx]);
+        }
+
+        // the first of all equal extrema is expected
+        qint32 idxMin = NOIDX;
+        qint32 idxMax = NOIDX;
+        for(qint32 i = 0; i < n; i++)
+        {
+            if(values[i] == NOFLOAT)
+            {
+                continue;
+            }
+            if((idxMin == NOIDX) || (values[i] < values[idxMin]))
+            {
+                idxMin = i;
+            }
+            if((idxMax == NOIDX) || (values[i] > values[idxMax]))
+            {
+                idxMax = i;
+            }
+        }
+
+        SUBVERIFY(tree.getIdxMin() == idxMin, QString("Minimum after %1 changes on %2 values differs").arg(q).arg(n));
+        SUBVERIFY(tree.getIdxMax() == idxMax, QString("Maximum after %1 changes on %2 values differs").arg(q).arg(n));
+    }
+}
+
+void test_QMapShack::_updateMinMaxTree()
+{
+    for(qint32 n : {0, 1, 2, 7, 8, 9, 1000})
+    {
+        updateMinMaxTree(n);
+    }
+}
@@ -0,0 +1,74 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "test_QMapShack.h"
+
+#include "helpers/CPackedRTree.h"
+
+static bool overlaps(const QRectF& r1, const QRectF& r2)
+{
+    const QRectF& a = r1.normalized();
+    const QRectF& b = r2.normalized();
+    return (a.left() <= b.right()) && (b.left() <= a.right()) && (a.top() <= b.bottom()) && (b.top() <= a.bottom());
+}
+
+void test_QMapShack::queryPackedRTree(qint32 n)
+{
+    QRandomGenerator rnd(n);
+    auto random = [&rnd](qreal min, qreal max){ return min + rnd.generateDouble() * (max - min); };
+
+    // a mix of boxes, lines, points and boxes with negative height
+    QVector<QRectF> rects;
+    for(qint32 i = 0; i < n; i++)
+    {
+        const qreal w = (i % 3) ? random(0, 1) : 0;
+        const qreal h = (i % 5) ? random(-1, 1) : 0;
+        rects << QRectF(random(-10, 10), random(-10, 10), w, h);
+    }
+
+    CPackedRTree tree;
+    tree.build(rects);
+    SUBVERIFY(tree.size() == n, "Wrong number of items");
+
+    for(qint32 q = 0; q < 200; q++)
+    {
+        const qreal size = (q % 4) ? random(-2, 2) : 0;
+        const QRectF area(random(-11, 11), random(-11, 11), size, size);
+
+        QVector<qint32> expected;
+        for(qint32 i = 0; i < n; i++)
+        {
+            if(overlaps(rects[i], area))
+            {
+                expected << i;
+            }
+        }
+
+        QVector<qint32> items;
+        tree.query(area, items);
+        SUBVERIFY(items == expected, QString("Query %1 on %2 items differs from linear search").arg(q).arg(n));
+    }
+}
+
+void test_QMapShack::_queryPackedRTree()
+{
+    for(qint32 n : {0, 1, 15, 16, 17, 256, 257, 10000})
+    {
+        queryPackedRTree(n);
+    }
+}
@@ -0,0 +1,165 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "test_QMapShack.h"
+
+#include "gis/proj_x.h"
+
+#define BENCH_VERTICES 1000000
+
+static const char* webMercator = "+proj=merc +a=6378137 +b=6378137 +lat_ts=0.0 +lon_0=0.0 +x_0=0.0 +y_0=0 +k=1.0 "
+                                 "+units=m +nadgrids=@null +wktext +no_defs";
+static const char* utm33 = "EPSG:32633";
+
+static QPolygonF createLine(int n)
+{
+    QPolygonF line(n);
+    for(int i = 0; i < n; i++)
+    {
+        line[i] = QPointF(12.0 + 4.0 * i / n, 47.0 + 6.0 * i / n) * DEG_TO_RAD;
+    }
+    return line;
+}
+
+void test_QMapShack::transformPolygon(const char* crs)
+{
+    CProj proj(crs, "EPSG:4326");
+    SUBVERIFY(proj.isValid(), QString("Failed to create projection for %1").arg(crs));
+
+    const QPolygonF& line = createLine(1000);
+
+    // bulk and point by point have to give the same result
+    QPolygonF bulk = line;
+    proj.transform(bulk, PJ_INV);
+
+    for(int i = 0; i < line.size(); i++)
+    {
+        QPointF pt = line[i];
+        proj.transform(pt, PJ_INV);
+        SUBVERIFY(qAbs(pt.x() - bulk[i].x()) < 1e-6 && qAbs(pt.y() - bulk[i].y()) < 1e-6,
+                  QString("Bulk and single transformation differ at %1").arg(i));
+    }
+
+    // and the way back
+    proj.transform(bulk, PJ_FWD);
+    for(int i = 0; i < line.size(); i++)
+    {
+        SUBVERIFY(qAbs(line[i].x() - bulk[i].x()) < 1e-9 && qAbs(line[i].y() - bulk[i].y()) < 1e-9,
+                  QString("Round trip failed at %1").arg(i));
+    }
+}
+
+void test_QMapShack::_transformPolygon()
+{
+    transformPolygon(webMercator);
+    transformPolygon(utm33);
+
+    // web mercator by formula has to match known values
+    CProj proj(webMercator, "EPSG:4326");
+    QPointF pt(13.4 * DEG_TO_RAD, 52.5 * DEG_TO_RAD);
+    proj.transform(pt, PJ_INV);
+    SUBVERIFY(qAbs(pt.x() - 1491681.18) < 0.01 && qAbs(pt.y() - 6891041.72) < 0.01, "Wrong web mercator coordinate");
+}
+
+void test_QMapShack::_copyProj()
+{
+    CProj proj(utm33, "EPSG:4326");
+    QPointF expected(13.4 * DEG_TO_RAD, 52.5 * DEG_TO_RAD);
+    proj.transform(expected, PJ_FWD);
+
+    // copies are independent objects with the same transformation
+    QMap<QString, CProj> projs;
+    projs["empty"] = CProj();
+    projs["copy"] = proj;
+    CProj copy(projs["copy"]);
+    CProj moved(std::move(projs["copy"]));
+
+    SUBVERIFY(!projs["empty"].isValid(), "A copy of an empty object must be invalid");
+    SUBVERIFY(!projs["copy"].isValid(), "A moved object must be invalid");
+    for(const CProj* p : {&copy, &moved})
+    {
+        QPointF pt(13.4 * DEG_TO_RAD, 52.5 * DEG_TO_RAD);
+        p->transform(pt, PJ_FWD);
+        SUBVERIFY(p->isValid() && pt == expected, "A copy transforms differently");
+    }
+
+    // threads finishing and new threads created after them
+    for(int i = 0; i < 4; i++)
+    {
+        QPointF pt(13.4 * DEG_TO_RAD, 52.5 * DEG_TO_RAD);
+        QThread* thread = QThread::create([&](){ copy.transform(pt, PJ_FWD); });
+        thread->start();
+        thread->wait();
+        delete thread;
+        SUBVERIFY(pt == expected, QString("Transformation in thread %1 failed").arg(i));
+    }
+}
+
+void test_QMapShack::benchTransform_data()
+{
+    QTest::addColumn<QString>("crs");
+    QTest::addColumn<bool>("bulk");
+
+    QTest::newRow("web mercator, point by point") << QString(webMercator) << false;
+    QTest::newRow("web mercator, bulk")           << QString(webMercator) << true;
+    QTest::newRow("utm, point by point")          << QString(utm33) << false;
+    QTest::newRow("utm, bulk")                    << QString(utm33) << true;
+}
+
+void test_QMapShack::benchTransform()
+{
+    QFETCH(QString, crs);
+    QFETCH(bool, bulk);
+
+    CProj proj(crs, "EPSG:4326");
+    QVERIFY(proj.isValid());
+
+    // the point by point reference calls proj_trans() for each vertex, like CProj did before
+    PJ_CONTEXT* ctx = proj_context_create();
+    PJ* pj = proj_create_crs_to_crs(ctx, proj.getProjSrc().toLatin1(), proj.getProjTar().toLatin1(), nullptr);
+    QVERIFY(pj != nullptr);
+    PJ* pjForGis = proj_normalize_for_visualization(ctx, pj);
+    proj_destroy(pj);
+    pj = pjForGis;
+    QVERIFY(pj != nullptr);
+
+    const QPolygonF& line = createLine(BENCH_VERTICES);
+
+    QBENCHMARK
+    {
+        QPolygonF tmp = line;
+        if(bulk)
+        {
+            proj.transform(tmp, PJ_INV);
+        }
+        else
+        {
+            const qreal factorPre = proj_degree_input(pj, PJ_INV) ? RAD_TO_DEG : 1.0;
+            const qreal factorPost = proj_degree_output(pj, PJ_INV) ? DEG_TO_RAD : 1.0;
+            for(QPointF& pt : tmp)
+            {
+                PJ_COORD c = proj_coord(pt.x() * factorPre, pt.y() * factorPre, 0, 0);
+                c = proj_trans(pj, PJ_INV, c);
+                pt = QPointF(c.uv.u, c.uv.v) * factorPost;
+            }
+        }
+    }
+
+    proj_destroy(pj);
+    proj_context_destroy(ctx);
+}
@@ -0,0 +1,48 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+#include "TestHelper.h"
+#include "test_QMapShack.h"
+
+#include "gis/tcx/CTcxProject.h"
+
+void test_QMapShack::_readTcxFile()
+{
+    verify("qtt_tcx_file0.tcx");
+}
+
+void test_QMapShack::_writeReadTcxFile()
+{
+    const QString file = "qtt_tcx_file0.tcx";
+    IGisProject *proj = readProjFile(file);
+
+    // activities and courses are saved as they have been loaded
+    QString tmpFile = TestHelper::getTempFileName("tcx");
+    SUBVERIFY(CTcxProject::saveAs(tmpFile, *proj), "Failed to save " + tmpFile);
+
+    delete proj;
+
+    proj = readProjFile(tmpFile, true, false);
+
+    // the name of a TCX project is the name of its file
+    expectedGisProject exp = TestHelper::readExpProj(fileToPath(file) + ".xml");
+    exp.name = QFileInfo(tmpFile).completeBaseName().replace("_", " ");
+    verify(exp, *proj);
+    delete proj;
+
+    QFile(tmpFile).remove();
+}
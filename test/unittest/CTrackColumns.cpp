@@ -0,0 +1,110 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include "TestHelper.h"
+#include "test_QMapShack.h"
+
+#include "gis/trk/CGisItemTrk.h"
+#include "gis/trk/CTrackColumns.h"
+
+void test_QMapShack::packTrackColumns(const CTrackData& trk)
+{
+    const CTrackColumns columns(trk);
+
+    qint32 N = 0;
+    for(const CTrackData::trkseg_t& seg : trk.segs)
+    {
+        N += seg.pts.size();
+    }
+    VERIFY_EQUAL(N, columns.size());
+
+    qint32 row = 0;
+    CTrackData::iterator<const CTrackData, const CTrackData::trkpt_t> it = trk.begin();
+    for(const CTrackData::trkpt_t& pt : columns)
+    {
+        const CTrackData::trkpt_t& exp = *it;
+        SUBVERIFY(exp.lon == pt.lon && exp.lat == pt.lat, QString("Position differs in row %1").arg(row));
+        VERIFY_EQUAL(exp.ele, pt.ele);
+        SUBVERIFY(exp.time == pt.time, QString("Time differs in row %1").arg(row));
+        VERIFY_EQUAL(exp.flags, pt.flags);
+        VERIFY_EQUAL(exp.name, pt.name);
+        VERIFY_EQUAL(exp.desc, pt.desc);
+        VERIFY_EQUAL(exp.extensions.size(), pt.extensions.size());
+
+        for(const QString& key : exp.extensions.keys())
+        {
+            SUBVERIFY(pt.extensions.contains(key), QString("Missing extension %1 in row %2").arg(key).arg(row));
+
+            bool ok = false;
+            const qreal value = exp.extensions[key].toDouble(&ok);
+            if(ok)
+            {
+                VERIFY_EQUAL(value, pt.extensions[key].toDouble());
+                VERIFY_EQUAL(value, columns.extension(CTrackColumns::extensionId(key), row));
+            }
+            else
+            {
+                VERIFY_EQUAL(exp.extensions[key].toString(), pt.extensions[key].toString());
+            }
+        }
+
+        ++it;
+        ++row;
+    }
+
+    // the distance must match the one derived by the track
+    const CTrackData::trkpt_t* last = trk.last();
+    if(nullptr != last && !last->isHidden())
+    {
+        SUBVERIFY(qAbs(columns.getDistance().last() - last->distance) < 0.01, "Distance differs");
+    }
+
+    // unpacking must restore the segments
+    CTrackData unpacked;
+    columns.toTrackData(unpacked);
+    qint32 nSegs = 0;
+    for(const CTrackData::trkseg_t& seg : trk.segs)
+    {
+        nSegs += seg.isEmpty() ? 0 : 1;
+    }
+    VERIFY_EQUAL(nSegs, unpacked.segs.size());
+}
+
+void test_QMapShack::_packTrackColumns()
+{
+    for(const QString &file : inputFiles)
+    {
+        IGisProject *proj = readProjFile(file);
+
+        for(int i = 0; i < proj->childCount(); i++)
+        {
+            CGisItemTrk *trk = dynamic_cast<CGisItemTrk*>(proj->child(i));
+            if(nullptr != trk)
+            {
+                packTrackColumns(trk->getTrackData());
+            }
+        }
+
+        delete proj;
+    }
+
+    // extension keys are interned once
+    const qint32 id = CTrackColumns::extensionId("gpxtpx:TrackPointExtension|gpxtpx:hr");
+    VERIFY_EQUAL(id, CTrackColumns::extensionId("gpxtpx:TrackPointExtension|gpxtpx:hr"));
+    VERIFY_EQUAL(QString("gpxtpx:TrackPointExtension|gpxtpx:hr"), CTrackColumns::extensionKey(id));
+}
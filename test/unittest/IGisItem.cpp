@@ -0,0 +1,282 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+#include "TestHelper.h"
+#include "test_QMapShack.h"
+
+#include "gis/gpx/CGpxProject.h"
+#include "gis/qms/CQmsProject.h"
+#include "gis/trk/CGisItemTrk.h"
+
+#include <QtCore>
+
+// the serialized item without history, like a keyframe of the history stores it
+static QByteArray itemData(const IGisItem &item)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setVersion(QDataStream::Qt_5_2);
+    item >> stream;
+    return data;
+}
+
+static CGisItemTrk* getFirstTrack(IGisProject *proj)
+{
+    for(int i = 0; i < proj->childCount(); i++)
+    {
+        CGisItemTrk *trk = dynamic_cast<CGisItemTrk*>(proj->child(i));
+        if(nullptr != trk)
+        {
+            return trk;
+        }
+    }
+    SUBVERIFY(false, "Project has no track");
+    return nullptr;
+}
+
+static QList<qint32> range(qint32 first, qint32 last)
+{
+    QList<qint32> idx;
+    const qint32 step = first <= last ? 1 : -1;
+    for(qint32 i = first; i != last + step; i += step)
+    {
+        idx << i;
+    }
+    return idx;
+}
+
+// change the elevation of a point n times and record the item's data of each new history event
+static void editTrack(CGisItemTrk &trk, QList<QByteArray> &states, qint32 n)
+{
+    const qint32 N = trk.getCntTotalPoints();
+    for(qint32 i = 0; i < n; i++)
+    {
+        trk.setElevation((states.size() * 7) % N, 1000 + states.size());
+        SUBVERIFY(trk.getHistory().histIdxCurrent == states.size(), "Edit did not add a history event");
+        states << itemData(trk);
+    }
+}
+
+// each delta needs a base and the number of deltas in a row is limited. Returns the number of deltas.
+static qint32 verifyKeyframes(const IGisItem &item, const QString &msg)
+{
+    const IGisItem::history_t &history = item.getHistory();
+
+    qint32 cntDelta = 0;
+    qint32 chain = 0;
+    for(int i = 0; i < history.events.size(); i++)
+    {
+        const IGisItem::history_event_t &event = history.events[i];
+        if(event.isDelta)
+        {
+            SUBVERIFY(i > 0 && !history.events[i - 1].data.isEmpty(), msg + QString(": delta %1 has no base").arg(i));
+            chain++;
+            cntDelta++;
+        }
+        else
+        {
+            chain = 0;
+        }
+        SUBVERIFY(chain < IGisItem::historyKeyframeInterval, msg + QString(": no keyframe before event %1").arg(i));
+    }
+    return cntDelta;
+}
+
+// load the events in the given order and compare them with the recorded data. Events without data are skipped.
+static void verifyHistory(IGisItem &item, const QList<QByteArray> &states, const QList<qint32> &order,
+                          const QString &msg)
+{
+    SUBVERIFY(item.getHistory().events.size() == states.size(), msg + ": wrong number of events");
+    for(qint32 idx : order)
+    {
+        if(states[idx].isEmpty())
+        {
+            continue;
+        }
+        item.loadHistory(idx);
+        SUBVERIFY(item.getHistory().histIdxCurrent == idx, msg + QString(": failed to load event %1").arg(idx));
+        SUBVERIFY(itemData(item) == states[idx], msg + QString(": event %1 differs").arg(idx));
+    }
+}
+
+void test_QMapShack::_historyDeltas()
+{
+    const qint32 interval = IGisItem::historyKeyframeInterval;
+
+    IGisProject *proj = readProjFile("qtt_gpx_file0.gpx");
+    CGisItemTrk *trk = getFirstTrack(proj);
+    SUBVERIFY(trk->getHistory().events.size() == 1, "Loaded track has more than the initial event");
+
+    QList<QByteArray> states;
+    states << itemData(*trk);
+    editTrack(*trk, states, 2 * interval + 5);
+
+    const qint32 last = states.size() - 1;
+    SUBVERIFY(verifyKeyframes(*trk, "edit") > last / 2, "Edits are not stored as delta");
+
+    // undo all changes, redo them and jump across keyframes
+    verifyHistory(*trk, states, range(last, 0), "undo");
+    verifyHistory(*trk, states, range(0, last), "redo");
+    verifyHistory(*trk, states, {last, 1, interval + 1, interval - 1, 2 * interval + 3, 0, interval}, "jump");
+
+    // a change after an undo drops the events after the current one
+    const qint32 idx = interval + 3;
+    trk->loadHistory(idx);
+    states = states.mid(0, idx + 1);
+    editTrack(*trk, states, 3);
+    verifyKeyframes(*trk, "edit after undo");
+    verifyHistory(*trk, states, range(states.size() - 1, 0), "undo after undo");
+
+    delete proj;
+}
+
+void test_QMapShack::_cutHistory()
+{
+    const qint32 interval = IGisItem::historyKeyframeInterval;
+
+    IGisProject *proj = readProjFile("qtt_gpx_file0.gpx");
+    CGisItemTrk *trk = getFirstTrack(proj);
+
+    QList<QByteArray> states;
+    states << itemData(*trk);
+    editTrack(*trk, states, 2 * interval + 5);
+
+    // cut all events before a delta, including the keyframe it is based on
+    const qint32 idx1 = interval + 3;
+    const IGisItem::history_t &history = trk->getHistory();
+    SUBVERIFY(history.events[idx1].isDelta && !history.events[idx1 - 3].isDelta, "Unexpected keyframe positions");
+    trk->loadHistory(idx1);
+    trk->cutHistoryBefore();
+    SUBVERIFY(!history.events[idx1].isDelta, "First event after cut is not a keyframe");
+    for(qint32 i = 0; i < idx1; i++)
+    {
+        SUBVERIFY(history.events[i].data.isEmpty(), QString("Event %1 has not been cut").arg(i));
+        states[i].clear();
+    }
+    verifyKeyframes(*trk, "cut before");
+    verifyHistory(*trk, states, range(states.size() - 1, 0), "cut before");
+
+    // cut all events after a delta and add new ones
+    const qint32 idx2 = idx1 + 5;
+    trk->loadHistory(idx2);
+    trk->cutHistoryAfter();
+    states = states.mid(0, idx2 + 1);
+    verifyHistory(*trk, states, range(idx2, 0), "cut after");
+    trk->loadHistory(idx2);
+    editTrack(*trk, states, 3);
+    verifyKeyframes(*trk, "edit after cut");
+    verifyHistory(*trk, states, range(0, states.size() - 1), "edit after cut");
+
+    // squash to the last event, a delta based on events removed by the squash
+    SUBVERIFY(history.events.last().isDelta, "Last event is not a delta");
+    trk->loadHistory(history.events.size() - 1);
+    trk->squashHistory();
+    SUBVERIFY(history.events.size() == 1 && !history.events[0].isDelta, "Squashed history is not a single keyframe");
+    verifyHistory(*trk, {states.last()}, {0}, "squash");
+
+    delete proj;
+}
+
+void test_QMapShack::_writeReadHistory()
+{
+    const qint32 interval = IGisItem::historyKeyframeInterval;
+
+    IGisProject *proj = readProjFile("qtt_gpx_file0.gpx");
+    CGisItemTrk *trk = getFirstTrack(proj);
+
+    QList<QByteArray> states;
+    states << itemData(*trk);
+    editTrack(*trk, states, 2 * interval + 5);
+    // the current event is stored, too
+    trk->loadHistory(interval + 3);
+
+    // a QMS file
+    QString tmpFile = TestHelper::getTempFileName("qms");
+    CQmsProject::saveAs(tmpFile, *proj);
+    IGisProject *projQms = readProjFile(tmpFile, true, false);
+    QFile(tmpFile).remove();
+
+    // a database stores the serialized history of each item
+    QByteArray blob;
+    QDataStream out(&blob, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setVersion(QDataStream::Qt_5_2);
+    out << trk->getHistory();
+
+    IGisItem::history_t hist;
+    QDataStream in(&blob, QIODevice::ReadOnly);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setVersion(QDataStream::Qt_5_2);
+    in >> hist;
+
+    IGisProject *projDb = new CGpxProject("a very random string to prevent loading via constructor",
+                                          (CGisListWks*) nullptr);
+    new CGisItemTrk(hist, "", projDb);
+
+    for(IGisProject *proj2 : {projQms, projDb})
+    {
+        CGisItemTrk *trk2 = getFirstTrack(proj2);
+        const IGisItem::history_t &exp = trk->getHistory();
+        const IGisItem::history_t &act = trk2->getHistory();
+
+        SUBVERIFY(act.events.size() == exp.events.size(), "Number of history events differs");
+        SUBVERIFY(act.histIdxCurrent == exp.histIdxCurrent, "Current history event differs");
+        for(int i = 0; i < exp.events.size(); i++)
+        {
+            SUBVERIFY(act.events[i].isDelta == exp.events[i].isDelta, QString("Delta flag of event %1 differs").arg(i));
+            SUBVERIFY(act.events[i].data == exp.events[i].data, QString("Data of event %1 differs").arg(i));
+            SUBVERIFY(act.events[i].hash == exp.events[i].hash, QString("Hash of event %1 differs").arg(i));
+        }
+        SUBVERIFY(itemData(*trk2) == states[interval + 3], "Loaded track differs");
+
+        verifyHistory(*trk2, states, range(states.size() - 1, 0), "loaded");
+        delete proj2;
+    }
+
+    delete proj;
+}
+
+void test_QMapShack::_readHistory_1_6_0()
+{
+    IGisProject *proj = readProjFile("V1.6.0_file1.qms");
+
+    // events of older versions are keyframes
+    QList<QByteArray> states;
+    CGisItemTrk *trk = getFirstTrack(proj);
+    const IGisItem::history_t &history = trk->getHistory();
+    for(int i = 0; i < history.events.size(); i++)
+    {
+        SUBVERIFY(!history.events[i].isDelta, QString("Event %1 of an old file is a delta").arg(i));
+        states << QByteArray();
+        if(!history.events[i].data.isEmpty())
+        {
+            trk->loadHistory(i);
+            SUBVERIFY(history.histIdxCurrent == i, QString("Failed to load event %1").arg(i));
+            states[i] = itemData(*trk);
+        }
+    }
+
+    // new events are stored as delta, except the first one if the format of the old event is outdated
+    trk->loadHistory(history.events.size() - 1);
+    editTrack(*trk, states, 3);
+    SUBVERIFY(history.events.last().isDelta, "Edit of an old item is not stored as delta");
+    verifyKeyframes(*trk, "edit old");
+    verifyHistory(*trk, states, range(states.size() - 1, 0), "edit old");
+
+    delete proj;
+}
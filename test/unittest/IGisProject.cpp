@@ -0,0 +1,92 @@
+/**********************************************************************************************
+    Copyright (C) 2024 Oliver Eichler <oliver.eichler@gmx.de>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+**********************************************************************************************/
+
+#include <QThreadPool>
+
+#include "TestHelper.h"
+#include "test_QMapShack.h"
+
+#include "gis/CGisListWks.h"
+#include "gis/prj/IGisProject.h"
+#include "gis/trk/CGisItemTrk.h"
+
+void test_QMapShack::_createDetached()
+{
+    const QStringList files =
+    {
+        "qtt_gpx_file0.gpx"
+        , "gpx_ext_GarminTPX1_tp1.gpx"
+        , "qtt_slf_file0.slf"
+        , "2015-05-07-22-03-17.fit"
+        , "Warisouderghem_course.fit"
+    };
+
+    // load all files at once, as the bulk import of the workspace does
+    QMutex mutex;
+    QMap<QString, IGisProject*> projects;
+    QThreadPool threadPool;
+    for(const QString &file : files)
+    {
+        const QString &filename = fileToPath(file);
+        threadPool.start([&mutex, &projects, filename]()
+        {
+            QString errormsg;
+            IGisProject *proj = IGisProject::createDetached(filename, errormsg);
+
+            QMutexLocker lock(&mutex);
+            projects[filename] = proj;
+        });
+    }
+    threadPool.waitForDone();
+
+    for(const QString &file : files)
+    {
+        IGisProject *proj = projects.value(fileToPath(file));
+        SUBVERIFY(nullptr != proj, "Failed to load " + file);
+
+        // a worker must give the same result as loading the file in the GUI thread
+        IGisProject *expProj = readProjFile(file);
+        VERIFY_EQUAL(expProj->getItemCountByType(IGisItem::eTypeWpt), proj->getItemCountByType(IGisItem::eTypeWpt));
+        VERIFY_EQUAL(expProj->getItemCountByType(IGisItem::eTypeTrk), proj->getItemCountByType(IGisItem::eTypeTrk));
+        VERIFY_EQUAL(expProj->getItemCountByType(IGisItem::eTypeRte), proj->getItemCountByType(IGisItem::eTypeRte));
+        VERIFY_EQUAL(expProj->getTotalDistance(), proj->getTotalDistance());
+        delete expProj;
+
+        // icons are created by finishLoading() on the GUI thread
+        SUBVERIFY(proj->icon(CGisListWks::eColumnIcon).isNull(), "Project icon created by worker");
+        for(int i = 0; i < proj->childCount(); i++)
+        {
+            IGisItem *item = dynamic_cast<IGisItem*>(proj->child(i));
+            SUBVERIFY(nullptr == item || item->getIcon().isNull(), "Item icon created by worker");
+
+            CGisItemTrk *trk = dynamic_cast<CGisItemTrk*>(proj->child(i));
+            if(nullptr != trk)
+            {
+                SUBVERIFY(trk->limitsGraph1.thread() == QThread::currentThread(), "Track limits not moved to GUI thread");
+            }
+        }
+
+        delete proj;
+    }
+
+    QString errormsg;
+    SUBVERIFY(!IGisProject::canCreateDetached(fileToPath("V1.6.0_file1.qms")), "QMS files are not loaded detached");
+    SUBVERIFY(!IGisProject::canCreateDetached("does_not_exist.gpx"), "A missing file can not be loaded detached");
+    SUBVERIFY(nullptr == IGisProject::createDetached(fileToPath("V1.6.0_file1.qms"), errormsg), "Unsupported file type loaded");
+    SUBVERIFY(!errormsg.isEmpty(), "No error message for unsupported file type");
+}
@@ -30,6 +30,7 @@
 #include "gis/rte/CGisItemRte.h"
 #include "gis/slf/CSlfProject.h"
 #include "gis/slf/CSlfReader.h"
+#include "gis/tcx/CTcxProject.h"
 #include "gis/trk/CGisItemTrk.h"
 #include "gis/trk/CKnownExtension.h"
 #include "gis/wpt/CGisItemWpt.h"
@@ -215,6 +216,15 @@ IGisProject* test_QMapShack::readProjFile(const QString &file, bool valid, bool
             CSlfReader::readFile(fileToPath(file), slfProj);
             SUBVERIFY(IGisProject::eTypeSlf == proj->getType(), "Project has invalid type");
         }
+        else if(file.endsWith(".tcx"))
+        {
+            CTcxProject *tcxProj = new CTcxProject("a very random string to prevent loading via constructor", (CGisListWks*) nullptr);
+            tcxProj->blockUpdateItems(true);
+            CTcxProject::loadTcx(fileToPath(file), tcxProj);
+            tcxProj->blockUpdateItems(false);
+            proj = tcxProj;
+            SUBVERIFY(IGisProject::eTypeTcx == proj->getType(), "Project has invalid type");
+        }
         else if(file.endsWith(".fit"))
         {
             proj = new CFitProject(fileToPath(file), (CGisListWks*) nullptr);
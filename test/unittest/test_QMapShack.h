@@ -25,6 +25,8 @@ class IGisProject;
 class CGpxProject;
 class CQmsProject;
 class CSlfProject;
+class CTrackData;
+class CGisItemTrk;
 
 extern QString testInput;
 
@@ -53,6 +55,11 @@ class test_QMapShack : public QObject
     // CGpxProject
     void writeReadGpxFile(const QString &file);
     void _writeReadGpxFile();
+    void _readLargeGpxFile();
+
+    // CTcxProject
+    void _readTcxFile();
+    void _writeReadTcxFile();
 
     // CKnownExtension
     void _readExtGarminTPX1_tp1();
@@ -66,9 +73,45 @@ class test_QMapShack : public QObject
 
     // CFitProject
     void _readValidFitFiles();
+    void _decodeFitRecords();
 
     // CGisItemTrk
     void _filterDeleteExtension();
+    void deriveSecondaryDataLocal(CGisItemTrk &trk, qint32 offset);
+    void _deriveSecondaryDataLocal();
+    void _moveTrackPoints();
+    void hideShowRange(CGisItemTrk &trk, qint32 idx1, qint32 idx2, bool hide);
+    void _hideShowPoints();
+
+    // CProj
+    void transformPolygon(const char* crs);
+    void _transformPolygon();
+    void _copyProj();
+
+    // CPackedRTree
+    void queryPackedRTree(qint32 n);
+    void _queryPackedRTree();
+
+    // CBinaryDelta
+    void applyBinaryDelta(const QByteArray& from, const QByteArray& to);
+    void _applyBinaryDelta();
+
+    // CMinMaxTree
+    void updateMinMaxTree(qint32 n);
+    void _updateMinMaxTree();
+
+    // IGisProject
+    void _createDetached();
+
+    // CTrackColumns
+    void packTrackColumns(const CTrackData& trk);
+    void _packTrackColumns();
+
+    // IGisItem
+    void _historyDeltas();
+    void _cutHistory();
+    void _writeReadHistory();
+    void _readHistory_1_6_0();
 
 private slots:
     void initTestCase();
@@ -76,10 +119,33 @@ private slots:
     void testreadValidSLFFile()         { TCWRAPPER( _readValidSLFFile()         ) }
     void testreadNonExistingSLFFile()   { TCWRAPPER( _readNonExistingSLFFile()   ) }
     void testwriteReadGpxFile()         { TCWRAPPER( _writeReadGpxFile()         ) }
+    void testreadLargeGpxFile()         { TCWRAPPER( _readLargeGpxFile()         ) }
+    void testreadTcxFile()              { TCWRAPPER( _readTcxFile()              ) }
+    void testwriteReadTcxFile()         { TCWRAPPER( _writeReadTcxFile()         ) }
     void testreadQmsFile_1_6_0()        { TCWRAPPER( _readQmsFile_1_6_0()        ) }
     void testwriteReadQmsFile()         { TCWRAPPER( _writeReadQmsFile()         ) }
     void testreadExtGarminTPX1_gpxtpx() { TCWRAPPER( _readExtGarminTPX1_gpxtpx() ) }
     void testreadExtGarminTPX1_tp1()    { TCWRAPPER( _readExtGarminTPX1_tp1()    ) }
     void testreadValidFitFiles()        { TCWRAPPER( _readValidFitFiles()        ) }
+    void testdecodeFitRecords()         { TCWRAPPER( _decodeFitRecords()         ) }
     void testfilterDeleteExtension()    { TCWRAPPER( _filterDeleteExtension()    ) }
+    void testderiveSecondaryDataLocal() { TCWRAPPER( _deriveSecondaryDataLocal() ) }
+    void testmoveTrackPoints()          { TCWRAPPER( _moveTrackPoints()          ) }
+    void testhideShowPoints()           { TCWRAPPER( _hideShowPoints()           ) }
+    void testtransformPolygon()         { TCWRAPPER( _transformPolygon()         ) }
+    void testcopyProj()                 { TCWRAPPER( _copyProj()                 ) }
+    void testqueryPackedRTree()         { TCWRAPPER( _queryPackedRTree()         ) }
+    void testapplyBinaryDelta()         { TCWRAPPER( _applyBinaryDelta()         ) }
+    void testupdateMinMaxTree()         { TCWRAPPER( _updateMinMaxTree()         ) }
+    void testcreateDetached()           { TCWRAPPER( _createDetached()           ) }
+    void testpackTrackColumns()         { TCWRAPPER( _packTrackColumns()         ) }
+    void testhistoryDeltas()            { TCWRAPPER( _historyDeltas()            ) }
+    void testcutHistory()               { TCWRAPPER( _cutHistory()               ) }
+    void testwriteReadHistory()         { TCWRAPPER( _writeReadHistory()         ) }
+    void testreadHistory_1_6_0()        { TCWRAPPER( _readHistory_1_6_0()        ) }
+
+    void benchTransform_data();
+    void benchTransform();
+    void benchDecodeFit();
+    void benchLoadGpx();
 };